@@ -0,0 +1,159 @@
+/**
+ * @file async_log.hpp
+ * @brief Log lines written by a background thread, so the thread that logs never makes a syscall.
+ *
+ * Writing to std::cout or std::cerr is a write() (plus a flush with
+ * std::endl), and a timestamp from localtime() may read the time zone file.
+ * On the simulation thread either stalls a tick. AsyncLog has the logging
+ * thread format a line into a pooled, fixed-size record and push it through
+ * an SpscRing; a drain thread wakes every drainInterval, stamps the local
+ * time, writes every queued line and flushes once. The producer never
+ * allocates, locks or wakes anyone: when the pool is exhausted the line is
+ * dropped and counted, and a line longer than a record is cut short.
+ *
+ * LogRateLimit bounds how many lines one kind of event may log per window,
+ * for messages a remote peer can trigger once per datagram.
+ *
+ * Usage:
+ *   - AsyncLog log; then on the producer thread: log.info() << "..." or log.warn() << "...";
+ *     the line is queued when the temporary goes out of scope
+ *   - One producer thread only (the simulation thread); the destructor writes what is left
+ *   - LogRateLimit limit; if (limit.allow(now)) log.warn() << "..." << Suppressed{ limit.takeSuppressed() };
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+/** @brief Where a line goes: Info to the normal stream, Warning to the error stream. */
+enum class LogLevel : uint8_t { Info, Warning };
+
+/**
+ * @struct AsyncLogConfig
+ * @brief Pool size and drain rate of an AsyncLog.
+ */
+struct AsyncLogConfig {
+    size_t capacity = 256;                               ///< Lines that can wait for the drain thread
+    std::chrono::milliseconds drainInterval{ 10 };       ///< How often the drain thread writes
+};
+
+/**
+ * @class AsyncLog
+ * @brief Single-producer log whose lines are written and flushed by its own thread.
+ */
+class AsyncLog {
+public:
+    using Config = AsyncLogConfig;
+
+    /** @brief One queued line: when it was logged and its text (no timestamp, no newline). */
+    struct Record {
+        static constexpr size_t TEXT_SIZE = 2040;
+        int64_t wallNs = 0;           ///< system_clock time since the epoch
+        LogLevel level = LogLevel::Info;
+        uint16_t length = 0;
+        char text[TEXT_SIZE];
+    };
+
+    class Line;
+
+    /**
+     * @param out Stream for Info lines
+     * @param err Stream for Warning lines
+     */
+    explicit AsyncLog(std::ostream& out = std::cout, std::ostream& err = std::cerr, const Config& config = Config());
+
+    /** @brief Writes every queued line, then stops the drain thread. */
+    ~AsyncLog();
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    Line info();
+    Line warn();
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }   ///< Lines lost to a full pool
+
+private:
+    void drainLoop();
+    size_t drain();
+
+    std::ostream& out_;
+    std::ostream& err_;
+    Config config_;
+    std::unique_ptr<Record[]> records_;
+    SpscRing<Record*> full_;   // Producer -> drain thread
+    SpscRing<Record*> free_;   // Drain thread -> producer
+    std::atomic<uint64_t> dropped_{ 0 };
+    std::mutex stopMutex_;               // Only the destructor and the drain thread take it
+    std::condition_variable stopCv_;
+    bool stopping_ = false;
+    std::thread drainer_;
+};
+
+/**
+ * @class AsyncLog::Line
+ * @brief Stream over one pooled record; queues it when destroyed.
+ */
+class AsyncLog::Line : public std::ostream {
+public:
+    Line(AsyncLog& log, LogLevel level);
+    ~Line();
+
+    Line(const Line&) = delete;
+    Line& operator=(const Line&) = delete;
+
+private:
+    /** @brief Writes into a fixed array; output past its end is discarded. */
+    class Buffer : public std::streambuf {
+    public:
+        void reset(char* begin, size_t size) { setp(begin, begin + size); }
+        size_t length() const { return static_cast<size_t>(pptr() - pbase()); }
+    };
+
+    AsyncLog& log_;
+    Record* record_;
+    Buffer buffer_;
+};
+
+/**
+ * @class LogRateLimit
+ * @brief Lets at most perWindow lines of one kind through per window and counts the rest.
+ */
+class LogRateLimit {
+public:
+    explicit LogRateLimit(uint32_t perWindow = 5, std::chrono::steady_clock::duration window = std::chrono::seconds(1));
+
+    /** @return True if a line may be logged now; otherwise it is counted as suppressed */
+    bool allow(std::chrono::steady_clock::time_point now);
+
+    /** @brief Lines suppressed since the last call; resets the count. */
+    uint64_t takeSuppressed();
+
+private:
+    uint32_t perWindow_;
+    std::chrono::steady_clock::duration window_;
+    std::chrono::steady_clock::time_point windowStart_{};
+    uint32_t inWindow_ = 0;
+    uint64_t suppressed_ = 0;
+};
+
+/** @brief Lines a LogRateLimit held back; prints as " (N more suppressed)", or nothing if N is 0. */
+struct Suppressed {
+    uint64_t count;
+};
+
+std::ostream& operator<<(std::ostream& out, Suppressed suppressed);
@@ -0,0 +1,139 @@
+/**
+ * @file checkpoint.hpp
+ * @brief Crash recovery: periodic world-state checkpoints in a double-buffered memory-mapped file.
+ *
+ * The tick thread serializes the world into a staging buffer and hands it to
+ * CheckpointWriter, which swaps buffers and returns at once. A background
+ * thread copies the buffer into the mapped file and flushes it. The file holds
+ * two slots and each checkpoint goes to the slot not holding the newest one:
+ * the payload is written and flushed first and the slot header after it, so a
+ * crash at any point leaves at least one complete checkpoint. Slots carry a
+ * generation number and a CRC32C; restore picks the newest slot that verifies.
+ *
+ * If the background thread is still writing when the next checkpoint arrives,
+ * the waiting one is replaced (only the newest state is worth writing).
+ * When a checkpoint does not fit, the file is rebuilt with larger slots under
+ * a temporary name and renamed over the old one.
+ *
+ * Usage:
+ *   - readCheckpoint(path, state, info) at startup; restore from state.
+ *   - CheckpointWriter writer(path); every K ticks: state.clear(),
+ *     serialize into state, writer.submit(state, ticks).
+ *   - flush() waits until everything submitted is on disk.
+ *
+ * POSIX only; on Windows the writer does not open and nothing is restored.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct CheckpointInfo
+ * @brief Metadata of a restored checkpoint.
+ */
+struct CheckpointInfo {
+    uint64_t generation = 0;   ///< Increases by one per checkpoint written to the file
+    uint64_t ticks = 0;        ///< Tick count passed to submit()
+    int64_t savedAt = 0;       ///< steady_clock reading when it was submitted
+    int64_t savedAtWall = 0;   ///< system_clock reading (nanoseconds since the epoch) when it was submitted
+};
+
+/**
+ * @brief Reads the newest valid checkpoint from a file.
+ * @param path       Checkpoint file
+ * @param[out] state Checkpoint payload
+ * @param[out] info  Its metadata
+ * @return False if the file is missing or holds no valid checkpoint
+ */
+bool readCheckpoint(const std::string& path, std::vector<char>& state, CheckpointInfo& info);
+
+/**
+ * @class CheckpointWriter
+ * @brief Writes submitted checkpoints to a memory-mapped file on a background thread.
+ */
+class CheckpointWriter {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;  ///< Initial bytes per slot
+
+    /**
+     * @brief Opens (or creates) the checkpoint file and starts the writer thread.
+     *
+     * An existing valid file is kept: its checkpoints stay readable until
+     * overwritten and generations continue from the newest one.
+     *
+     * @param path     Checkpoint file
+     * @param capacity Initial bytes per slot for a new file
+     */
+    explicit CheckpointWriter(std::string path, size_t capacity = DEFAULT_CAPACITY);
+
+    /** @brief Writes any pending checkpoint, then stops the thread and unmaps the file. */
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    /** @brief False if the file could not be opened or mapped (submit() then does nothing). */
+    bool isOpen() const { return open_; }
+
+    /**
+     * @brief Queues state for writing without blocking on I/O.
+     *
+     * The buffer is swapped with an internal one: afterwards state holds a
+     * previously used buffer with unspecified contents (clear it before reuse).
+     *
+     * @param state Serialized world state
+     * @param ticks Tick count stored with it
+     */
+    void submit(std::vector<char>& state, uint64_t ticks);
+
+    /** @brief Blocks until every submitted checkpoint has been written (or has failed). */
+    void flush();
+
+    uint64_t written() const;     ///< Checkpoints written and flushed
+    uint64_t superseded() const;  ///< Checkpoints replaced by a newer one before being written
+    uint64_t failures() const;    ///< Checkpoints that could not be written
+    size_t capacity() const;      ///< Current bytes per slot
+
+private:
+    bool mapExisting();
+    bool createFile(const std::string& path, size_t capacity, char*& base, size_t& length);
+    bool writeSlot(char* base, size_t capacity, int slot, const std::vector<char>& data,
+        uint64_t ticks, int64_t savedAt, int64_t savedAtWall);
+    bool grow(size_t needed, const std::vector<char>& data, uint64_t ticks, int64_t savedAt, int64_t savedAtWall);
+    void writerLoop();
+
+    std::string path_;
+    bool open_ = false;
+    char* base_ = nullptr;        // Mapping; replaced only by the writer thread when the file grows
+    size_t length_ = 0;
+    size_t capacity_ = 0;         // Changed only by the writer thread (under mutex_)
+    uint64_t generation_ = 0;     // Newest generation in the file
+    int latestSlot_ = -1;         // Slot holding it (-1: none)
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::vector<char> pending_;   // Submitted, not yet picked up
+    std::vector<char> writing_;   // Being written by the thread
+    uint64_t pendingTicks_ = 0;
+    int64_t pendingSavedAt_ = 0;
+    int64_t pendingSavedAtWall_ = 0;
+    bool hasPending_ = false;
+    bool busy_ = false;
+    bool stopping_ = false;
+    uint64_t written_ = 0;
+    uint64_t superseded_ = 0;
+    uint64_t failures_ = 0;
+    std::thread thread_;
+};
@@ -0,0 +1,104 @@
+/**
+ * @file collision.hpp
+ * @brief Player collisions over SoA position arrays: uniform grid broadphase, circle narrowphase.
+ *
+ * Every entity is a circle of the same radius inside a square world. The
+ * broadphase bins entities into a uniform grid whose cells are at least one
+ * diameter wide, so a circle can only touch circles in its own cell and the
+ * eight around it. There are at most about as many cells as entities, so a
+ * small match in a large world does not pay for scanning empty cells. Binning is a counting sort that also copies x and y into
+ * cell order, so the narrowphase streams through contiguous memory; each
+ * cell is tested against itself and four forward neighbours (east, south-west,
+ * south, south-east), which visits every candidate pair exactly once.
+ *
+ * The narrowphase tests squared centre distance against the squared
+ * diameter. Resolution moves both circles of an overlapping pair apart by
+ * half the overlap along the line between their centres (circles on the same
+ * point are split along x, lower slot to the left), then clamps them to the
+ * world. Pairs are resolved in place in cell order, and the whole pass is
+ * repeated up to params.iterations times while contacts remain, so crowds
+ * settle over a few ticks instead of in one. Results depend only on the
+ * input positions, so a replayed or restored room resolves identically.
+ *
+ * The grid's buffers are kept between calls; after the first tick a rebuild
+ * allocates nothing.
+ *
+ * Usage:
+ *   - CollisionParams params{ radius, boundsMin, boundsMax };
+ *   - CollisionGrid grid; grid.resolve(x, y, count, params) after movement, every tick
+ *   - grid.findContacts(x, y, count, params, contacts) to list overlaps without moving anything
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct CollisionParams
+ * @brief Circle size, world bounds and solver effort.
+ */
+struct CollisionParams {
+    float radius;               ///< Radius of every entity
+    float boundsMin;            ///< Smallest allowed x and y
+    float boundsMax;            ///< Largest allowed x and y
+    uint32_t iterations = 2;    ///< Most resolution passes per call
+};
+
+/**
+ * @struct Contact
+ * @brief Two overlapping entities (slots, a < b) and how deep they overlap.
+ */
+struct Contact {
+    uint32_t a;
+    uint32_t b;
+    float depth;
+};
+
+/**
+ * @class CollisionGrid
+ * @brief Reusable uniform grid for finding and resolving overlaps between equal circles.
+ */
+class CollisionGrid {
+public:
+    /** @brief Most cells per axis; larger worlds get wider cells. */
+    static constexpr uint32_t MAX_CELLS_PER_AXIS = 256;
+
+    /**
+     * @brief Pushes overlapping circles apart and keeps them in bounds.
+     * @param x, y  Positions of count entities, updated in place
+     * @return Contacts found in the first pass
+     */
+    size_t resolve(float* x, float* y, size_t count, const CollisionParams& params);
+
+    /**
+     * @brief Lists every overlapping pair without moving anything.
+     * @param[out] contacts Replaced with the pairs, in cell order
+     */
+    void findContacts(const float* x, const float* y, size_t count, const CollisionParams& params,
+        std::vector<Contact>& contacts);
+
+    /** @brief Candidate pairs the narrowphase tested in the last call. */
+    uint64_t pairsTested() const { return pairsTested_; }
+
+    /** @brief Resolution passes run in the last resolve(). */
+    uint32_t passes() const { return passes_; }
+
+private:
+    void build(const float* x, const float* y, size_t count, const CollisionParams& params);
+    template<typename Visit>
+    void forEachCandidate(Visit&& visit);
+
+    uint32_t cols_ = 0;
+    std::vector<uint32_t> cellStart_;   // First sorted index per cell (cols_ * cols_ + 1)
+    std::vector<uint32_t> cellOf_;      // Cell of each slot
+    std::vector<uint32_t> order_;       // Slot at each sorted index
+    std::vector<float> sx_;             // x in cell order
+    std::vector<float> sy_;             // y in cell order
+    uint64_t pairsTested_ = 0;
+    uint32_t passes_ = 0;
+};
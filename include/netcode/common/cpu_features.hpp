@@ -0,0 +1,63 @@
+/**
+ * @file cpu_features.hpp
+ * @brief Runtime CPU feature detection for the SIMD code paths.
+ *
+ * The common library is built for the baseline instruction set of the target
+ * platform, so AVX2 and SSE4.2 kernels are compiled with per-function target
+ * attributes and selected at runtime. This header provides the detection and
+ * the attribute macros used by those kernels.
+ *
+ * Usage:
+ *   - Call bestSimdLevel() once and dispatch to the matching kernel.
+ *   - Mark AVX2/SSE4.2 kernels with NETCODE_TARGET_AVX2 / NETCODE_TARGET_SSE42.
+ *   - Guard intrinsic code with NETCODE_X86 so other architectures use the scalar path.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NETCODE_X86 1
+#endif
+
+#if defined(NETCODE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define NETCODE_TARGET_SSE2  __attribute__((target("sse2")))
+#define NETCODE_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define NETCODE_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define NETCODE_TARGET_SSE2
+#define NETCODE_TARGET_SSE42
+#define NETCODE_TARGET_AVX2
+#endif
+
+/**
+ * @enum SimdLevel
+ * @brief Instruction set tiers used by the vectorized kernels.
+ */
+enum class SimdLevel {
+    Scalar,  ///< Portable C++ fallback
+    SSE,     ///< 4-wide SSE2 (baseline on x86-64)
+    AVX2     ///< 8-wide AVX2
+};
+
+/**
+ * @brief Returns true if the CPU and OS support SSE4.2 (used for hardware CRC32C).
+ */
+bool cpuHasSse42();
+
+/**
+ * @brief Returns true if the CPU and OS support AVX2 (including YMM state saving).
+ */
+bool cpuHasAvx2();
+
+/**
+ * @brief Highest SIMD tier available on this machine (detected once, then cached).
+ */
+SimdLevel bestSimdLevel();
+
+/**
+ * @brief Human-readable name of a SIMD tier, for logs and benchmark output.
+ */
+const char* simdLevelName(SimdLevel level);
@@ -0,0 +1,42 @@
+/**
+ * @file crc32c.hpp
+ * @brief CRC32C (Castagnoli) checksums for datagram integrity.
+ *
+ * Uses the SSE4.2 crc32 instruction when the CPU supports it and a
+ * table-driven (slicing-by-8) implementation otherwise. Both produce the
+ * standard CRC-32C value (reflected, init and final XOR 0xFFFFFFFF).
+ *
+ * Usage:
+ *   - crc32c(data, len) for a one-shot checksum.
+ *   - crc32c(more, len2, crc32c(data, len)) to extend a checksum over
+ *     concatenated buffers (equal to the checksum of data followed by more).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Computes (or extends) a CRC32C checksum, using hardware acceleration when available.
+ * @param data   Bytes to checksum
+ * @param length Number of bytes
+ * @param crc    Checksum of the preceding bytes (0 to start a new checksum)
+ * @return CRC32C of the preceding bytes followed by data
+ */
+uint32_t crc32c(const void* data, size_t length, uint32_t crc = 0);
+
+/**
+ * @brief Table-driven CRC32C (portable fallback). Same contract as crc32c().
+ */
+uint32_t crc32cSoftware(const void* data, size_t length, uint32_t crc = 0);
+
+/**
+ * @brief SSE4.2 CRC32C. Same contract as crc32c(); only call if cpuHasSse42() is true.
+ *
+ * On non-x86 targets this forwards to crc32cSoftware().
+ */
+uint32_t crc32cHardware(const void* data, size_t length, uint32_t crc = 0);
@@ -0,0 +1,110 @@
+/**
+ * @file entity_store.hpp
+ * @brief Dense entity storage: a sparse set with generation-checked ids and SoA component columns.
+ *
+ * Entities are addressed by an EntityId (index + generation). The sparse
+ * array maps an index to the entity's slot in the dense columns, so lookups
+ * are O(1) without hashing, and a stale id (its entity destroyed, the index
+ * reused) is detected by the generation mismatch. Components live in
+ * separate contiguous arrays (x, y, vx, vy, seq), so per-tick loops stream
+ * through memory and vectorize.
+ *
+ * Usage:
+ *   - create() returns a new id; its components start at zero.
+ *   - Iterate slots 0..size()-1 over the column pointers for bulk work.
+ *   - destroy() keeps the columns dense by moving the last entity into the
+ *     freed slot. Owners of additional per-slot columns mirror the move with
+ *     the returned slot (column[slot] = column.back(); column.pop_back()).
+ *   - Slots change on destroy; ids never do. Keep ids, not slots, across ticks.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct EntityId
+ * @brief Stable handle to an entity: sparse index plus the generation it was created in.
+ */
+struct EntityId {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const EntityId& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+/**
+ * @class EntityStore
+ * @brief Sparse set of entities with position, velocity and sequence columns.
+ */
+class EntityStore {
+public:
+    /** @brief Returned by slot() and destroy() for ids that are not alive. */
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    /**
+     * @brief Reserves column capacity so creating up to n entities does not reallocate.
+     */
+    void reserve(size_t n);
+
+    /**
+     * @brief Creates an entity at the end of the dense columns (all components zero).
+     */
+    EntityId create();
+
+    /**
+     * @brief Destroys an entity; the last entity moves into its slot.
+     * @return The freed slot (now holding the former last entity, unless it was last), or NPOS if the id is not alive
+     */
+    size_t destroy(EntityId id);
+
+    /**
+     * @brief Removes every entity; outstanding ids become stale.
+     */
+    void clear();
+
+    bool alive(EntityId id) const;
+
+    /**
+     * @brief Dense slot of an entity, or NPOS if the id is not alive.
+     */
+    size_t slot(EntityId id) const;
+
+    /**
+     * @brief Id of the entity in a dense slot (slot < size()).
+     */
+    EntityId id(size_t slot) const { return dense_[slot]; }
+
+    size_t size() const { return dense_.size(); }
+    bool empty() const { return dense_.empty(); }
+
+    float* x() { return x_.data(); }
+    float* y() { return y_.data(); }
+    float* vx() { return vx_.data(); }
+    float* vy() { return vy_.data(); }
+    uint32_t* seq() { return seq_.data(); }
+
+    const float* x() const { return x_.data(); }
+    const float* y() const { return y_.data(); }
+    const float* vx() const { return vx_.data(); }
+    const float* vy() const { return vy_.data(); }
+    const uint32_t* seq() const { return seq_.data(); }
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    std::vector<uint32_t> sparse_;        // Index -> dense slot (NO_SLOT when free)
+    std::vector<uint32_t> generations_;   // Index -> current generation
+    std::vector<uint32_t> freeIndices_;
+
+    std::vector<EntityId> dense_;         // Slot -> id
+    std::vector<float> x_, y_;
+    std::vector<float> vx_, vy_;
+    std::vector<uint32_t> seq_;
+};
@@ -0,0 +1,113 @@
+/**
+ * @file frame_pacer.hpp
+ * @brief Client frame pacing with late-latched input: wait first, then sample, render and present.
+ *
+ * A frame loop that samples input at the top, renders, presents and then
+ * sleeps for the rest of the frame (what a framerate limit does) shows input
+ * that is up to a whole frame old, plus the sleep's jitter. FramePacer turns
+ * the loop around: frames have absolute present deadlines on a fixed grid,
+ * and the loop waits until just before the next one - the predicted cost of a
+ * frame plus a safety margin - before it samples input, sends it, simulates,
+ * renders and presents. The input shown is then only about one frame's work
+ * old.
+ *
+ * The cost prediction is a high quantile of the last costWindow frames, so it
+ * follows slow changes in render cost and tolerates the occasional slow frame.
+ * Waiting sleeps until spinWindow before the latch time
+ * (TickScheduler::sleepUntil) and spins the rest. A frame presented after
+ * its deadline is a miss; deadlines that have passed are skipped, keeping
+ * the grid's phase.
+ *
+ * Usage:
+ *   - FramePacer pacer; no window framerate limit (the pacer replaces it)
+ *   - Each frame: pacer.waitForLatch(); pacer.beginFrame(now); sample input, send, simulate,
+ *     render, display(); pacer.endFrame(Clock::now())
+ *   - frameCost(), latchLateness(), missedDeadlines() and report() for statistics; the cost
+ *     and lateness statistics keep the last statsWindow frames (max() covers every frame)
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "netcode/common/latency_profile.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct FramePacerConfig
+ * @brief Frame rate, safety margin and cost prediction of a FramePacer.
+ */
+struct FramePacerConfig {
+    std::chrono::nanoseconds period{ 1000000000 / 60 };                ///< Time between present deadlines
+    std::chrono::nanoseconds margin = std::chrono::microseconds(1500);  ///< Slack between the predicted end of a frame and its deadline
+    std::chrono::nanoseconds spinWindow = std::chrono::microseconds(500);  ///< Spin this long before the latch (0: sleep only)
+    size_t costWindow = 60;                                            ///< Recent frames the cost prediction looks at
+    double costQuantile = 0.9;                                         ///< Predicted cost: this quantile of their costs
+    size_t statsWindow = 600;                                          ///< Recent frames frameCost() and latchLateness() keep
+};
+
+/**
+ * @class FramePacer
+ * @brief Paces frames to present deadlines and latches input as late as the predicted frame cost allows.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Config = FramePacerConfig;
+
+    /** @param first First present deadline (default: one period from now) */
+    explicit FramePacer(const Config& config = Config(), Clock::time_point first = Clock::time_point::min());
+
+    const Config& config() const { return config_; }
+
+    /** @brief Present deadline of the next (or running) frame. */
+    Clock::time_point deadline() const { return deadline_; }
+
+    /**
+     * @brief Predicted cost of a frame, from latch to present.
+     *
+     * The configured quantile of the recent costs; half a period before any frame was
+     * measured. Never more than a period minus the margin.
+     */
+    Clock::duration predictedCost() const;
+
+    /** @brief When the next frame should sample input: deadline - predicted cost - margin. */
+    Clock::time_point latchTime() const { return deadline_ - predictedCost() - config_.margin; }
+
+    /** @brief Sleeps, then spins, until latchTime(). */
+    void waitForLatch() const;
+
+    /** @brief The frame starts: input is sampled now. Records how late the latch was. */
+    void beginFrame(Clock::time_point now);
+
+    /** @brief The frame was presented: records its cost and schedules the next deadline. */
+    void endFrame(Clock::time_point now);
+
+    const JitterStats& frameCost() const { return cost_; }               ///< Latch to present, per frame
+    const JitterStats& latchLateness() const { return latchLateness_; }  ///< Wake-up error at the latch
+    uint64_t frames() const { return frames_; }
+    uint64_t missedDeadlines() const { return missed_; }                ///< Frames presented after their deadline
+    uint64_t skippedDeadlines() const { return skipped_; }              ///< Deadlines dropped because they had passed
+
+    /** @brief One-line summary: frames, recent cost p50/p99, predicted cost, misses. */
+    std::string report() const;
+
+private:
+    Config config_;
+    Clock::time_point deadline_;
+    Clock::time_point began_;
+    std::vector<Clock::duration> recent_;   // Ring of the last costWindow frame costs
+    size_t recentNext_ = 0;
+    mutable std::vector<Clock::duration> sorted_;
+    Clock::duration predicted_;
+    uint64_t frames_ = 0;
+    uint64_t missed_ = 0;
+    uint64_t skipped_ = 0;
+    JitterStats cost_;
+    JitterStats latchLateness_;
+};
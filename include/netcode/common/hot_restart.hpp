@@ -0,0 +1,156 @@
+/**
+ * @file hot_restart.hpp
+ * @brief Handing a running server's sockets and state to a new server process.
+ *
+ * A hot restart replaces the server binary without dropping sessions. The
+ * old process listens on a Unix domain control socket. The new process
+ * connects and receives, in one SCM_RIGHTS message, the bound UDP socket
+ * and a shared memory segment holding the serialized world state. Datagrams
+ * that arrive during the handoff wait in the UDP socket's receive buffer,
+ * which both processes share, so none are lost.
+ *
+ * The shared memory segment is anonymous (memfd on Linux, an immediately
+ * unlinked shm object elsewhere). The state carries a magic number, a
+ * version and a CRC32C, so a new binary with a different layout refuses it
+ * instead of misreading it.
+ *
+ * The control socket lives in a directory only the server's user can enter
+ * (controlSocketPath(): $XDG_RUNTIME_DIR, or a private directory in /tmp),
+ * is itself mode 0600, and both ends check that the peer runs as the same
+ * user before anything is passed.
+ *
+ * Usage (old process):
+ *   - createControlListener(controlSocketPath()) at startup, then either pollControlListener()
+ *     between ticks, or a TakeoverWatcher that waits for requests on its own thread so the
+ *     tick loop only reads an atomic (TakeoverWatcher::poll()).
+ *   - When a peer arrives: handOff(peer, fds, state, header), then wait
+ *     for the peer's ack with awaitAck() and exit on success.
+ * Usage (new process):
+ *   - takeOver(path, fds, state, header) receives everything; restore from
+ *     the state, then sendAck() and start ticking.
+ *
+ * POSIX only; on Windows the functions fail and the server starts fresh.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct HandoffHeader
+ * @brief Fixed-size message that accompanies the passed file descriptors.
+ */
+struct HandoffHeader {
+    static constexpr uint32_t MAGIC = 0x4E434852;  ///< "NCHR"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t fdCount = 0;      ///< Descriptors passed before the state segment
+    uint32_t stateCrc = 0;     ///< CRC32C of the state bytes
+    uint64_t stateSize = 0;    ///< Bytes of state in the shared memory segment
+    uint64_t ticks = 0;        ///< Ticks simulated so far
+    int64_t nextTick = 0;      ///< steady_clock reading of the next tick (same machine, same clock)
+};
+
+/** @brief Most descriptors (besides the state segment) one handoff can pass. */
+constexpr size_t MAX_HANDOFF_FDS = 8;
+
+/**
+ * @brief Default control socket path: in $XDG_RUNTIME_DIR, or else in /tmp/netcode-server-UID
+ *        (created with mode 0700).
+ * @return The path, or an empty string if its directory is not owned by this user or is open
+ *         to others
+ */
+std::string controlSocketPath();
+
+/**
+ * @brief Creates a non-blocking Unix domain socket listening at path (replacing a stale one), mode 0600.
+ * @return Listening descriptor, or -1 on failure
+ */
+int createControlListener(const std::string& path);
+
+/**
+ * @brief Accepts a pending takeover request without blocking.
+ * @return Connected peer, or -1 if none is waiting or it runs as another user
+ */
+int pollControlListener(int listener);
+
+/**
+ * @class TakeoverWatcher
+ * @brief Accepts takeover requests on a background thread and hands them to the tick loop.
+ *
+ * The thread waits on the listener (select with a short timeout) and keeps at most one
+ * connected peer until poll() takes it, so checking for a takeover costs the caller one
+ * atomic exchange and no syscall.
+ */
+class TakeoverWatcher {
+public:
+    /** @param listener From createControlListener() (not owned); nothing is watched if negative */
+    explicit TakeoverWatcher(int listener);
+
+    /** @brief Calls stop(). */
+    ~TakeoverWatcher();
+
+    TakeoverWatcher(const TakeoverWatcher&) = delete;
+    TakeoverWatcher& operator=(const TakeoverWatcher&) = delete;
+
+    /** @brief Connected peer asking for a takeover, or -1; each peer is returned once. */
+    int poll();
+
+    /** @brief Ends the thread (closing a peer nobody took); the listener stays open. */
+    void stop();
+
+private:
+    void watchLoop();
+
+    int listener_;
+    std::atomic<int> pending_{ -1 };
+    std::atomic<bool> running_{ false };
+    std::thread thread_;
+};
+
+/**
+ * @brief Sends descriptors and state to the new process.
+ *
+ * Copies the state into a new shared memory segment and passes it along with fds.
+ * The caller's descriptors stay open; the old process must not read from them
+ * afterwards unless awaitAck() fails.
+ *
+ * @param peer   Connected control socket
+ * @param fds    Descriptors to pass (at most MAX_HANDOFF_FDS)
+ * @param state  Serialized world state
+ * @param header ticks and nextTick are sent; the other fields are filled in
+ * @return False if the segment could not be created or the message not sent
+ */
+bool handOff(int peer, const std::vector<int>& fds, const std::vector<char>& state, HandoffHeader header);
+
+/**
+ * @brief Waits for the new process to confirm it has taken over.
+ * @return True if the ack arrived before the timeout
+ */
+bool awaitAck(int peer, std::chrono::milliseconds timeout);
+
+/**
+ * @brief Connects to a running server (which must run as the same user) and receives its descriptors and state.
+ * @param path        Control socket path of the running server
+ * @param[out] fds    Received descriptors, in the order they were passed
+ * @param[out] state  State bytes (verified against the header's CRC)
+ * @param[out] header Received header
+ * @return Connected control socket (for sendAck()), or -1 on failure
+ */
+int takeOver(const std::string& path, std::vector<int>& fds, std::vector<char>& state, HandoffHeader& header);
+
+/**
+ * @brief Tells the old process that the takeover succeeded and closes the control socket.
+ */
+bool sendAck(int peer);
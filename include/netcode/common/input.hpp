@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 
  /**
@@ -33,26 +34,34 @@
   * - Sequence-based ordering and acknowledgment
   * - Normalized velocity inputs for consistent behavior
   * - Frame timing for accurate replay simulation
+  *
+  * A client that sends its input only when it changes (input_encoder.hpp)
+  * predicts many frames per input packet: sequence then numbers the frames,
+  * and packetSeq names the packet the server acknowledges them by.
   */
 struct InputCommand {
-    uint32_t sequence;  /**< Sequence number for ordering and server acknowledgment */
+    uint32_t sequence;  /**< Frame id: increases by one per predicted frame */
+    uint32_t packetSeq; /**< Seq of the input packet carrying these keys: the last one sent at or before this frame (0: none yet) */
     float vx;          /**< X-axis velocity input (-1 to 1, normalized from user input) */
     float vy;          /**< Y-axis velocity input (-1 to 1, normalized from user input) */
     float dt;          /**< Delta time for this input frame (seconds) */
+    std::chrono::steady_clock::time_point sampledAt;  /**< When the keys were read (latency instrumentation) */
 
     /**
      * @brief Default constructor initializes all values to zero.
      */
-    InputCommand() : sequence(0), vx(0.0f), vy(0.0f), dt(0.0f) {}
+    InputCommand() : sequence(0), packetSeq(0), vx(0.0f), vy(0.0f), dt(0.0f) {}
 
     /**
      * @brief Construct an input command with specific values.
      *
-     * @param seq Input sequence number for ordering
+     * @param seq Input sequence number for ordering; also its packetSeq (one packet per frame)
      * @param velocityX X-axis velocity (-1 to 1, normalized)
      * @param velocityY Y-axis velocity (-1 to 1, normalized)
      * @param deltaTime Time delta for this frame (seconds)
+     * @param sampled   When the keys were read
      */
-    InputCommand(uint32_t seq, float velocityX, float velocityY, float deltaTime)
-        : sequence(seq), vx(velocityX), vy(velocityY), dt(deltaTime) {}
+    InputCommand(uint32_t seq, float velocityX, float velocityY, float deltaTime,
+        std::chrono::steady_clock::time_point sampled = {})
+        : sequence(seq), packetSeq(seq), vx(velocityX), vy(velocityY), dt(deltaTime), sampledAt(sampled) {}
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * @file input_encoder.hpp
+ * @brief Change-driven input transmission: send when the input changes, repeat it, and keep a heartbeat.
+ *
+ * Most frames repeat the previous frame's arrow-key state, so sending it at a
+ * fixed rate mostly sends what the server already knows. The server holds a
+ * client's last input between packets (Room::holdInputs()), so the client
+ * only has to send:
+ * - a change, on the frame it happens,
+ * - the same input again on the next `redundancy` repeat intervals, so one
+ *   lost datagram does not leave the server holding a stale input until the
+ *   heartbeat (every packet carries the whole input state, so any copy will do),
+ * - a heartbeat when nothing was sent for `heartbeat`, which keeps the client
+ *   from being evicted as idle and bounds how long a lost change can last.
+ *
+ * The encoder only decides when to send; the caller builds and numbers the
+ * packet as before.
+ *
+ * Usage:
+ *   - InputEncoder encoder; then per frame:
+ *     if (encoder.sample(inputX, inputY, now) != InputSend::None) { send Packet{ seq++, inputX, inputY, 0, 0 } }
+ *   - changes() / repeats() / heartbeats() / frames() for statistics
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/** @brief Why a frame's input is sent, or None if it is not. */
+enum class InputSend : uint8_t { None, Change, Repeat, Heartbeat };
+
+/**
+ * @struct InputEncoderConfig
+ * @brief Heartbeat and redundancy of an InputEncoder.
+ */
+struct InputEncoderConfig {
+    std::chrono::milliseconds heartbeat{ 250 };          ///< Longest time between packets while the input is unchanged
+    std::chrono::milliseconds repeatInterval{ 33 };      ///< Spacing of the redundant copies of a change
+    uint32_t redundancy = 2;                             ///< Copies sent after each change (0: none)
+};
+
+/**
+ * @class InputEncoder
+ * @brief Decides per frame whether the input is sent.
+ */
+class InputEncoder {
+public:
+    using Config = InputEncoderConfig;
+
+    explicit InputEncoder(const Config& config = Config());
+
+    /**
+     * @brief Takes one frame's input.
+     * @return Why it must be sent now, or InputSend::None
+     */
+    InputSend sample(float inputX, float inputY, std::chrono::steady_clock::time_point now);
+
+    const Config& config() const { return config_; }
+
+    uint64_t frames() const { return frames_; }            ///< Inputs sampled
+    uint64_t changes() const { return changes_; }          ///< Sent because the input changed
+    uint64_t repeats() const { return repeats_; }          ///< Sent as a redundant copy of a change
+    uint64_t heartbeats() const { return heartbeats_; }    ///< Sent because nothing was sent for a heartbeat
+    uint64_t sent() const { return changes_ + repeats_ + heartbeats_; }
+
+private:
+    Config config_;
+    bool started_ = false;
+    float lastX_ = 0.0f;
+    float lastY_ = 0.0f;
+    std::chrono::steady_clock::time_point lastSend_;
+    uint32_t repeatsLeft_ = 0;
+    uint64_t frames_ = 0;
+    uint64_t changes_ = 0;
+    uint64_t repeats_ = 0;
+    uint64_t heartbeats_ = 0;
+};
@@ -0,0 +1,169 @@
+/**
+ * @file input_latency.hpp
+ * @brief Input-to-photon latency: follows each sent input from key sampling to the screen.
+ *
+ * Two latencies are measured:
+ * - local-to-display: from reading the keys to presenting the frame that
+ *   shows their locally predicted effect, for every frame;
+ * - server-confirmed: from reading the keys to presenting the first frame
+ *   reconciled with a snapshot that acknowledges them, for every sent input.
+ *
+ * A sent input is tracked by its sequence number through the stages
+ * sampled -> sent (leaves the socket, after any simulated delay) -> acked
+ * (a snapshot echoing it, or a newer one, is received) -> reconciled ->
+ * displayed, and each stage's duration goes into its own distribution. A
+ * snapshot acknowledges every input up to the sequence it echoes, so an input
+ * whose packet was lost is confirmed by the next one; snapshots repeating an
+ * already acknowledged sequence (held input) add nothing.
+ *
+ * The HUD reads these live, so nothing grows with the length of the run:
+ * each distribution keeps exact percentiles over its recent window and
+ * bucket counts over the whole run, and the per-input records kept for the
+ * CSV export stop at maxRecords.
+ *
+ * Threads: queued(), reconciled(), sampled() and displayed() are called by the main thread,
+ * sent() and acked() by the network thread. Stage times are exchanged through atomics in a
+ * ring of capacity slots by sequence number; everything else is main-thread only.
+ *
+ * Usage:
+ *   - Main thread, every frame: sampled(t) when the keys are read; queued(seq, t) if the input
+ *     goes out as packet seq; reconciled(seq, now) after reconciling with a snapshot;
+ *     displayed(now) right after presenting the frame
+ *   - Network thread: sent(seq, now) after sendto(); acked(seq, now) for each received snapshot
+ *   - localToDisplay() / serverConfirmed() and the per-stage distributions (.recent for
+ *     percentiles, .total for histograms); exportCsv() and exportHistograms() for analysis
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "latency_profile.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct InputLatencyConfig
+ * @brief Sizes and histogram buckets of an InputLatencyTracker.
+ */
+struct InputLatencyConfig {
+    size_t capacity = 1024;        ///< Inputs that can be in flight at once (older ones are forgotten)
+    size_t window = 600;           ///< Recent samples each distribution's percentiles cover
+    size_t maxRecords = 100000;    ///< Confirmed inputs kept for exportCsv(); later ones are only counted
+    std::vector<std::chrono::milliseconds> buckets = {   ///< Histogram upper bounds, ascending
+        std::chrono::milliseconds(8), std::chrono::milliseconds(16), std::chrono::milliseconds(33),
+        std::chrono::milliseconds(50), std::chrono::milliseconds(100), std::chrono::milliseconds(200),
+        std::chrono::milliseconds(400)
+    };
+};
+
+/**
+ * @class InputLatencyTracker
+ * @brief Stage timestamps of sent inputs and the resulting latency distributions.
+ */
+class InputLatencyTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Config = InputLatencyConfig;
+
+    /** @brief Stage times of one confirmed input; sent and acked are unset (epoch) if unknown, e.g. for a lost packet. */
+    struct Record {
+        uint32_t seq;
+        Clock::time_point sampled, sent, acked, reconciled, displayed;
+    };
+
+    /** @brief One latency: exact percentiles of the recent samples, bucket counts of all of them. */
+    struct Distribution {
+        JitterStats recent;
+        LatencyHistogram total;
+
+        Distribution(size_t window, const std::vector<std::chrono::milliseconds>& buckets);
+        void record(Clock::duration value);
+    };
+
+    explicit InputLatencyTracker(const Config& config = Config());
+
+    /** @brief Main thread: the keys were read for this frame. */
+    void sampled(Clock::time_point at);
+
+    /** @brief Main thread: an input read at sampledAt goes out as packet seq (call before handing it over). */
+    void queued(uint32_t seq, Clock::time_point sampledAt);
+
+    /** @brief Network thread: packet seq left the socket. */
+    void sent(uint32_t seq, Clock::time_point at);
+
+    /** @brief Network thread: a snapshot acknowledging every input up to seq arrived. */
+    void acked(uint32_t seq, Clock::time_point at);
+
+    /** @brief Main thread: the prediction was reconciled with a snapshot acknowledging up to seq. */
+    void reconciled(uint32_t seq, Clock::time_point at);
+
+    /** @brief Main thread: a frame was presented; completes this frame's sample and every reconciled input. */
+    void displayed(Clock::time_point at);
+
+    const Distribution& localToDisplay() const { return localToDisplay_; }     ///< Keys read to frame shown, per frame
+    const Distribution& serverConfirmed() const { return serverConfirmed_; }   ///< Keys read to confirmed state shown
+    const Distribution& sampleToSend() const { return sampleToSend_; }         ///< Includes simulated uplink delay
+    const Distribution& sendToAck() const { return sendToAck_; }               ///< Round trip, server tick included
+    const Distribution& ackToReconcile() const { return ackToReconcile_; }     ///< Wait for the main thread
+    const Distribution& reconcileToDisplay() const { return reconcileToDisplay_; }
+
+    /** @brief The first maxRecords confirmed inputs, in order. */
+    const std::vector<Record>& records() const { return records_; }
+
+    /** @brief Confirmed inputs not kept in records() because it was full. */
+    uint64_t recordsDropped() const { return recordsDropped_; }
+
+    /** @brief Counts per bucket, in milliseconds: "<8: 3  <16: 40 ... >=400: 0". */
+    static std::string histogramText(const LatencyHistogram& histogram);
+
+    /**
+     * @brief Writes one CSV row per confirmed input: its stage durations in microseconds
+     *        (-1 where unknown) and the confirmed total.
+     */
+    void exportCsv(std::ostream& out) const;
+
+    /**
+     * @brief Writes every distribution's whole-run histogram as CSV rows: name, bucket upper
+     *        bound in milliseconds ("inf" for the last) and count.
+     */
+    void exportHistograms(std::ostream& out) const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{ 0 };
+        std::atomic<int64_t> sampled{ 0 };   // Clock ticks since the epoch; 0: unset
+        std::atomic<int64_t> sent{ 0 };
+        std::atomic<int64_t> acked{ 0 };
+    };
+
+    Slot& slotOf(uint32_t seq) { return slots_[seq % capacity_]; }
+
+    size_t capacity_;
+    size_t maxRecords_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Network thread
+    uint32_t lastAcked_ = 0;
+
+    // Main thread
+    Clock::time_point frameSampled_{};
+    uint32_t lastReconciled_ = 0;
+    std::vector<std::pair<uint32_t, Clock::time_point>> awaitingDisplay_;   // Reconciled, not shown yet
+    std::vector<Record> records_;
+    uint64_t recordsDropped_ = 0;
+    Distribution localToDisplay_;
+    Distribution serverConfirmed_;
+    Distribution sampleToSend_;
+    Distribution sendToAck_;
+    Distribution ackToReconcile_;
+    Distribution reconcileToDisplay_;
+};
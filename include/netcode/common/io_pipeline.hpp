@@ -0,0 +1,173 @@
+/**
+ * @file io_pipeline.hpp
+ * @brief Pipelined server I/O: receive and send threads joined to the simulation by lock-free rings.
+ *
+ * IoThreads runs a receive thread and a send thread on one bound socket,
+ * each with its own DatagramTransport. They exchange pooled PacketBuffers
+ * with the simulation thread through two PacketPipes:
+ * - inbound: receive thread -> simulation thread (every received datagram)
+ * - outbound: simulation thread -> send thread (every datagram to send)
+ *
+ * A PacketPipe is a fixed pool of buffers and two SpscRings: one carries
+ * filled buffers to the consumer, the other returns them to the producer. No
+ * buffer is allocated or copied between threads, and no lock is taken. When
+ * the pool is exhausted (the consumer is behind), acquire() fails and the
+ * producer drops the datagram instead of waiting.
+ *
+ * A consumer with nothing to do sleeps in wait(); the producer's notify()
+ * wakes it only if it is actually asleep, so a busy pipe makes no wakeup
+ * calls.
+ *
+ * Usage:
+ *   - IoThreads io(sock, TransportKind::Socket); io.start();
+ *   - Simulation thread: while (PacketBuffer* p = io.inbound().poll()) { ...; io.inbound().release(p); }
+ *     and io.inbound().wait(timeout) when idle.
+ *   - To send: p = io.outbound().acquire(); fill it; io.outbound().publish(p);
+ *     io.outbound().notify() after a batch.
+ *   - stop() sends everything already published, then ends both threads and
+ *     releases their transports (the socket stays open).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "spsc_ring.hpp"
+#include "transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @struct PacketBuffer
+ * @brief One pooled datagram travelling between pipeline threads.
+ */
+struct PacketBuffer {
+    sockaddr_in addr;                                 ///< Source (inbound) or destination (outbound)
+    size_t size = 0;                                  ///< Bytes in data
+    bool truncated = false;                           ///< Inbound: larger than MAX_DATAGRAM
+    int64_t kernelQueueNs = -1;                       ///< Inbound: time queued in the kernel (-1: unknown)
+    std::chrono::steady_clock::time_point arrival;    ///< Inbound: when the receive thread got it
+    char data[DatagramTransport::MAX_DATAGRAM];
+};
+
+/**
+ * @class PacketPipe
+ * @brief Pool of PacketBuffers passed from one producer thread to one consumer thread.
+ */
+class PacketPipe {
+public:
+    /** @param capacity Buffers in the pool (rounded up to a power of two) */
+    explicit PacketPipe(size_t capacity);
+
+    PacketPipe(const PacketPipe&) = delete;
+    PacketPipe& operator=(const PacketPipe&) = delete;
+
+    size_t capacity() const { return full_.capacity(); }
+
+    // Producer side
+
+    /** @brief Takes a free buffer, or null if all are in use. */
+    PacketBuffer* acquire();
+
+    /** @brief Hands a filled buffer to the consumer. */
+    void publish(PacketBuffer* buffer);
+
+    /** @brief Wakes the consumer if it sleeps in wait(); call after publishing a batch. */
+    void notify();
+
+    // Consumer side
+
+    /** @brief Takes the oldest published buffer, or null if there is none. */
+    PacketBuffer* poll();
+
+    /** @brief Returns a consumed buffer to the pool. */
+    void release(PacketBuffer* buffer);
+
+    /**
+     * @brief Sleeps until a buffer is published (and notified) or the timeout expires.
+     * @return True if a buffer is ready
+     */
+    bool wait(std::chrono::microseconds timeout);
+
+private:
+    std::unique_ptr<PacketBuffer[]> buffers_;
+    SpscRing<PacketBuffer*> full_;   // Producer -> consumer
+    SpscRing<PacketBuffer*> free_;   // Consumer -> producer
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<bool> sleeping_{ false };
+};
+
+/**
+ * @struct IoCounters
+ * @brief Pipeline counters, readable from any thread.
+ */
+struct IoCounters {
+    std::atomic<uint64_t> received{ 0 };       ///< Datagrams received
+    std::atomic<uint64_t> inboundDrops{ 0 };   ///< Received but dropped: no free inbound buffer
+    std::atomic<uint64_t> kernelDrops{ 0 };    ///< Dropped by the kernel (see TransportStats)
+    std::atomic<uint64_t> sent{ 0 };           ///< Datagrams sent
+    std::atomic<uint64_t> sendErrors{ 0 };     ///< Sends the kernel rejected
+};
+
+/**
+ * @class IoThreads
+ * @brief Receive and send threads for one socket, feeding and draining two PacketPipes.
+ */
+class IoThreads {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 8192;   ///< Buffers per direction
+
+    /**
+     * @param sock     Bound UDP socket (not owned; must outlive the threads)
+     * @param kind     Preferred transport backend for both threads
+     * @param capacity Buffers per direction
+     */
+    IoThreads(SocketHandle sock, TransportKind kind, size_t capacity = DEFAULT_CAPACITY);
+
+    /** @brief Calls stop(). */
+    ~IoThreads();
+
+    IoThreads(const IoThreads&) = delete;
+    IoThreads& operator=(const IoThreads&) = delete;
+
+    /**
+     * @brief Starts both threads; returns once their transports are set up.
+     * @return False if already running
+     */
+    bool start();
+
+    /** @brief Sends every published outbound buffer, then stops both threads. */
+    void stop();
+
+    bool running() const { return running_; }
+
+    /** @brief Backend the threads use (valid after start()). */
+    const std::string& transportName() const { return transportName_; }
+
+    PacketPipe& inbound() { return inbound_; }
+    PacketPipe& outbound() { return outbound_; }
+    const IoCounters& counters() const { return counters_; }
+
+private:
+    void receiveLoop(DatagramTransport& transport);
+    void sendLoop(DatagramTransport& transport);
+
+    SocketHandle sock_;
+    TransportKind kind_;
+    PacketPipe inbound_;
+    PacketPipe outbound_;
+    IoCounters counters_;
+    std::atomic<bool> running_{ false };
+    std::string transportName_;
+    std::thread receiver_;
+    std::thread sender_;
+};
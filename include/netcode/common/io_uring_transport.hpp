@@ -0,0 +1,144 @@
+/**
+ * @file io_uring_transport.hpp
+ * @brief io_uring datagram transport: multishot receive into a provided buffer ring.
+ *
+ * One multishot IORING_OP_RECVMSG stays armed on the socket. The kernel picks
+ * a buffer from a registered buffer ring for each datagram and posts a
+ * completion without a syscall per datagram; receive() reaps all completions
+ * and enters the kernel once (to wait, and to submit queued sends). Buffers
+ * go back to the ring at the start of the next receive().
+ *
+ * If the kernel accepts the buffer ring but never hands out its buffers
+ * (a receive fails with ENOBUFS while buffers are free, as some kernels
+ * do), the transport switches to classic provided buffers
+ * (IORING_OP_PROVIDE_BUFFERS) on the same memory. The datagram stays queued
+ * in the socket, so nothing is lost.
+ *
+ * Sends are IORING_OP_SENDMSG submissions from a fixed pool of slots, handed
+ * to the kernel together by flush(). The socket is a registered (fixed) file,
+ * so no request takes a file reference.
+ *
+ * The ring is set up with raw syscalls (no liburing). create() returns null
+ * if the kernel lacks any required feature (multishot recvmsg, buffer rings,
+ * extended wait arguments: Linux 6.0 or newer) or io_uring is disabled;
+ * makeTransport() then falls back to SocketTransport.
+ *
+ * A send-only transport (create(sock, false)) arms no receive and registers
+ * no buffers, so it never takes a datagram off the socket.
+ *
+ * Usage:
+ *   - auto transport = IoUringTransport::create(sock); or through makeTransport().
+ *   - Create and use it on one thread (the ring is single-issuer).
+ *   - Destroying it cancels the armed receive, so another reader (such as a
+ *     hot-restarted process) gets every later datagram.
+ *
+ * Linux only.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "netcode/common/transport.hpp"
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/**
+ * @class IoUringTransport
+ * @brief Linux backend: multishot recvmsg with a provided buffer ring, batched sendmsg.
+ */
+class IoUringTransport : public DatagramTransport {
+public:
+    static constexpr unsigned SQ_ENTRIES = 256;      ///< Submission queue size
+    static constexpr unsigned CQ_ENTRIES = 4096;     ///< Completion queue size (room for every buffer and send slot)
+    static constexpr unsigned BUFFER_COUNT = 512;    ///< Receive buffers in the ring (power of two)
+    static constexpr unsigned BUFFER_SIZE = 1024;    ///< Bytes per buffer: recvmsg header, address, control messages and MAX_DATAGRAM payload
+    static constexpr unsigned SEND_SLOTS = 1024;     ///< Sends in flight at once
+
+    /**
+     * @brief Sets up a ring for a bound UDP socket.
+     * @param sock    Bound UDP socket (not owned; must outlive the transport)
+     * @param receive False for a send-only transport (receive() then returns nothing)
+     * @return The transport, or null if io_uring or a required feature is unavailable
+     */
+    static std::unique_ptr<IoUringTransport> create(SocketHandle sock, bool receive = true);
+
+    /** @brief Waits for sends in flight, cancels the receive and releases the ring. */
+    ~IoUringTransport() override;
+
+    IoUringTransport(const IoUringTransport&) = delete;
+    IoUringTransport& operator=(const IoUringTransport&) = delete;
+
+    size_t receive(std::vector<ReceivedDatagram>& batch, std::chrono::microseconds timeout) override;
+    bool send(const sockaddr_in& to, const char* data, size_t size) override;
+    size_t flush() override;
+    const char* name() const override;
+
+private:
+    struct SendSlot {
+        msghdr msg;
+        iovec iov;
+        sockaddr_in addr;
+        char data[MAX_DATAGRAM];
+    };
+
+    // Receive buffer layout: io_uring_recvmsg_out, source address, control messages, payload
+    static constexpr size_t PAYLOAD_OFFSET = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in) + METADATA_CONTROL;
+    static_assert(PAYLOAD_OFFSET + MAX_DATAGRAM <= BUFFER_SIZE, "Receive buffers must hold a whole MAX_DATAGRAM payload");
+
+    IoUringTransport() = default;
+
+    bool setup(SocketHandle sock, bool receive);
+    bool setupReceive(SocketHandle sock);
+    io_uring_sqe* nextSqe();
+    unsigned unsubmitted() const;
+    int enter(unsigned minComplete, unsigned flags, std::chrono::microseconds timeout);
+    void armReceive();
+    void reap();
+    void recycle(std::vector<uint16_t>& buffers);
+    void provideBuffers(std::vector<uint16_t>& buffers);
+    void useProvidedBuffers();
+
+    int ringFd_ = -1;
+    io_uring_params params_{};
+    void* ringMap_ = nullptr;
+    size_t ringMapSize_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqesSize_ = 0;
+
+    // Submission and completion ring fields (shared with the kernel)
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqLocalTail_ = 0;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned cqMask_ = 0;
+
+    // Provided buffer ring and the buffers it hands out
+    io_uring_buf_ring* bufferRing_ = nullptr;
+    size_t bufferRingSize_ = 0;
+    char* buffers_ = nullptr;
+    uint16_t bufferTail_ = 0;
+    bool bufferRingRegistered_ = false;
+    bool providedBuffers_ = false;  // Buffers go back with IORING_OP_PROVIDE_BUFFERS instead of the ring
+
+    msghdr receiveMsg_{};          // Template the multishot recvmsg reads (name length only)
+    bool receiving_ = true;        // False for a send-only transport: never armed
+    bool armed_ = false;
+    int receiveError_ = 0;         // Error that last ended the armed receive (0: none)
+    std::vector<ReceivedDatagram> pending_;   // Reaped, not yet returned
+    std::vector<uint16_t> pendingBuffers_;    // Buffers behind pending_
+    std::vector<uint16_t> heldBuffers_;       // Buffers behind the batch last returned
+
+    std::vector<SendSlot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    size_t queued_ = 0;            // Sends written to the SQ since the last flush
+};
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file job_system.hpp
+ * @brief Work-stealing job system with parallelFor over index ranges.
+ *
+ * Each worker thread owns a Chase-Lev deque. Work spawned on a worker goes
+ * onto its own deque and is popped LIFO; idle workers steal FIFO from the
+ * others. Work submitted from outside the pool (e.g. the network thread) is
+ * placed in a per-worker inbox, which lets callers express affinity: the
+ * same item index keeps landing on the same worker unless it gets stolen.
+ *
+ * A worker that waits for a nested parallelFor keeps executing jobs instead
+ * of blocking, so parallel loops can be nested (rooms in parallel, clients
+ * in parallel within a large room) without deadlock.
+ *
+ * Usage:
+ *   - parallelFor(begin, end, grain, [](size_t b, size_t e) { ... }) splits
+ *     the range into chunks of at least grain indices.
+ *   - parallelForEach(count, affinity, fn) runs fn(i) for every i, queuing
+ *     item i on worker affinity(i) % workerCount() when called from outside.
+ *   - Both block until all work is done; the callable must not throw.
+ *   - An optional start hook runs first on every worker thread (e.g. to pin
+ *     it to a core before it touches any data).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "work_stealing_deque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief Fixed pool of worker threads executing fork-join parallel loops.
+ */
+class JobSystem {
+public:
+    /** @brief Returned by currentWorker() on threads that are not workers of this pool. */
+    static constexpr size_t NOT_A_WORKER = static_cast<size_t>(-1);
+
+    /** @brief Called on each worker thread, with its index, before it runs any job. */
+    using WorkerStart = std::function<void(size_t worker)>;
+
+    /**
+     * @param workers Number of worker threads (at least 1)
+     * @param onStart Optional hook run first on every worker thread
+     */
+    explicit JobSystem(size_t workers, WorkerStart onStart = {});
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Calls fn(chunkBegin, chunkEnd) over disjoint chunks covering [begin, end).
+     * @param begin First index
+     * @param end   One past the last index
+     * @param grain Smallest chunk; ranges of at most one chunk run inline on the caller
+     * @param fn    Callable (size_t chunkBegin, size_t chunkEnd)
+     */
+    template<typename Fn>
+    void parallelFor(size_t begin, size_t end, size_t grain, const Fn& fn) {
+        if (end <= begin) {
+            return;
+        }
+        const size_t count = end - begin;
+        // Enough chunks to balance, few enough that scheduling stays cheap
+        const size_t chunk = std::max({ grain, size_t(1), (count + 4 * workerCount() - 1) / (4 * workerCount()) });
+        if (count <= chunk) {
+            fn(begin, end);
+            return;
+        }
+
+        std::vector<Job> jobs((count + chunk - 1) / chunk);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            Job& job = jobs[i];
+            job.invoke = [](const void* context, size_t b, size_t e) { (*static_cast<const Fn*>(context))(b, e); };
+            job.context = &fn;
+            job.begin = begin + i * chunk;
+            job.end = std::min(end, job.begin + chunk);
+            job.affinity = i;
+        }
+        execute(jobs.data(), jobs.size());
+    }
+
+    /**
+     * @brief Calls fn(i) for every i in [0, count), one job per item.
+     * @param count    Number of items
+     * @param affinity Callable (size_t i) -> size_t; preferred worker for item i (modulo workerCount())
+     * @param fn       Callable (size_t i)
+     */
+    template<typename Fn, typename Affinity>
+    void parallelForEach(size_t count, const Affinity& affinity, const Fn& fn) {
+        if (count == 0) {
+            return;
+        }
+        std::vector<Job> jobs(count);
+        for (size_t i = 0; i < count; ++i) {
+            Job& job = jobs[i];
+            job.invoke = [](const void* context, size_t b, size_t) { (*static_cast<const Fn*>(context))(b); };
+            job.context = &fn;
+            job.begin = i;
+            job.end = i + 1;
+            job.affinity = static_cast<size_t>(affinity(i));
+        }
+        execute(jobs.data(), jobs.size());
+    }
+
+    size_t workerCount() const { return workers_.size(); }
+
+    /**
+     * @brief Index of the calling worker thread, or NOT_A_WORKER.
+     */
+    size_t currentWorker() const;
+
+    /** @brief Jobs executed by a worker other than the one they were queued on (cumulative). */
+    uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct Batch;
+
+    struct Job {
+        void (*invoke)(const void* context, size_t begin, size_t end) = nullptr;
+        const void* context = nullptr;
+        size_t begin = 0, end = 0;
+        size_t affinity = 0;
+        Batch* batch = nullptr;
+    };
+
+    /** @brief Completion state of one parallelFor call. */
+    struct Batch {
+        std::atomic<size_t> pending{ 0 };
+        bool externalWaiter = false;    // Caller blocks on done instead of helping
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Job> deque;
+        std::mutex inboxMutex;
+        std::vector<Job*> inbox;        // Submitted from outside the pool
+        std::thread thread;
+    };
+
+    void execute(Job* jobs, size_t count);
+    void runJob(Job* job);
+    Job* findJob(size_t self);
+    Job* takeFromInbox(Worker& worker, bool own);
+    void notifyWork();
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    WorkerStart onStart_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<uint64_t> epoch_{ 0 };     // Bumped whenever new work is queued
+    std::atomic<size_t> sleeping_{ 0 };
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> steals_{ 0 };
+};
@@ -0,0 +1,195 @@
+/**
+ * @file latency_profile.hpp
+ * @brief Low-latency server profile: core pinning, NUMA-local memory, socket tuning and tick jitter.
+ *
+ * With the profile on, the server thread is pinned to one core and the
+ * worker threads to others on the same NUMA node. The server thread prefers
+ * memory from that node, and Linux places pages on the node of the thread
+ * that first touches them. Rooms and their client state are created on the
+ * server thread and ticked by workers on the same node, so their memory
+ * stays local.
+ *
+ * The socket gets busy polling (SO_BUSY_POLL: the receiving thread polls the
+ * device queue instead of sleeping until an interrupt), larger send and
+ * receive buffers, and a DSCP mark so routers can prioritize game traffic.
+ *
+ * JitterStats records how late each tick starts, with or without the
+ * profile, so the effect can be measured. It keeps every sample for exact
+ * percentiles; LatencyHistogram is its constant-memory counterpart for
+ * statistics read on a hot path (fixed buckets, no sorting).
+ *
+ * Usage:
+ *   - const CorePlan plan = planCores(profile, 0); pinCurrentThread(plan.server);
+ *     preferLocalMemory(numaNodeOfCore(plan.server)); create the RoomScheduler with a
+ *     start hook that pins worker i to plan.workers[i].
+ *   - applySocketProfile(sock, profile) once the socket is bound; log the result.
+ *   - jitter.record(now - scheduledTick) every tick; print and reset() periodically.
+ *
+ * Pinning and NUMA placement are Linux only (elsewhere they report failure and
+ * change nothing). Busy polling needs CAP_NET_ADMIN and a NIC with NAPI;
+ * buffers above the system maximum need CAP_NET_ADMIN.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "netcode/common/transport.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct LatencyProfile
+ * @brief Settings of the low-latency profile.
+ */
+struct LatencyProfile {
+    std::vector<int> cores;               ///< First core for the server thread, the rest for workers (empty: the current core's NUMA node)
+    int busyPollMicros = 50;              ///< SO_BUSY_POLL time per receive (0: off)
+    int receiveBufferBytes = 4 << 20;     ///< SO_RCVBUF (0: keep the default)
+    int sendBufferBytes = 4 << 20;        ///< SO_SNDBUF (0: keep the default)
+    int dscp = 46;                        ///< DSCP code point (46: Expedited Forwarding; -1: unmarked)
+};
+
+/**
+ * @struct SocketProfileResult
+ * @brief What applySocketProfile() actually achieved.
+ */
+struct SocketProfileResult {
+    bool busyPoll = false;        ///< SO_BUSY_POLL accepted
+    int receiveBufferBytes = 0;   ///< Receive buffer reported by the kernel afterwards
+    int sendBufferBytes = 0;      ///< Send buffer reported by the kernel afterwards
+    bool dscp = false;            ///< DSCP mark set
+};
+
+/**
+ * @struct CorePlan
+ * @brief Cores chosen for the server thread and each worker (-1: not pinned).
+ */
+struct CorePlan {
+    int server = -1;
+    std::vector<int> workers;
+};
+
+/**
+ * @brief Applies the socket part of a profile; each setting is tried independently.
+ */
+SocketProfileResult applySocketProfile(SocketHandle sock, const LatencyProfile& profile);
+
+/**
+ * @brief Chooses cores for the server thread and workers.
+ *
+ * Uses profile.cores if given, otherwise the online cores of the NUMA node
+ * the caller runs on (the caller's core first). Workers get the remaining
+ * cores, round robin; with a single core everything shares it.
+ *
+ * @param profile Profile (cores may be empty)
+ * @param workers Number of worker threads (0: one per core besides the server's, at least one)
+ * @return The plan; all -1 if cores cannot be determined
+ */
+CorePlan planCores(const LatencyProfile& profile, size_t workers);
+
+/** @brief Pins the calling thread to one core. @return False if unsupported or refused */
+bool pinCurrentThread(int core);
+
+/** @brief Core the calling thread runs on, or -1 if unknown. */
+int currentCore();
+
+/** @brief NUMA node of a core, or -1 if unknown (0 on machines without NUMA information). */
+int numaNodeOfCore(int core);
+
+/** @brief Online cores of a NUMA node (empty if unknown). */
+std::vector<int> coresOfNode(int node);
+
+/**
+ * @brief Makes the calling thread allocate memory on a NUMA node when it has free memory.
+ * @return False if unsupported
+ */
+bool preferLocalMemory(int node);
+
+/**
+ * @brief Parses a Linux cpulist such as "0-3,8,10-11".
+ * @return The cores in order, or empty if malformed
+ */
+std::vector<int> parseCoreList(const std::string& list);
+
+/**
+ * @class JitterStats
+ * @brief Distribution of delays: how late each tick began, or how long datagrams queued.
+ *
+ * With a window, only the last `window` samples are kept, so memory and the cost of a
+ * percentile stay bounded however long it records; count(), percentiles and histograms
+ * cover those samples, max() every sample since reset().
+ */
+class JitterStats {
+public:
+    /** @param window Samples kept (each new one replaces the oldest); 0 keeps every sample */
+    explicit JitterStats(size_t window = 0) : window_(window) {}
+
+    void record(std::chrono::nanoseconds lateness);
+
+    size_t count() const { return samples_.size(); }
+
+    /** @brief Lateness at quantile q (0..1); zero without samples. */
+    std::chrono::nanoseconds percentile(double q) const;
+
+    std::chrono::nanoseconds max() const { return max_; }
+
+    /** @brief Human-readable summary: "p50 .. us, p99 .. us, max .. us over N ticks". */
+    std::string summary() const;
+
+    /**
+     * @brief Counts samples per bucket: below bounds[0], below bounds[1], ..., and at or above the last.
+     * @param bounds Ascending upper bounds
+     * @return bounds.size() + 1 counts
+     */
+    std::vector<size_t> histogram(const std::vector<std::chrono::nanoseconds>& bounds) const;
+
+    void reset();
+
+private:
+    size_t window_;
+    size_t next_ = 0;                       // Slot the next sample overwrites once the window is full
+    std::vector<int64_t> samples_;
+    mutable std::vector<int64_t> sorted_;
+    mutable bool dirty_ = false;
+    std::chrono::nanoseconds max_{ 0 };
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Delays counted into fixed buckets: constant memory, no allocation or sorting after construction.
+ *
+ * Percentiles are resolved to bucket bounds, so choose bounds as fine as the report needs.
+ */
+class LatencyHistogram {
+public:
+    /** @param bounds Ascending bucket upper bounds; one more bucket holds everything at or above the last */
+    explicit LatencyHistogram(std::vector<std::chrono::nanoseconds> bounds);
+
+    void record(std::chrono::nanoseconds delay);
+
+    uint64_t count() const { return count_; }
+    std::chrono::nanoseconds max() const { return max_; }
+    const std::vector<std::chrono::nanoseconds>& bounds() const { return bounds_; }
+
+    /** @brief Samples per bucket: below bounds[0], below bounds[1], ..., and at or above the last. */
+    const std::vector<uint64_t>& counts() const { return counts_; }
+
+    /**
+     * @brief Upper bound of the bucket holding quantile q (0..1), or max() for the last
+     *        bucket; zero without samples.
+     */
+    std::chrono::nanoseconds percentile(double q) const;
+
+    void reset();
+
+private:
+    std::vector<std::chrono::nanoseconds> bounds_;
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    std::chrono::nanoseconds max_{ 0 };
+};
@@ -0,0 +1,127 @@
+/**
+ * @file load_governor.hpp
+ * @brief Overload shedding: measures processing time against a budget and sheds work step by step.
+ *
+ * Every tick closes a measurement window. The window's load is the larger of
+ * - tick time / per-tick budget, and
+ * - mean time per received datagram / per-packet budget,
+ * so 1.0 means exactly on budget. Several over-budget windows in a row raise
+ * the shedding level by one; a longer run of calm windows (load below
+ * recoverBelow) lowers it by one. Levels, each adding to the previous:
+ * 1. ReduceIdle: clients that are not moving are answered every Nth tick
+ * 2. CoalesceInputs: a client's queued inputs are applied as one
+ * 3. ShedConnections: clients not seen before are refused
+ *
+ * Every transition is passed to a listener (the server logs it and applies
+ * the level's LoadShedding to its rooms); counters record how many
+ * transitions happened and how many windows were spent at each level.
+ *
+ * Usage:
+ *   - LoadGovernor governor(budget, [&](const LoadTransition& t) { router.setShedding(t.shedding); ... });
+ *   - governor.recordPacket(took) per processed datagram
+ *   - governor.endWindow(tickTime) once per tick, after the tick's work
+ *   - report() for a summary of where the time went
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "room.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/** @brief How much work is being shed, from none to the most. */
+enum class LoadLevel : uint8_t { Normal, ReduceIdle, CoalesceInputs, ShedConnections };
+
+constexpr size_t LOAD_LEVELS = 4;
+
+/** @brief Lower-case name of a level, for logs. */
+const char* loadLevelName(LoadLevel level);
+
+/**
+ * @struct LoadBudget
+ * @brief Budgets and reaction speeds of a LoadGovernor.
+ */
+struct LoadBudget {
+    std::chrono::nanoseconds perPacket = std::chrono::microseconds(20);   ///< Mean processing time per datagram
+    std::chrono::nanoseconds perTick = std::chrono::milliseconds(8);      ///< Processing time per tick
+    double recoverBelow = 0.6;          ///< A window with lower load counts as calm
+    uint32_t escalateAfter = 3;         ///< Over-budget windows in a row before shedding more
+    uint32_t recoverAfter = 120;        ///< Calm windows in a row before shedding less
+    uint32_t idleResponseInterval = 4;  ///< ReduceIdle and up: answer idle clients every Nth tick
+};
+
+/**
+ * @struct LoadTransition
+ * @brief One change of shedding level and the window that caused it.
+ */
+struct LoadTransition {
+    LoadLevel from;
+    LoadLevel to;
+    LoadShedding shedding;                  ///< What rooms may skip from now on
+    double load;                            ///< Load of the deciding window (1.0: on budget)
+    std::chrono::nanoseconds tickTime;      ///< Its tick time
+    std::chrono::nanoseconds packetTime;    ///< Its mean time per datagram (0 without datagrams)
+    uint64_t window;                        ///< Windows closed before it
+};
+
+/**
+ * @class LoadGovernor
+ * @brief Chooses a shedding level from measured processing time, with hysteresis.
+ */
+class LoadGovernor {
+public:
+    using Listener = std::function<void(const LoadTransition&)>;
+
+    explicit LoadGovernor(const LoadBudget& budget = LoadBudget(), Listener listener = Listener());
+
+    /** @brief Adds the processing time of one datagram to the current window. */
+    void recordPacket(std::chrono::nanoseconds took);
+
+    /**
+     * @brief Closes the current window with its tick time and updates the level.
+     * @return Level for the next window
+     */
+    LoadLevel endWindow(std::chrono::nanoseconds tickTime);
+
+    LoadLevel level() const { return level_; }
+
+    /** @brief What rooms may skip at the current level. */
+    LoadShedding shedding() const { return sheddingFor(level_, budget_); }
+
+    /** @brief Load of the last closed window (1.0: on budget). */
+    double load() const { return load_; }
+
+    uint64_t transitions() const { return transitions_; }
+
+    /** @brief Windows closed at a level. */
+    uint64_t windowsAt(LoadLevel level) const { return windowsAt_[static_cast<size_t>(level)]; }
+
+    const LoadBudget& budget() const { return budget_; }
+
+    /** @brief One-line summary: last load, level, transitions and windows per level. */
+    std::string report() const;
+
+    /** @brief The LoadShedding a level stands for. */
+    static LoadShedding sheddingFor(LoadLevel level, const LoadBudget& budget);
+
+private:
+    void change(LoadLevel to, std::chrono::nanoseconds tickTime, std::chrono::nanoseconds packetTime);
+
+    LoadBudget budget_;
+    Listener listener_;
+    LoadLevel level_ = LoadLevel::Normal;
+    std::chrono::nanoseconds packetTotal_{ 0 };
+    uint64_t packets_ = 0;
+    uint32_t overRun_ = 0;    // Over-budget windows in a row
+    uint32_t calmRun_ = 0;    // Calm windows in a row
+    double load_ = 0.0;
+    uint64_t windows_ = 0;
+    uint64_t transitions_ = 0;
+    std::array<uint64_t, LOAD_LEVELS> windowsAt_{};
+};
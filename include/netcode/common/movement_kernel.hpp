@@ -0,0 +1,66 @@
+/**
+ * @file movement_kernel.hpp
+ * @brief Vectorized movement integration and bounds clamping over SoA arrays.
+ *
+ * Advances many entities by one input each, computing per lane:
+ *
+ *   step  = clamp(dt, 0, maxStep)
+ *   vx    = clamp(inputX, -1, 1) * moveSpeed          (same for y)
+ *   x     = clamp(x + vx * step, boundsMin, boundsMax)
+ *
+ * which is the server's per-input movement rule. AVX2 (8 lanes) and SSE
+ * (4 lanes) kernels are selected at runtime; every tier produces bit-identical
+ * results to the scalar path: no fused multiply-add, and each clamp is
+ * evaluated as min(hi, max(lo, v)) with operand order chosen so that NaN
+ * propagates exactly like std::clamp. The one exception is the payload of a
+ * NaN produced from two NaN operands, which depends on operand order and is
+ * not fixed even in scalar code; such lanes are NaN on every tier.
+ *
+ * Usage:
+ *   - Fill MovementColumns with pointers to count entries each; x/y/vx/vy are
+ *     updated in place, inputX/inputY/dt are read only.
+ *   - integrateAndClamp(columns, count, params) picks the best kernel.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "cpu_features.hpp"
+#include <cstddef>
+
+/**
+ * @struct MovementParams
+ * @brief Movement rule constants.
+ */
+struct MovementParams {
+    float moveSpeed;   ///< Velocity at full input (units per second)
+    float boundsMin;   ///< Smallest allowed x and y
+    float boundsMax;   ///< Largest allowed x and y
+    float maxStep;     ///< Largest dt applied per input (seconds)
+};
+
+/**
+ * @struct MovementColumns
+ * @brief SoA views over the entities to advance (all arrays have the same length).
+ */
+struct MovementColumns {
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    const float* inputX;
+    const float* inputY;
+    const float* dt;
+};
+
+/**
+ * @brief Applies one input to each of count entities.
+ * @param columns Entity state (updated in place) and per-entity input
+ * @param count   Number of entities
+ * @param params  Movement rule constants
+ * @param level   Highest SIMD tier to use (defaults to the best the CPU supports)
+ */
+void integrateAndClamp(const MovementColumns& columns, size_t count, const MovementParams& params,
+    SimdLevel level = bestSimdLevel());
@@ -10,6 +10,10 @@
  *   - Use Packet::serialize() before sending over the network.
  *   - Use Packet::deserialize() after receiving from the network.
  *   - Use Packet::isValid() to validate packet contents after deserialization.
+ *   - On the wire, use serializeWithChecksum() / hasValidChecksum(): the payload is
+ *     followed by a CRC32C trailer salted with PROTOCOL_ID (Packet::wireSize() bytes).
+ *   - Server snapshots carry a SnapshotAck between the payload and the trailer: use
+ *     serializeSnapshot() / hasValidSnapshotChecksum() (Packet::snapshotWireSize() bytes).
  *
  * @author Aryan Malekian & Jonathan Skomsy Hbertz,  w/ use of A.I. Models 
  * @date 20.05.2025
@@ -17,6 +21,7 @@
 
 #pragma once
 
+#include "crc32c.hpp"
 #include <cstdint>
 #include <cstring>
 #include <cmath>
@@ -27,6 +32,48 @@
 #include <arpa/inet.h>  
 #endif
 
+/**
+ * @struct SnapshotAck
+ * @brief What a server snapshot tells its client besides the state in the Packet.
+ *
+ * Snapshots are numbered per client, counting only those actually sent: the server
+ * skips snapshots on purpose (dead reckoning, idle clients under load), so the echoed
+ * input sequence number cannot tell a skipped snapshot from a lost one.
+ *
+ * Clients only send input when it changes, and the server keeps applying the last one
+ * in between (held input). Packet::seq says which input the state includes; heldMicros
+ * says for how long after it the server has kept moving the client with it, so the
+ * client knows which of its own frames since that input the state already covers.
+ */
+struct SnapshotAck {
+    uint32_t snapshotSeq = 0;  /**< Snapshots sent to this client so far, this one included (a gap is a loss) */
+    uint32_t heldMicros = 0;   /**< Simulated time after input Packet::seq the state includes (held input, microseconds) */
+
+    /**
+     * @brief Returns the number of bytes SnapshotAck occupies on the wire.
+     */
+    static constexpr size_t size() {
+        return sizeof(snapshotSeq) + sizeof(heldMicros);
+    }
+
+    /** @brief Writes the fields in network byte order to buf (size() bytes). */
+    void serialize(char* buf) const {
+        uint32_t nseq = htonl(snapshotSeq);
+        uint32_t nheld = htonl(heldMicros);
+        memcpy(buf, &nseq, sizeof(nseq));
+        memcpy(buf + sizeof(nseq), &nheld, sizeof(nheld));
+    }
+
+    /** @brief Reads the fields from buf (size() bytes). */
+    void deserialize(const char* buf) {
+        uint32_t nseq, nheld;
+        memcpy(&nseq, buf, sizeof(nseq));
+        memcpy(&nheld, buf + sizeof(nseq), sizeof(nheld));
+        snapshotSeq = ntohl(nseq);
+        heldMicros = ntohl(nheld);
+    }
+};
+
  /**
   * @struct Packet
   * @brief A fixed-size UDP packet format carrying sequence, position, and velocity.
@@ -40,6 +87,10 @@ struct Packet {
     float x, y;    /**< 2D position of the object */
     float vx, vy;  /**< 2D velocity (units per second) */
 
+    static constexpr float MAX_POSITION = 10000.0f;  ///< Largest accepted |x| and |y|
+    static constexpr float MAX_VELOCITY = 1000.0f;   ///< Largest accepted |vx| and |vy|
+    static constexpr uint32_t PROTOCOL_ID = 0x4E434431;  ///< "NCD1"; salts the checksum so stray traffic is rejected
+
     /**
      * @brief Default constructor initializes all fields to zero.
      */
@@ -90,13 +141,11 @@ struct Packet {
         }
 
         
-        constexpr float MAX_POSITION = 10000.0f;
         if (std::abs(x) > MAX_POSITION || std::abs(y) > MAX_POSITION) {
             return false;
         }
 
         
-        constexpr float MAX_VELOCITY = 1000.0f;
         if (std::abs(vx) > MAX_VELOCITY || std::abs(vy) > MAX_VELOCITY) {
             return false;
         }
@@ -116,4 +165,90 @@ struct Packet {
     static constexpr size_t size() {
         return sizeof(seq) + 4 * sizeof(float);
     }
+
+    /**
+     * @brief Returns the datagram size on the wire: payload plus the 4-byte CRC32C trailer.
+     * @return size in bytes
+     */
+    static constexpr size_t wireSize() {
+        return size() + sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Returns the size of a server snapshot on the wire: payload, SnapshotAck and the CRC32C trailer.
+     * @return size in bytes
+     */
+    static constexpr size_t snapshotWireSize() {
+        return size() + SnapshotAck::size() + sizeof(uint32_t);
+    }
+
+    /**
+     * @brief CRC32C of the protocol id (network byte order) followed by the payload.
+     * @param payload Serialized payload
+     * @param length  Payload bytes: Packet::size(), or more for a snapshot with its SnapshotAck
+     */
+    static uint32_t checksum(const char* payload, size_t length = size()) {
+        static const uint32_t salt = [] {
+            uint32_t nid = htonl(PROTOCOL_ID);
+            return crc32c(&nid, sizeof(nid));
+        }();
+        return crc32c(payload, length, salt);
+    }
+
+    /**
+     * @brief Serialize this Packet followed by its checksum trailer.
+     * @param[out] buf  Pointer to a writable buffer of at least Packet::wireSize() bytes.
+     */
+    void serializeWithChecksum(char* buf) const {
+        serialize(buf);
+        uint32_t ncrc = htonl(checksum(buf));
+        memcpy(buf + size(), &ncrc, sizeof(ncrc));
+    }
+
+    /**
+     * @brief Checks the length and checksum trailer of a received datagram.
+     *
+     * Call this before deserializing; on success the first Packet::size() bytes are the payload.
+     * @param buf    Received datagram
+     * @param length Number of bytes received
+     * @return True if the datagram is exactly wireSize() bytes and the trailer matches
+     */
+    static bool hasValidChecksum(const char* buf, size_t length) {
+        if (buf == nullptr || length != wireSize()) {
+            return false;
+        }
+        uint32_t ncrc;
+        memcpy(&ncrc, buf + size(), sizeof(ncrc));
+        return ntohl(ncrc) == checksum(buf);
+    }
+
+    /**
+     * @brief Serialize this Packet as a server snapshot: payload, ack, then the checksum of both.
+     * @param[out] buf  Pointer to a writable buffer of at least Packet::snapshotWireSize() bytes.
+     * @param ack       What the snapshot acknowledges
+     */
+    void serializeSnapshot(char* buf, const SnapshotAck& ack) const {
+        serialize(buf);
+        ack.serialize(buf + size());
+        uint32_t ncrc = htonl(checksum(buf, size() + SnapshotAck::size()));
+        memcpy(buf + size() + SnapshotAck::size(), &ncrc, sizeof(ncrc));
+    }
+
+    /**
+     * @brief Checks the length and checksum trailer of a received snapshot.
+     *
+     * On success the first Packet::size() bytes are the payload and the SnapshotAck follows.
+     * @param buf    Received datagram
+     * @param length Number of bytes received
+     * @return True if the datagram is exactly snapshotWireSize() bytes and the trailer matches
+     */
+    static bool hasValidSnapshotChecksum(const char* buf, size_t length) {
+        if (buf == nullptr || length != snapshotWireSize()) {
+            return false;
+        }
+        const size_t covered = size() + SnapshotAck::size();
+        uint32_t ncrc;
+        memcpy(&ncrc, buf + covered, sizeof(ncrc));
+        return ntohl(ncrc) == checksum(buf, covered);
+    }
 };
\ No newline at end of file
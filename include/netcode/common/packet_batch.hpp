@@ -0,0 +1,76 @@
+/**
+ * @file packet_batch.hpp
+ * @brief Batch deserialization and SIMD validation of contiguous packets.
+ *
+ * Packet::isValid() checks one packet at a time with per-field branches.
+ * PacketBatch instead deserializes N contiguous wire packets into
+ * structure-of-arrays columns and validates all of them at once with
+ * AVX2/SSE compares and a movemask, producing a validity bitmask.
+ * The scalar path is kept as a fallback and as the reference for tests.
+ *
+ * Usage:
+ *   - Call deserialize() on a buffer holding count * Packet::size() bytes.
+ *   - Call validate() to get a bitmask (bit i set = packet i is valid).
+ *   - Use at() to materialize individual packets that passed validation.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "packet.hpp"
+#include "cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct PacketBatch
+ * @brief Structure-of-arrays view of N deserialized packets.
+ *
+ * Each field of Packet is stored in its own contiguous column so the
+ * validation kernel can load 4 (SSE) or 8 (AVX2) values per instruction.
+ * Validation semantics are identical to Packet::isValid().
+ */
+struct PacketBatch {
+    std::vector<uint32_t> seq;  /**< Sequence numbers (host byte order) */
+    std::vector<float> x, y;    /**< Positions */
+    std::vector<float> vx, vy;  /**< Velocities */
+
+    /**
+     * @brief Deserialize count contiguous wire packets into the columns.
+     * @param[in] buf   Buffer holding at least count * Packet::size() bytes
+     * @param     count Number of packets in the buffer
+     */
+    void deserialize(const char* buf, size_t count);
+
+    /**
+     * @brief Validate every packet in the batch.
+     *
+     * Bit (i % 64) of validMask[i / 64] is set when packet i would pass
+     * Packet::isValid(). The mask is resized to (size() + 63) / 64 words.
+     *
+     * @param[out] validMask Validity bitmask
+     * @param      level     SIMD tier to use (defaults to the best available)
+     * @return Number of valid packets
+     */
+    size_t validate(std::vector<uint64_t>& validMask, SimdLevel level = bestSimdLevel()) const;
+
+    /**
+     * @brief Materialize packet i as a regular Packet.
+     */
+    Packet at(size_t i) const { return Packet(seq[i], x[i], y[i], vx[i], vy[i]); }
+
+    /**
+     * @brief Number of packets held by the batch.
+     */
+    size_t size() const { return seq.size(); }
+
+    /**
+     * @brief Returns true if bit i is set in a mask produced by validate().
+     */
+    static bool isSet(const std::vector<uint64_t>& validMask, size_t i) {
+        return (validMask[i / 64] >> (i % 64)) & 1u;
+    }
+};
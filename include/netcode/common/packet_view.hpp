@@ -0,0 +1,107 @@
+/**
+ * @file packet_view.hpp
+ * @brief Non-owning, zero-copy view of a serialized Packet in a receive buffer.
+ *
+ * Packet::deserialize() copies every field into a Packet before the caller
+ * can look at anything. PacketView instead wraps the received bytes where
+ * they already are and decodes individual fields on demand, so a consumer
+ * that only needs the sequence number (or rejects the datagram early) never
+ * copies the rest. All reads are bounds-checked against the datagram length.
+ *
+ * Usage:
+ *   - Construct from the buffer and the byte count returned by recvfrom().
+ *   - Check hasValidSize() / isValid() before trusting the fields.
+ *   - Call toPacket() only when an owning copy is actually needed.
+ *
+ * The view does not own the buffer; it must not outlive it.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "packet.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+ /**
+  * @class PacketView
+  * @brief Lazily decodes Packet fields straight from a received datagram.
+  *
+  * Field accessors read with memcpy (no alignment requirements) and return
+  * zero when the datagram is too short to contain the field, so a view over
+  * a truncated or empty buffer is always safe to query.
+  */
+class PacketView {
+    const char* data_;
+    size_t length_;
+
+    static constexpr size_t SEQ_OFFSET = 0;
+    static constexpr size_t X_OFFSET = 4;
+    static constexpr size_t Y_OFFSET = 8;
+    static constexpr size_t VX_OFFSET = 12;
+    static constexpr size_t VY_OFFSET = 16;
+
+    float readFloat(size_t offset) const {
+        float value = 0.0f;
+        if (data_ && offset + sizeof(value) <= length_) {
+            memcpy(&value, data_ + offset, sizeof(value));
+        }
+        return value;
+    }
+
+public:
+    /**
+     * @brief Creates an empty view (hasValidSize() is false).
+     */
+    PacketView() : data_(nullptr), length_(0) {}
+
+    /**
+     * @brief Wraps a received datagram.
+     * @param data   Start of the datagram bytes (not copied)
+     * @param length Number of bytes received
+     */
+    PacketView(const char* data, size_t length) : data_(data), length_(length) {}
+
+    /**
+     * @brief True if the datagram is exactly one serialized Packet.
+     */
+    bool hasValidSize() const { return data_ != nullptr && length_ == Packet::size(); }
+
+    uint32_t seq() const {
+        uint32_t nseq = 0;
+        if (data_ && SEQ_OFFSET + sizeof(nseq) <= length_) {
+            memcpy(&nseq, data_ + SEQ_OFFSET, sizeof(nseq));
+        }
+        return ntohl(nseq);
+    }
+
+    float x() const { return readFloat(X_OFFSET); }
+    float y() const { return readFloat(Y_OFFSET); }
+    float vx() const { return readFloat(VX_OFFSET); }
+    float vy() const { return readFloat(VY_OFFSET); }
+
+    /**
+     * @brief Same checks as Packet::isValid(), plus the datagram size, without materializing a Packet.
+     * @return True if the datagram holds a well-formed, in-range packet
+     */
+    bool isValid() const {
+        if (!hasValidSize() || seq() == 0) {
+            return false;
+        }
+        // Ordered <= rejects NaN, and +/-Inf exceeds the bound, matching isfinite() + range checks
+        return std::abs(x()) <= Packet::MAX_POSITION && std::abs(y()) <= Packet::MAX_POSITION &&
+            std::abs(vx()) <= Packet::MAX_VELOCITY && std::abs(vy()) <= Packet::MAX_VELOCITY;
+    }
+
+    /**
+     * @brief Materializes an owning Packet (the single copy out of the receive buffer).
+     */
+    Packet toPacket() const { return Packet(seq(), x(), y(), vx(), vy()); }
+
+    const char* data() const { return data_; }
+    size_t length() const { return length_; }
+};
@@ -21,6 +21,7 @@
 
 #include "packet.hpp"
 #include "input.hpp"
+#include <chrono>
 #include <utility>
 #include <deque>
 #include <optional>
@@ -68,6 +69,8 @@ private:
     float serverX, serverY;
     float serverVx, serverVy;
     uint32_t lastAckedSequence;
+    std::chrono::microseconds lastAckedHeld;   ///< How long the server had held lastAckedSequence
+    float heldCovered;                         ///< Seconds of that held time the frames dropped so far stand for
 
     /** @brief Error accumulator for smooth correction (pixels offset to apply over time) */
     float errorX, errorY;
@@ -94,14 +97,21 @@ public:
      * @brief Reconcile with authoritative server state (rollback, replay, and error correction).
      *
      * When a server packet is received, the system:
-     *   1. Discards inputs older than server's sequence/ack.
+     *   1. Discards inputs the server has applied: those sent in packets up to the acknowledged
+     *      one, plus the frames after it that `held` covers (the server kept moving the object
+     *      with that input for `held` after applying it).
      *   2. Resets the predicted state to match the server.
      *   3. Reapplies all still-unacknowledged inputs in buffer.
      *   4. Calculates offset (error) and begins smooth correction.
      *
+     * A packet older than the last one reconciled (lower sequence, or the same sequence held
+     * for less time) arrived out of order and is ignored.
+     *
      * @param serverPacket The latest Packet received from server (authoritative state).
+     * @param held         How long the server has held the acknowledged input (SnapshotAck::heldMicros)
      */
-    void reconcileWithServer(const Packet& serverPacket);
+    void reconcileWithServer(const Packet& serverPacket,
+        std::chrono::microseconds held = std::chrono::microseconds::zero());
 
     /**
      * @brief Progresses error correction and updates predicted state for the current frame.
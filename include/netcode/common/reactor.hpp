@@ -0,0 +1,237 @@
+/**
+ * @file reactor.hpp
+ * @brief Single-threaded event loop that resumes coroutines when sockets are ready or timers expire.
+ *
+ * A Reactor runs any number of Task<void> coroutines on the thread that
+ * calls run(). A coroutine waits with co_await on:
+ * - readable(sock) / writable(sock): the socket is ready (or a deadline passes)
+ * - sleepUntil(time) / sleepFor(duration): a timer
+ * - ReactorEvent::wait(): another thread called set()
+ * - asyncRecvFrom() / asyncSendTo(): one datagram, waiting as needed
+ *
+ * While every coroutine waits, the thread sleeps in epoll_wait (Linux) or
+ * poll/WSAPoll (elsewhere) until the earliest deadline. Protocol logic that
+ * used to need a thread or a hand-written state machine per peer reads as
+ * straight-line code:
+ *
+ *   Task<void> session(Reactor& reactor, SocketHandle sock) {
+ *       while (true) {
+ *           const int bytes = co_await asyncRecvFrom(reactor, sock, buf, sizeof(buf), from, reactor.after(timeout));
+ *           if (bytes < 0) { ...resend or give up...; continue; }
+ *           ...
+ *           co_await reactor.sleepUntil(nextTick);
+ *       }
+ *   }
+ *
+ * Usage:
+ *   - Reactor reactor; reactor.spawn(session(reactor, sock)); reactor.run();
+ *   - Sockets must be non-blocking. run() returns when every task has
+ *     finished or stop() is called; unfinished tasks are destroyed with the
+ *     Reactor.
+ *   - Only stop(), post() and ReactorEvent::set() may be called from other
+ *     threads.
+ *
+ * On Windows, WSAStartup must have been called before a Reactor is created
+ * (it owns a loopback socket used to wake it from other threads).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "task.hpp"
+#include "transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Reactor
+ * @brief Runs coroutines on one thread, resuming them on socket readiness, timers and posted events.
+ */
+class Reactor {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr Clock::time_point NEVER = Clock::time_point::max();
+
+    /**
+     * @class Waiter
+     * @brief Awaitable that suspends until its socket is ready or its deadline passes.
+     *
+     * co_await yields true if the socket became ready (or, without a socket,
+     * the waiter was woken), false if the deadline passed first.
+     */
+    class Waiter {
+    public:
+        enum class Interest { None, Read, Write };
+
+        Waiter(Reactor& reactor, SocketHandle sock, Interest interest, Clock::time_point deadline)
+            : reactor_(reactor), sock_(sock), interest_(interest), deadline_(deadline) {}
+
+        bool await_ready() const { return interest_ == Interest::None && deadline_ <= Clock::now(); }
+        void await_suspend(std::coroutine_handle<> handle) { handle_ = handle; reactor_.add(*this); }
+        bool await_resume() const noexcept { return fired_; }
+
+    private:
+        friend class Reactor;
+
+        Reactor& reactor_;
+        SocketHandle sock_;
+        Interest interest_;
+        Clock::time_point deadline_;
+        std::coroutine_handle<> handle_;
+        uint64_t id_ = 0;
+        bool fired_ = false;
+    };
+
+    Reactor();
+
+    /** @brief Destroys unfinished tasks and closes the reactor's own descriptors. */
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /** @brief Takes ownership of a task; it starts on the next loop iteration. */
+    void spawn(Task<void> task);
+
+    /** @brief Runs until every task has finished or stop() is called. */
+    void run();
+
+    /** @brief Like run(), but also returns at the given time. */
+    void runUntil(Clock::time_point until);
+
+    /** @brief Makes run() return after the current iteration. Thread-safe. */
+    void stop();
+
+    /** @brief Runs a function on the reactor thread during its next iteration. Thread-safe. */
+    void post(std::function<void()> function);
+
+    /** @brief Tasks spawned and not yet finished. */
+    size_t tasks() const { return tasks_.size(); }
+
+    /** @brief Deadline helper: now + duration. */
+    static Clock::time_point after(Clock::duration duration) { return Clock::now() + duration; }
+
+    Waiter readable(SocketHandle sock, Clock::time_point deadline = NEVER) {
+        return Waiter(*this, sock, Waiter::Interest::Read, deadline);
+    }
+
+    Waiter writable(SocketHandle sock, Clock::time_point deadline = NEVER) {
+        return Waiter(*this, sock, Waiter::Interest::Write, deadline);
+    }
+
+    Waiter sleepUntil(Clock::time_point time) {
+        return Waiter(*this, SocketHandle{}, Waiter::Interest::None, time);
+    }
+
+    Waiter sleepFor(Clock::duration duration) { return sleepUntil(after(duration)); }
+
+private:
+    friend class ReactorEvent;
+
+    struct SocketWaiters {
+        Waiter* read = nullptr;
+        Waiter* write = nullptr;
+    };
+
+    using Timer = std::pair<Clock::time_point, uint64_t>;
+
+    void add(Waiter& waiter);
+
+    /** @brief Resumes a waiter with a result, if it is still waiting. */
+    void fire(Waiter& waiter, bool result);
+
+    /** @brief Waits for readiness up to the deadline and resumes whoever is ready. */
+    void poll(Clock::time_point until);
+
+    /** @brief Tells the OS which events the socket's waiters need. */
+    void arm(SocketHandle sock);
+
+    void handleSocket(SocketHandle sock, bool readable, bool writable);
+    void runPosted();
+    void wake();
+
+    std::vector<Task<void>> tasks_;
+    std::vector<std::coroutine_handle<>> ready_;
+    std::unordered_map<uint64_t, Waiter*> waiters_;
+    std::unordered_map<SocketHandle, SocketWaiters> sockets_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    uint64_t nextId_ = 1;
+
+    SocketHandle wakeSocket_;   // UDP socket connected to itself; a datagram wakes the loop
+    std::mutex postedMutex_;
+    std::vector<std::function<void()>> posted_;
+    std::atomic<bool> wakePending_{ false };
+    std::atomic<bool> stopping_{ false };
+#ifdef __linux__
+    int epoll_ = -1;
+#endif
+};
+
+/**
+ * @class ReactorEvent
+ * @brief Flag another thread raises to wake a coroutine waiting in a Reactor.
+ *
+ * set() may be called from any thread, any number of times; a waiting
+ * coroutine wakes once, and a set() with nobody waiting is remembered for
+ * the next wait(). One coroutine waits at a time.
+ */
+class ReactorEvent {
+public:
+    explicit ReactorEvent(Reactor& reactor) : reactor_(reactor) {}
+
+    ReactorEvent(const ReactorEvent&) = delete;
+    ReactorEvent& operator=(const ReactorEvent&) = delete;
+
+    /** @brief Raises the flag. Thread-safe. */
+    void set();
+
+    /**
+     * @brief Awaitable: true once the flag is raised (clearing it), false if the deadline passes first.
+     */
+    auto wait(Reactor::Clock::time_point deadline = Reactor::NEVER) {
+        struct Awaiter : Reactor::Waiter {
+            ReactorEvent& event;
+            Awaiter(ReactorEvent& e, Reactor::Clock::time_point deadline)
+                : Reactor::Waiter(e.reactor_, SocketHandle{}, Interest::None, deadline), event(e) {}
+            bool await_ready() { return event.pending_.exchange(false); }
+            void await_suspend(std::coroutine_handle<> handle) {
+                event.waiting_ = this;
+                Reactor::Waiter::await_suspend(handle);
+            }
+            bool await_resume() {
+                event.waiting_ = nullptr;
+                return Reactor::Waiter::await_resume() || event.pending_.exchange(false);
+            }
+        };
+        return Awaiter(*this, deadline);
+    }
+
+private:
+    Reactor& reactor_;
+    std::atomic<bool> pending_{ false };
+    Reactor::Waiter* waiting_ = nullptr;   // Reactor thread only
+};
+
+/**
+ * @brief Receives one datagram, waiting until one arrives or the deadline passes.
+ * @return Bytes received, or -1 on timeout or error
+ */
+Task<int> asyncRecvFrom(Reactor& reactor, SocketHandle sock, char* buffer, size_t capacity,
+    sockaddr_in& from, Reactor::Clock::time_point deadline = Reactor::NEVER);
+
+/**
+ * @brief Sends one datagram, waiting while the socket's send buffer is full.
+ * @return Bytes sent, or -1 on error
+ */
+Task<int> asyncSendTo(Reactor& reactor, SocketHandle sock, const char* data, size_t size, const sockaddr_in& to);
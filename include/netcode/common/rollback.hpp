@@ -0,0 +1,136 @@
+/**
+ * @file rollback.hpp
+ * @brief Whole-world rollback: per-tick state snapshots, input prediction and resimulation.
+ *
+ * RollbackWorld runs a deterministic fixed-step simulation of every player in
+ * a match (the server's movement rule through the SIMD kernel, then player
+ * collisions) from per-tick inputs. Inputs that have not arrived yet are
+ * predicted by repeating the player's previous input. When a confirmed input
+ * for a past tick differs from the one the world was simulated with, the
+ * world rolls back: it restores the snapshot taken at the start of that tick
+ * and resimulates every tick since, with all local and remote inputs known
+ * by then.
+ *
+ * The world state is one contiguous SoA block (x, y, vx, vy columns of
+ * players floats each), so a snapshot is a single memcpy into a ring of
+ * history blocks allocated up front. The ring bounds the rollback cost: a
+ * correction at most history ticks old is replayed; older ones are rejected
+ * and counted, and the caller must resynchronize from authoritative state.
+ *
+ * Tick numbering: tick() is the next tick to simulate, and the state is the
+ * world at its start. Snapshots exist for ticks tick() - history .. tick() - 1.
+ *
+ * Usage:
+ *   - RollbackWorld world({ players, history }); world.setPlayer(p, x, y) for each player
+ *   - Each frame: world.setInput(world.tick(), local, ix, iy); world.advance()
+ *   - When a remote input arrives: world.setInput(itsTick, player, ix, iy); the next
+ *     advance() (or rollback()) resimulates from the earliest mispredicted tick
+ *   - resimulateFrom(tick) replays explicitly, e.g. to measure cost at a given depth
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "collision.hpp"
+#include "movement_kernel.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class RollbackWorld
+ * @brief Fixed-step world of players with a snapshot ring for rollback and resimulation.
+ */
+class RollbackWorld {
+public:
+    struct Config {
+        size_t players;                                            ///< Number of players (fixed)
+        uint32_t history = 32;                                     ///< Ticks of snapshots kept: the deepest rollback
+        float tickSeconds = 1.0f / 60.0f;                          ///< Simulated time per tick
+        MovementParams movement{ 120.0f, 30.0f, 310.0f, 0.1f };    ///< Server movement rule (Room's constants)
+        bool collisions = true;                                    ///< Resolve player overlaps every tick
+        CollisionParams collision{ 10.0f, 30.0f, 310.0f };         ///< Player radius and bounds (Room's constants)
+    };
+
+    explicit RollbackWorld(const Config& config);
+
+    const Config& config() const { return config_; }
+
+    /** @brief Next tick to simulate; the state is the world at its start. */
+    uint32_t tick() const { return tick_; }
+
+    /** @brief Places a player (current state only; history is unchanged). */
+    void setPlayer(size_t player, float x, float y);
+
+    /** @brief State columns, players entries each. */
+    const float* x() const { return state_.data(); }
+    const float* y() const { return state_.data() + players_; }
+    const float* vx() const { return state_.data() + 2 * players_; }
+    const float* vy() const { return state_.data() + 3 * players_; }
+
+    /**
+     * @brief Records a player's confirmed input for a tick.
+     *
+     * Inputs for the current and later ticks (up to history ahead) are used when those ticks
+     * run. An input for a past tick that differs from the one used schedules a rollback to it.
+     *
+     * @return False if the tick is outside the window (more than history ticks old, or ahead)
+     */
+    bool setInput(uint32_t tick, size_t player, float inputX, float inputY);
+
+    /** @brief Resimulates pending corrections, then simulates one tick. */
+    void advance();
+
+    /**
+     * @brief Resimulates from the earliest tick with a mispredicted input, if any.
+     * @return Ticks resimulated (0 if nothing was mispredicted)
+     */
+    uint32_t rollback();
+
+    /**
+     * @brief Restores the snapshot taken at the start of a past tick and simulates back to tick().
+     * @return Ticks resimulated, or 0 if no snapshot exists for that tick
+     */
+    uint32_t resimulateFrom(uint32_t tick);
+
+    uint64_t rollbacks() const { return rollbacks_; }                ///< Rollbacks performed
+    uint64_t resimulatedTicks() const { return resimulated_; }       ///< Ticks simulated again in total
+    uint32_t deepestRollback() const { return deepest_; }            ///< Most ticks resimulated at once
+    uint64_t lateInputs() const { return late_; }                    ///< Inputs too old to roll back to
+
+    /** @brief Time taken by the last rollback (restore plus resimulation). */
+    std::chrono::nanoseconds lastRollbackTime() const { return lastRollbackTime_; }
+
+private:
+    /** @brief Input of one player for one tick: confirmed, or predicted when the tick ran. */
+    struct InputSlot {
+        uint32_t tick = UINT32_MAX;   // Tick this slot holds (slots are reused around the ring)
+        float x = 0.0f;
+        float y = 0.0f;
+        bool confirmed = false;
+    };
+
+    InputSlot& inputAt(uint32_t tick, size_t player);
+    void simulate(uint32_t tick);
+
+    Config config_;
+    size_t players_;
+    uint32_t tick_ = 0;
+    std::vector<float> state_;        // x | y | vx | vy, players_ each
+    std::vector<float> snapshots_;    // history blocks of state_, by tick % history
+    std::vector<InputSlot> inputs_;   // inputRing_ ticks of players_ slots, by tick % inputRing_
+    uint32_t inputRing_;
+    std::vector<float> inputX_;       // Per-tick kernel input, gathered from inputs_
+    std::vector<float> inputY_;
+    std::vector<float> dt_;
+    CollisionGrid grid_;
+    uint32_t pending_ = UINT32_MAX;   // Earliest mispredicted tick
+    uint64_t rollbacks_ = 0;
+    uint64_t resimulated_ = 0;
+    uint32_t deepest_ = 0;
+    uint64_t late_ = 0;
+    std::chrono::nanoseconds lastRollbackTime_{ 0 };
+};
@@ -0,0 +1,399 @@
+/**
+ * @file room.hpp
+ * @brief Rooms (independent matches) and the router that assigns clients to them.
+ *
+ * A Room owns the authoritative state of its clients and simulates it on
+ * every server tick. Rooms share nothing with each other, so a tick over many
+ * rooms can run in parallel on a RoomScheduler. Each client is an entity in
+ * the room's EntityStore: position, velocity and sequence live in dense SoA
+ * columns, and the remaining per-client data in parallel columns by slot.
+ *
+ * Usage:
+ *   - The network thread calls RoomRouter::route() for every valid datagram;
+ *     the first datagram from an address is the handshake that places the
+ *     client in a room with free capacity.
+ *   - It then queues the input with Room::pushInput().
+ *   - Once per tick each room runs Room::tick(), which applies the queued
+ *     inputs in arrival order and emits one authoritative snapshot per client
+ *     that sent input. Given a JobSystem, large rooms split the per-client
+ *     integration, clamping and snapshot building across workers.
+ *     Integration runs through the SIMD kernel in movement_kernel.hpp, one
+ *     input per client per pass, so clients with a burst of inputs take
+ *     several passes while the rest are done in the first.
+ *
+ * Clients that only send input when it changes (input_encoder.hpp) rely on
+ * Room::holdInputs(): called before a tick, it keeps moving every client
+ * that sent nothing since the last tick with the input it last sent, so the
+ * client keeps getting snapshots while it moves. Each snapshot says how long
+ * the last input has been held (SnapshotAck::heldMicros), which tells the
+ * client how much of its own prediction since sending it the state covers.
+ *
+ * With collisions enabled, players are circles of PLAYER_RADIUS that push each
+ * other apart after movement (see collision.hpp); otherwise they only stay
+ * inside the bounds and pass through each other.
+ *
+ * In dead-reckoning mode a room mirrors each client's extrapolator
+ * (predictPosition() on the last snapshot it was sent) and answers input only
+ * when the extrapolated position is off by more than a threshold, or when a
+ * heartbeat interval has passed since the last snapshot.
+ *
+ * Under overload (see load_governor.hpp) the router applies LoadShedding to
+ * every room: idle clients are answered less often, a client's queued inputs
+ * are merged into one, and new clients are refused.
+ *
+ * Rooms are not internally synchronized: queueing input and ticking must not
+ * overlap (the server alternates between receiving and running a tick).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "collision.hpp"
+#include "entity_store.hpp"
+#include "packet.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#endif
+
+class JobSystem;
+
+/** @brief Identifies a client by its IPv4 address and UDP port. */
+using ClientId = uint64_t;
+
+/**
+ * @brief Builds the ClientId for a sender address (address << 16 | port, host byte order).
+ */
+inline ClientId makeClientId(const sockaddr_in& addr) {
+    return (static_cast<ClientId>(ntohl(addr.sin_addr.s_addr)) << 16) | ntohs(addr.sin_port);
+}
+
+/**
+ * @struct RoomOutput
+ * @brief An authoritative snapshot produced by a tick, addressed to one client.
+ */
+struct RoomOutput {
+    sockaddr_in addr;
+    Packet packet;
+    SnapshotAck ack;    ///< Sent with the packet (Packet::serializeSnapshot())
+};
+
+/**
+ * @struct LoadShedding
+ * @brief Work a room may skip while the server is overloaded. The defaults skip nothing.
+ */
+struct LoadShedding {
+    uint32_t idleResponseInterval = 1;   ///< Answer a non-moving client on every Nth tick it sends input (1: always)
+    bool coalesceInputs = false;         ///< Queue only the newest of a client's inputs per tick, applied over their whole time span
+    bool admitNewClients = true;         ///< RoomRouter: place clients seen for the first time
+
+    bool operator==(const LoadShedding& other) const {
+        return idleResponseInterval == other.idleResponseInterval && coalesceInputs == other.coalesceInputs &&
+            admitNewClients == other.admitNewClients;
+    }
+};
+
+/**
+ * @struct DeadReckoning
+ * @brief When a room sends snapshots in dead-reckoning mode. Disabled by default.
+ */
+struct DeadReckoning {
+    bool enabled = false;
+    float threshold = 2.0f;                                  ///< Largest tolerated extrapolation error (world units)
+    std::chrono::milliseconds heartbeat{ 200 };              ///< Longest time between snapshots to a client that sends input
+
+    bool operator==(const DeadReckoning& other) const {
+        return enabled == other.enabled && threshold == other.threshold && heartbeat == other.heartbeat;
+    }
+};
+
+/**
+ * @class Room
+ * @brief One independent match: its clients, their queued input and the simulation rules.
+ */
+class Room {
+public:
+    static constexpr float MOVE_SPEED = 120.0f;
+    static constexpr float BOUNDS_MIN = 30.0f;
+    static constexpr float BOUNDS_MAX = 310.0f;
+    static constexpr float MAX_STEP = 0.1f;  ///< Largest dt applied per input (seconds)
+    static constexpr float SPAWN_X = 200.0f;
+    static constexpr float SPAWN_Y = 300.0f;
+    static constexpr float PLAYER_RADIUS = 10.0f;  ///< Collision radius, matches the client's dots
+    static constexpr size_t PARALLEL_GRAIN = 256;  ///< Clients per job when a tick is split
+    static constexpr size_t MAX_LOADED_CAPACITY = 4096;  ///< Largest room capacity load() accepts
+
+    /**
+     * @param id       Room identifier (also used for worker affinity)
+     * @param capacity Maximum number of clients
+     */
+    Room(uint32_t id, size_t capacity);
+
+    /**
+     * @brief Adds a client; no-op if it is already a member.
+     * @return False if the room is full
+     */
+    bool join(ClientId client, const sockaddr_in& addr, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Removes a client and discards its queued input.
+     * @return False if the client was not a member
+     */
+    bool leave(ClientId client);
+
+    /**
+     * @brief Queues an input command for the next tick. Input from non-members is ignored.
+     * @param client  Sender
+     * @param seq     Input sequence number
+     * @param inputX  Horizontal input (clamped to [-1, 1] when applied)
+     * @param inputY  Vertical input (clamped to [-1, 1] when applied)
+     * @param arrival Receive time, used as the simulation time of the input
+     */
+    void pushInput(ClientId client, uint32_t seq, float inputX, float inputY,
+        std::chrono::steady_clock::time_point arrival);
+
+    /**
+     * @brief Holds each client's last input up to now, for clients that sent nothing since the last tick.
+     *
+     * A moving client gets its last input queued again at now (same sequence number), so the
+     * next tick moves it for the time since its previous update and sends it a snapshot. A
+     * client that is not moving is not queued; only its update time advances, so its next
+     * input moves it for the time since this call rather than since its last packet.
+     * The held input is read back from the velocity, which is the clamped input times MOVE_SPEED.
+     *
+     * @return Number of inputs queued
+     */
+    size_t holdInputs(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Applies all queued input and collects one snapshot per client that sent input.
+     *
+     * Each input newer than the client's last one, and each input queued by holdInputs(), moves
+     * the client for the time since its previous update (at most MAX_STEP). The snapshot echoes the newest applied sequence number.
+     * With collisions enabled, overlapping players are then pushed apart (every player, not
+     * only those that sent input). In dead-reckoning mode a snapshot is only emitted when the
+     * client's extrapolation from its last one has drifted past the threshold, or the
+     * heartbeat is due (simulation time, from input arrival times). With load shedding, coalesced inputs move the client once, and a client that is not
+     * moving gets a snapshot when it stops and then only every idleResponseInterval ticks.
+     * Every emitted snapshot takes the client's next snapshot sequence number, so the client
+     * counts gaps in it as loss and never the snapshots skipped here, and reports how long the
+     * echoed input has been held since it was applied.
+     *
+     * @param[out] out Snapshots are appended here (in client order)
+     * @param jobs     Optional job system; clients are simulated in parallel chunks of PARALLEL_GRAIN
+     * @return Number of inputs applied
+     */
+    size_t tick(std::vector<RoomOutput>& out, JobSystem* jobs = nullptr);
+
+    /**
+     * @brief Removes clients that have not sent anything since a cutoff.
+     * @return Removed client ids
+     */
+    std::vector<ClientId> evictIdle(std::chrono::steady_clock::time_point cutoff);
+
+    /**
+     * @brief Appends the room's clients, their state and queued input to a byte buffer.
+     *
+     * The format is host byte order and stores steady_clock readings as-is, so it is only
+     * meant for another process on the same machine (hot restart), not for the network.
+     */
+    void save(std::vector<char>& out) const;
+
+    /**
+     * @brief Reads a room written by save().
+     * @param[in,out] cursor Start of the room; advanced past it on success
+     * @param end            End of the buffer
+     * @param shift          Added to every stored time (rebases state saved before a crash)
+     * @return The room, or nullptr if the data is truncated or inconsistent. Stored counts are
+     *         checked against MAX_LOADED_CAPACITY and the bytes left before anything is allocated
+     */
+    static std::unique_ptr<Room> load(const char*& cursor, const char* end,
+        std::chrono::steady_clock::duration shift = std::chrono::steady_clock::duration::zero());
+
+    /**
+     * @brief Current dense slot of a client, or EntityStore::NPOS if it is not a member.
+     */
+    size_t slotOf(ClientId client) const;
+
+    /** @brief Client in a dense slot (slot < size()). */
+    ClientId clientAt(size_t slot) const { return clientIds_[slot]; }
+
+    /** @brief Authoritative state columns (x, y, vx, vy, seq), indexed by slot. */
+    const EntityStore& entities() const { return entities_; }
+
+    /** @brief Turns player collisions on or off for the following ticks. */
+    void setCollisions(bool enabled) { collisions_ = enabled; }
+    bool collisions() const { return collisions_; }
+
+    /** @brief Overlapping player pairs found by collision passes (since creation). */
+    uint64_t contacts() const { return contacts_; }
+
+    /** @brief Sets the dead-reckoning mode for the following ticks. */
+    void setDeadReckoning(const DeadReckoning& mode) { deadReckoning_ = mode; }
+    const DeadReckoning& deadReckoning() const { return deadReckoning_; }
+
+    /** @brief Snapshots not sent because the client's extrapolation was close enough (since creation). */
+    uint64_t deadReckonedSnapshots() const { return deadReckoned_; }
+
+    /** @brief Sets what the following ticks may skip. */
+    void setShedding(const LoadShedding& shedding) { shedding_ = shedding; }
+    const LoadShedding& shedding() const { return shedding_; }
+
+    /** @brief Snapshots not sent to idle clients because of load shedding (since creation). */
+    uint64_t suppressedSnapshots() const { return suppressedSnapshots_; }
+
+    /** @brief Queued inputs replaced by a newer one because of load shedding (since creation). */
+    uint64_t coalescedInputs() const { return coalescedInputs_; }
+
+    /** @brief Inputs queued again by holdInputs() (since creation). */
+    uint64_t heldInputs() const { return heldInputs_; }
+
+    uint32_t id() const { return id_; }
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return entities_.size(); }
+    bool full() const { return entities_.size() >= capacity_; }
+    bool empty() const { return entities_.empty(); }
+
+private:
+    struct QueuedInput {
+        size_t slot;
+        uint32_t seq;
+        float inputX, inputY;
+        std::chrono::steady_clock::time_point arrival;
+        bool held = false;                            // Queued by holdInputs(): repeats the last sequence number
+    };
+
+    size_t acceptInputs(size_t slot);
+    bool extrapolationDrifted(size_t slot) const;
+    void integrate(size_t begin, size_t end, size_t rounds);
+    void removeSlot(size_t slot);
+
+    uint32_t id_;
+    size_t capacity_;
+    EntityStore entities_;                            // Hot state: x, y, vx, vy, last seq
+    std::unordered_map<ClientId, EntityId> index_;    // Network address -> entity (ids survive slot moves)
+
+    // Cold per-client columns, indexed by the same dense slot as entities_
+    std::vector<ClientId> clientIds_;
+    std::vector<sockaddr_in> addrs_;
+    std::vector<std::chrono::steady_clock::time_point> lastUpdate_;  // Arrival time of the last applied input
+    std::vector<std::chrono::steady_clock::time_point> lastSeen_;    // Arrival time of the last datagram
+    std::vector<uint8_t> pending_;                    // Sent input since the last tick
+    std::vector<uint32_t> quietTicks_;                // Ticks answered or skipped while not moving (load shedding)
+    std::vector<uint32_t> queued_;                    // 1 + inbox_ index of the newest queued input, 0 if none
+    std::vector<Packet> lastSent_;                    // Dead reckoning: the client's last snapshot
+    std::vector<std::chrono::steady_clock::time_point> sentAt_;      // Its simulation time (min: none sent yet)
+    std::vector<uint32_t> snapshotSeq_;               // Snapshots emitted to the client (SnapshotAck::snapshotSeq)
+    std::vector<std::chrono::steady_clock::time_point> heldSince_;   // Update time of the last input it sent (held from here)
+
+    std::vector<QueuedInput> inbox_;
+
+    bool collisions_ = false;
+    CollisionGrid collisionGrid_;
+    uint64_t contacts_ = 0;
+
+    DeadReckoning deadReckoning_;
+    uint64_t deadReckoned_ = 0;
+
+    LoadShedding shedding_;
+    uint64_t suppressedSnapshots_ = 0;
+    uint64_t coalescedInputs_ = 0;
+    uint64_t heldInputs_ = 0;
+
+    // Per-tick scratch, reused across ticks
+    // inbox_ grouped by client (arrival order kept) as SoA columns, so the movement kernel
+    // reads input in place when every client sent exactly one
+    std::vector<uint32_t> inputSeq_;
+    std::vector<uint8_t> inputHeld_;
+    std::vector<float> inputX_, inputY_;
+    std::vector<std::chrono::steady_clock::time_point> inputArrival_;
+    std::vector<float> inputDt_;                      // Seconds since the client's previous applied input
+    std::vector<size_t> inputStart_;                  // Client slot -> first index in the input columns
+    std::vector<uint32_t> accepted_;                  // Client slot -> fresh inputs at the front of its range
+    std::vector<Packet> snapshots_;                   // Client slot -> snapshot built this tick
+};
+
+/**
+ * @class RoomRouter
+ * @brief Owns the rooms and assigns each client to one at handshake.
+ *
+ * New clients fill the lowest-numbered room with free capacity; a new room is
+ * opened when all are full, up to maxRooms.
+ */
+class RoomRouter {
+public:
+    /**
+     * @param roomCapacity Clients per room
+     * @param maxRooms     Upper bound on open rooms
+     */
+    RoomRouter(size_t roomCapacity, size_t maxRooms);
+
+    /**
+     * @brief Returns the client's room, placing it in one on first contact.
+     * @return Room, or nullptr if every room is full or new clients are being shed
+     */
+    Room* route(ClientId client, const sockaddr_in& addr, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Returns the client's room without placing it.
+     */
+    Room* find(ClientId client) const;
+
+    /**
+     * @brief Removes clients idle since the cutoff from every room.
+     * @return Number of clients removed
+     */
+    size_t evictIdle(std::chrono::steady_clock::time_point cutoff);
+
+    /**
+     * @brief Appends every room (see Room::save()) to a byte buffer.
+     */
+    void save(std::vector<char>& out) const;
+
+    /**
+     * @brief Replaces all rooms and assignments with those written by save().
+     * @param shift Added to every stored time (see Room::load())
+     * @return False if the data is invalid (the router is left empty)
+     */
+    bool load(const char* data, size_t size,
+        std::chrono::steady_clock::duration shift = std::chrono::steady_clock::duration::zero());
+
+    /**
+     * @brief All open rooms (some may be empty after evictions and are reused first).
+     */
+    const std::vector<std::unique_ptr<Room>>& rooms() const { return rooms_; }
+
+    /** @brief Turns player collisions on or off in every room, and in rooms opened later. */
+    void setCollisions(bool enabled);
+
+    /** @brief Sets the dead-reckoning mode of every room, and of rooms opened later. */
+    void setDeadReckoning(const DeadReckoning& mode);
+
+    /** @brief Applies load shedding to every room, and to rooms opened later. */
+    void setShedding(const LoadShedding& shedding);
+    const LoadShedding& shedding() const { return shedding_; }
+
+    /** @brief Datagrams from new clients turned away while admitNewClients was off. */
+    uint64_t refusedClients() const { return refused_; }
+
+    size_t clientCount() const { return assignment_.size(); }
+    size_t roomCapacity() const { return roomCapacity_; }
+
+private:
+    size_t roomCapacity_;
+    size_t maxRooms_;
+    std::vector<std::unique_ptr<Room>> rooms_;
+    std::unordered_map<ClientId, Room*> assignment_;
+    bool collisions_ = false;
+    DeadReckoning deadReckoning_;
+    LoadShedding shedding_;
+    uint64_t refused_ = 0;
+};
@@ -0,0 +1,71 @@
+/**
+ * @file room_scheduler.hpp
+ * @brief Ticks rooms in parallel on the job system with per-room worker affinity.
+ *
+ * Every room has a home worker (room id modulo worker count), so across ticks
+ * a room is normally simulated by the same thread and its state stays warm in
+ * that core's cache. When the load is uneven, idle workers steal queued rooms
+ * from busier ones (see JobSystem).
+ *
+ * Usage:
+ *   - Create one scheduler for the lifetime of the server.
+ *   - Once per tick call run(rooms, work); it returns when work has been
+ *     called exactly once for every room.
+ *   - Work may itself use jobs().parallelFor() to split a large room.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "job_system.hpp"
+#include "room.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @class RoomScheduler
+ * @brief Runs one unit of work per room on a fixed pool of worker threads.
+ */
+class RoomScheduler {
+public:
+    /** @brief Work for one room; receives the room and the index of the worker running it. */
+    using Work = std::function<void(Room&, size_t worker)>;
+
+    /**
+     * @param workers Number of worker threads (at least 1)
+     * @param onStart Optional hook run first on every worker thread (see JobSystem)
+     */
+    explicit RoomScheduler(size_t workers, JobSystem::WorkerStart onStart = {})
+        : jobs_(workers, std::move(onStart)) {}
+
+    /**
+     * @brief Runs work once for every room and blocks until all are done.
+     * @param rooms Rooms to process (must stay alive until run() returns)
+     * @param work  Work per room; called concurrently for different rooms
+     */
+    void run(const std::vector<Room*>& rooms, const Work& work) {
+        jobs_.parallelForEach(rooms.size(),
+            [&](size_t i) { return rooms[i]->id(); },
+            [&](size_t i) { work(*rooms[i], jobs_.currentWorker()); });
+    }
+
+    /**
+     * @brief Home worker of a room.
+     */
+    size_t homeWorker(const Room& room) const { return room.id() % jobs_.workerCount(); }
+
+    size_t workerCount() const { return jobs_.workerCount(); }
+
+    /** @brief Jobs (rooms or room chunks) run by a worker other than the one they were queued on. */
+    uint64_t steals() const { return jobs_.steals(); }
+
+    /** @brief The underlying job system, for parallel loops inside a room. */
+    JobSystem& jobs() { return jobs_; }
+
+private:
+    JobSystem jobs_;
+};
@@ -0,0 +1,110 @@
+/**
+ * @file snapshot_codec.hpp
+ * @brief Range-coded snapshot compression with a static, offline-trained model.
+ *
+ * Server snapshots are highly predictable: the sequence number advances by
+ * one, velocities are mostly zero or unchanged, and positions move a few
+ * units per update. The codec first maps a snapshot to 20 residual bytes
+ * relative to a baseline snapshot (zigzag deltas of the sequence number and
+ * of each float's bit pattern), then range-codes those bytes with one
+ * static frequency table per byte position.
+ *
+ * The frequency tables are trained offline with SnapshotModelTrainer and
+ * compiled in as a constexpr table (src/common/snapshot_model.inl), so the
+ * coder needs no adaptation state and every packet decodes independently
+ * given its baseline.
+ *
+ * Usage:
+ *   - Sender: encodeSnapshot(snapshot, baseline, out, sizeof(out)).
+ *   - Receiver: decodeSnapshot(in, len, baseline, snapshot) with the same baseline.
+ *   - The baseline must be a snapshot both sides hold (e.g. the last one the
+ *     receiver acknowledged); Packet() is a valid, stateless baseline.
+ *   - Encoded output never exceeds Packet::size(): if range coding would not
+ *     save space, the raw packet is emitted instead (length == Packet::size()).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "packet.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** @brief Number of residual symbols (bytes) per snapshot. */
+constexpr size_t SNAPSHOT_SYMBOLS = Packet::size();
+
+/** @brief log2 of the total frequency of every model context. */
+constexpr uint32_t SNAPSHOT_MODEL_BITS = 12;
+
+/** @brief Per-position symbol frequencies; each row sums to 1 << SNAPSHOT_MODEL_BITS. */
+using SnapshotFrequencyTable = std::array<std::array<uint16_t, 256>, SNAPSHOT_SYMBOLS>;
+
+/**
+ * @brief Maps a snapshot to its residual bytes relative to a baseline.
+ * @param snapshot   Snapshot to encode
+ * @param baseline   Reference snapshot known to both sides
+ * @param[out] symbols Residual bytes (SNAPSHOT_SYMBOLS entries)
+ */
+void snapshotToSymbols(const Packet& snapshot, const Packet& baseline, uint8_t* symbols);
+
+/**
+ * @brief Inverse of snapshotToSymbols().
+ * @param symbols  Residual bytes (SNAPSHOT_SYMBOLS entries)
+ * @param baseline Reference snapshot used when encoding
+ * @return Reconstructed snapshot (bit-exact)
+ */
+Packet snapshotFromSymbols(const uint8_t* symbols, const Packet& baseline);
+
+/**
+ * @brief Compresses a snapshot against a baseline.
+ * @param snapshot Snapshot to encode
+ * @param baseline Reference snapshot known to the receiver
+ * @param[out] out Output buffer
+ * @param capacity Output buffer size (Packet::size() is always sufficient)
+ * @return Encoded length in bytes (Packet::size() means stored raw), or 0 if capacity is too small
+ */
+size_t encodeSnapshot(const Packet& snapshot, const Packet& baseline, char* out, size_t capacity);
+
+/**
+ * @brief Decompresses a snapshot produced by encodeSnapshot().
+ * @param in       Encoded bytes
+ * @param length   Encoded length
+ * @param baseline The baseline used by the sender
+ * @param[out] snapshot Decoded snapshot
+ * @return False if the input is malformed
+ */
+bool decodeSnapshot(const char* in, size_t length, const Packet& baseline, Packet& snapshot);
+
+/**
+ * @class SnapshotModelTrainer
+ * @brief Builds the static frequency tables from recorded snapshot pairs.
+ *
+ * Feed it (snapshot, baseline) pairs from a capture, then paste the output of
+ * toSource() into src/common/snapshot_model.inl and rebuild.
+ */
+class SnapshotModelTrainer {
+    std::array<std::array<uint64_t, 256>, SNAPSHOT_SYMBOLS> counts_{};
+    uint64_t samples_ = 0;
+
+public:
+    /**
+     * @brief Records the residual bytes of one snapshot.
+     */
+    void observe(const Packet& snapshot, const Packet& baseline);
+
+    /**
+     * @brief Scales the observed counts to the model precision (every symbol keeps frequency >= 1).
+     */
+    SnapshotFrequencyTable frequencies() const;
+
+    /**
+     * @brief Emits the trained table as C++ source for snapshot_model.inl.
+     */
+    std::string toSource() const;
+
+    uint64_t samples() const { return samples_; }
+};
@@ -0,0 +1,99 @@
+/**
+ * @file spsc_ring.hpp
+ * @brief Bounded lock-free single-producer, single-consumer ring.
+ *
+ * One thread pushes, another pops; neither ever blocks or takes a lock.
+ * Head and tail live on separate cache lines, and each side keeps a cached
+ * copy of the other side's index so it reads the shared one only when the
+ * ring looks full (producer) or empty (consumer).
+ *
+ * Usage:
+ *   - Only the producer calls push(); only the consumer calls pop().
+ *   - The capacity is fixed: push() returns false when the ring is full.
+ *   - Elements are copied, so keep them small (pointers or indices).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @class SpscRing
+ * @brief Fixed-capacity FIFO between exactly one producer and one consumer thread.
+ * @tparam T Trivially copyable element type
+ */
+template<typename T>
+class SpscRing {
+public:
+    /**
+     * @param capacity Maximum number of queued items (rounded up to a power of two)
+     */
+    explicit SpscRing(size_t capacity = 1024) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        mask_ = rounded - 1;
+        items_ = std::make_unique<T[]>(rounded);
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Appends an item. Producer only.
+     * @return False if the ring is full
+     */
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) {
+                return false;
+            }
+        }
+        items_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Takes the oldest item. Consumer only.
+     * @return False if the ring is empty
+     */
+    bool pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;
+            }
+        }
+        item = items_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Whether the ring is empty; exact on the consumer, a snapshot elsewhere. */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /** @brief Items queued (a snapshot when called concurrently). */
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<T[]> items_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{ 0 };   // Next item to pop (written by the consumer)
+    size_t cachedTail_ = 0;                       // Consumer's copy of tail_
+    alignas(64) std::atomic<size_t> tail_{ 0 };   // Next slot to fill (written by the producer)
+    size_t cachedHead_ = 0;                       // Producer's copy of head_
+};
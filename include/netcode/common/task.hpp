@@ -0,0 +1,122 @@
+/**
+ * @file task.hpp
+ * @brief Task<T>: a lazily started C++20 coroutine that returns a T to whoever awaits it.
+ *
+ * A function returning Task<T> is a coroutine. It does not run until it is
+ * awaited (or spawned on a Reactor); the awaiting coroutine is suspended and
+ * resumed directly when the task finishes (symmetric transfer, so long
+ * chains of awaits use no stack). Suspensions inside the task, such as
+ * waiting for a socket in reactor.hpp, suspend the whole chain without
+ * blocking the thread.
+ *
+ * Usage:
+ *   - Task<int> answer() { co_return 42; }
+ *   - Task<void> caller() { int x = co_await answer(); ... }
+ *   - The top-level task is handed to Reactor::spawn(), which runs it.
+ *
+ * Tasks are move-only and destroy their coroutine frame when destroyed. An
+ * exception escaping a task terminates the program (the code base does not
+ * use exceptions for control flow).
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+class Reactor;
+
+/** @brief Result slot of a Task's promise. */
+template<typename T>
+struct TaskResult {
+    std::optional<T> value;
+    void return_value(T result) { value = std::move(result); }
+    T take() { return std::move(*value); }
+};
+
+/** @brief Task<void> has no result value. */
+template<>
+struct TaskResult<void> {
+    void return_void() const noexcept {}
+    void take() const noexcept {}
+};
+
+/**
+ * @class Task
+ * @brief Owning handle to a lazily started coroutine producing a T.
+ * @tparam T Result type (void for none)
+ */
+template<typename T = void>
+class [[nodiscard]] Task {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /** @brief Resumes whoever awaited the task once it finishes. */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle finished) noexcept {
+            const std::coroutine_handle<> next = finished.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type : TaskResult<T> {
+        std::coroutine_handle<> continuation;
+
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    Task() = default;
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    /** @brief True once the coroutine has run to completion. */
+    bool done() const { return !handle_ || handle_.done(); }
+
+    /** @brief Starts the task and suspends the awaiting coroutine until it finishes. */
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            Handle handle;
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{ handle_ };
+    }
+
+private:
+    friend class Reactor;
+
+    explicit Task(Handle handle) : handle_(handle) {}
+
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    Handle handle_;
+};
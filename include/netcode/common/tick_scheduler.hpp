@@ -0,0 +1,122 @@
+/**
+ * @file tick_scheduler.hpp
+ * @brief Fixed-rate tick clock: absolute deadlines, hybrid sleep/spin waiting and overrun policies.
+ *
+ * Ticks are due on a fixed grid of absolute deadlines (first + n * interval),
+ * so small delays never accumulate into drift. Waiting for a deadline has two
+ * phases:
+ * - Sleep until spinWindow before it, with clock_nanosleep(TIMER_ABSTIME) on
+ *   Linux (std::this_thread::sleep_until elsewhere). The kernel may wake the
+ *   thread tens of microseconds late; the spin window absorbs that.
+ * - Spin (yielding, so other threads on the core still run) until it is due.
+ *
+ * A tick that takes longer than the interval is an overrun. When a tick ends
+ * after the next deadline, what happens to the deadlines it missed is the
+ * catch-up policy:
+ * - Skip: the most recent one runs at once and the earlier ones are dropped;
+ *   the grid keeps its phase.
+ * - Compress: they run back to back, without waiting, up to maxCompressed in a
+ *   row, so the tick count keeps pace with the clock; any beyond are dropped.
+ * - RunLate: the next tick runs at once and the grid moves to start from it.
+ *
+ * Tick start jitter (how late each waited-for tick began) and overruns (how
+ * much longer than the interval a tick took) are recorded in JitterStats and
+ * reported as histograms.
+ *
+ * Usage:
+ *   - TickScheduler clock({ interval, TickScheduler::CatchUp::Skip });
+ *   - Dedicated loop: clock.waitForTick(); clock.beginTick(now); ...; clock.endTick(now)
+ *   - Loop with other work: sleep on your own wait until spinStart(), then poll
+ *     until due(now), and call beginTick/endTick around the tick
+ *   - report() every few seconds, then resetStats()
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include "netcode/common/latency_profile.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class TickScheduler
+ * @brief Schedules fixed-rate ticks on an absolute grid and measures how well it keeps it.
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief What happens to deadlines missed by an overrunning tick. */
+    enum class CatchUp { Skip, Compress, RunLate };
+
+    struct Config {
+        Clock::duration interval;                                     ///< Time between ticks
+        CatchUp policy = CatchUp::Skip;
+        Clock::duration spinWindow = std::chrono::microseconds(200);  ///< Spin this long before each deadline (0: sleep only)
+        uint32_t maxCompressed = 4;                                   ///< Compress: most back-to-back catch-up ticks
+    };
+
+    /** @param first First deadline (default: one interval from now) */
+    explicit TickScheduler(const Config& config, Clock::time_point first = Clock::time_point::min());
+
+    const Config& config() const { return config_; }
+
+    /** @brief Deadline of the next tick. */
+    Clock::time_point nextTick() const { return next_; }
+
+    /** @brief Moves the grid to start at a new deadline (e.g. one handed over by a previous process). */
+    void setNextTick(Clock::time_point next) { next_ = next; }
+
+    /** @brief When waiting should switch from sleeping to spinning. */
+    Clock::time_point spinStart() const { return next_ - config_.spinWindow; }
+
+    bool due(Clock::time_point now) const { return now >= next_; }
+
+    /** @brief Sleeps, then spins, until the next tick is due. */
+    void waitForTick() const;
+
+    /** @brief Marks the start of a due tick; records its start jitter. */
+    void beginTick(Clock::time_point now);
+
+    /** @brief Marks the end of the tick; records any overrun and schedules the next one. */
+    void endTick(Clock::time_point now);
+
+    /** @brief Lateness of each tick start (ticks started at once after an overrun excluded). */
+    const JitterStats& startJitter() const { return startJitter_; }
+
+    /** @brief How much longer than the interval each overrunning tick took. */
+    const JitterStats& overruns() const { return overruns_; }
+
+    uint64_t ticks() const { return ticks_; }
+    uint64_t skipped() const { return skipped_; }       ///< Deadlines dropped (Skip, or Compress beyond maxCompressed in a row)
+    uint64_t compressed() const { return compressed_; } ///< Catch-up ticks run back to back (Compress)
+
+    /**
+     * @brief Two-line summary with start jitter and overrun histograms.
+     *
+     * Buckets: <10 us, <50 us, <100 us, <500 us, <1 ms, <5 ms, >=5 ms.
+     */
+    std::string report() const;
+
+    /** @brief Clears the statistics (counters and histograms), keeping the schedule. */
+    void resetStats();
+
+    /** @brief Sleeps until an absolute time with the most precise sleep available (no spinning). */
+    static void sleepUntil(Clock::time_point deadline);
+
+private:
+    Config config_;
+    Clock::time_point next_;
+    Clock::time_point deadline_;    // Deadline of the running tick
+    Clock::time_point began_;       // When the running tick actually began
+    uint32_t catchUpRun_ = 0;       // Compress: catch-up ticks scheduled in a row
+    bool late_ = false;             // The next tick starts at once because of an overrun
+    uint64_t ticks_ = 0;
+    uint64_t skipped_ = 0;
+    uint64_t compressed_ = 0;
+    JitterStats startJitter_;
+    JitterStats overruns_;
+};
@@ -0,0 +1,196 @@
+/**
+ * @file transport.hpp
+ * @brief Batched UDP datagram I/O for the server, with interchangeable backends.
+ *
+ * The server receives and sends through a DatagramTransport instead of
+ * calling recvfrom/sendto per datagram. Backends:
+ * - SocketTransport: recvmmsg/sendmmsg batches on Linux, recvfrom/sendto
+ *   elsewhere. Always available. On Linux it also uses UDP segmentation
+ *   offload: consecutive same-size datagrams to one destination leave as a
+ *   single UDP_SEGMENT (GSO) send, and with UDP_GRO the kernel may deliver
+ *   several datagrams from one sender as one buffer, which receive() splits.
+ * - IoUringTransport (io_uring_transport.hpp, Linux): multishot recvmsg into
+ *   a kernel-provided buffer ring, batched sendmsg submissions.
+ *
+ * Usage:
+ *   - auto transport = makeTransport(sock, TransportKind::IoUring); falls
+ *     back to SocketTransport when io_uring is unavailable.
+ *   - receive(batch, timeout) waits for datagrams and returns every one that
+ *     is ready; their data stays valid until the next receive().
+ *   - send() queues a datagram; flush() hands all queued datagrams to the
+ *     kernel at once.
+ *
+ * On Linux both backends turn on SO_TIMESTAMPNS and SO_RXQ_OVFL: each
+ * datagram carries the time the kernel received it (so the caller can see
+ * how long it queued in the socket), and stats().kernelDrops counts
+ * datagrams the kernel dropped because the receive buffer was full. The drop
+ * count is updated by the next datagram that gets through.
+ *
+ * A transport is used from one thread. One that only sends (receive = false)
+ * takes nothing off the socket and leaves its receive options alone, so a
+ * send thread can share the socket with the thread that receives.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#ifdef _WIN32
+using SocketHandle = uintptr_t;
+#else
+using SocketHandle = int;
+#endif
+
+/**
+ * @struct ReceivedDatagram
+ * @brief One received datagram. data points into the transport's buffers.
+ */
+struct ReceivedDatagram {
+    sockaddr_in addr;
+    const char* data;
+    size_t size;        ///< Bytes available at data
+    bool truncated;     ///< The datagram was larger than the receive buffer
+    int64_t kernelTime = 0;  ///< When the kernel received it, ns since the epoch (system clock); 0 if unknown
+};
+
+/**
+ * @struct TransportStats
+ * @brief Counters for comparing backends.
+ */
+struct TransportStats {
+    uint64_t received = 0;
+    uint64_t sent = 0;
+    uint64_t sendErrors = 0;
+    uint64_t syscalls = 0;   ///< Kernel entries made for I/O (receive waits included)
+    uint64_t gsoSegments = 0;   ///< Datagrams sent as part of a multi-segment (GSO) send
+    uint64_t groSegments = 0;   ///< Datagrams received as part of a coalesced (GRO) buffer
+    uint64_t kernelDrops = 0;   ///< Datagrams dropped by the kernel (receive buffer full) since the transport was created
+};
+
+/**
+ * @class DatagramTransport
+ * @brief Receives and sends UDP datagrams in batches on one bound socket.
+ */
+class DatagramTransport {
+public:
+    static constexpr size_t MAX_DATAGRAM = 512;  ///< Largest datagram sent or received whole
+
+    virtual ~DatagramTransport() = default;
+
+    /**
+     * @brief Waits up to timeout for datagrams and returns all that are ready.
+     * @param[out] batch Replaced with the received datagrams (valid until the next receive())
+     * @param timeout    Longest time to wait when nothing is ready
+     * @return Number of datagrams received
+     */
+    virtual size_t receive(std::vector<ReceivedDatagram>& batch, std::chrono::microseconds timeout) = 0;
+
+    /**
+     * @brief Queues a datagram for the next flush() (which may happen early if the queue is full).
+     * @return False if the datagram is larger than MAX_DATAGRAM
+     */
+    virtual bool send(const sockaddr_in& to, const char* data, size_t size) = 0;
+
+    /**
+     * @brief Hands every queued datagram to the kernel.
+     * @return Number of datagrams submitted
+     */
+    virtual size_t flush() = 0;
+
+    virtual const char* name() const = 0;
+
+    const TransportStats& stats() const { return stats_; }
+
+protected:
+#ifdef __linux__
+    /**
+     * @brief Receive metadata of one message (control messages the Linux backends ask for).
+     */
+    struct MessageMetadata {
+        int64_t kernelTime = 0;     ///< SO_TIMESTAMPNS (0: absent)
+        size_t groSegment = 0;      ///< UDP_GRO segment size (0: not coalesced)
+    };
+
+    /** @brief Turns on receive timestamps and drop counters; the current drop count becomes the baseline. */
+    void enableReceiveMetadata(SocketHandle sock);
+
+    /** @brief Reads the control messages of a received message and updates kernelDrops. */
+    MessageMetadata readMetadata(const msghdr& msg);
+
+    /** @brief Control buffer bytes per message for readMetadata(). */
+    static constexpr size_t METADATA_CONTROL = 96;
+
+    uint32_t dropBaseline_ = 0;   // Kernel drop counter when the transport was created
+#endif
+    TransportStats stats_;
+};
+
+/**
+ * @class SocketTransport
+ * @brief Portable backend: recvmmsg/sendmmsg where available, recvfrom/sendto otherwise.
+ */
+class SocketTransport : public DatagramTransport {
+public:
+    static constexpr size_t BATCH = 64;                ///< Datagrams per recvmmsg/sendmmsg call (and most segments per GSO send)
+    static constexpr size_t GRO_BUFFER = 64 * 1024;    ///< Receive buffer per message when GRO is on (largest coalesced buffer)
+
+    /**
+     * @param sock    Bound UDP socket (not owned)
+     * @param offload Use UDP GSO/GRO where the kernel supports them (Linux); false turns GRO off on the socket
+     * @param receive False for a send-only transport: no receive buffers, the socket's GRO setting is left
+     *                alone and receive() returns nothing
+     */
+    explicit SocketTransport(SocketHandle sock, bool offload = true, bool receive = true);
+
+    bool gsoEnabled() const { return gso_; }
+    bool groEnabled() const { return gro_; }
+
+    size_t receive(std::vector<ReceivedDatagram>& batch, std::chrono::microseconds timeout) override;
+    bool send(const sockaddr_in& to, const char* data, size_t size) override;
+    size_t flush() override;
+    const char* name() const override;
+
+private:
+    struct Outgoing {
+        sockaddr_in addr;
+        size_t size;
+        char data[MAX_DATAGRAM];
+    };
+
+    SocketHandle sock_;
+    bool gso_ = false;
+    bool gro_ = false;
+    size_t slotSize_ = MAX_DATAGRAM;               // Receive bytes per message (GRO_BUFFER with GRO)
+    std::unique_ptr<char[]> receiveBuffers_;       // BATCH slots of slotSize_ bytes (null if send-only)
+    std::vector<sockaddr_in> receiveAddrs_;
+    std::vector<Outgoing> queue_;
+    size_t queued_ = 0;
+};
+
+enum class TransportKind {
+    Socket,
+    IoUring
+};
+
+/**
+ * @brief Creates the preferred backend, or SocketTransport if it is unavailable.
+ * @param sock      Bound UDP socket (not owned; must outlive the transport)
+ * @param preferred Backend to try first
+ * @param receive   False for a transport that only sends
+ */
+std::unique_ptr<DatagramTransport> makeTransport(SocketHandle sock, TransportKind preferred, bool receive = true);
@@ -0,0 +1,126 @@
+/**
+ * @file work_stealing_deque.hpp
+ * @brief Bounded Chase-Lev work-stealing deque.
+ *
+ * The owning thread pushes and pops at the bottom (LIFO, cache-warm work
+ * first); any other thread may steal from the top (FIFO, oldest and usually
+ * largest work first). Owner operations are wait-free and a steal is a single
+ * compare-and-swap. Memory orderings follow Le, Pop, Cohen and Zappa Nardelli,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * Usage:
+ *   - Only the owner calls push() and pop(); anyone may call steal().
+ *   - The capacity is fixed: push() returns false when full and the caller
+ *     should run the item itself.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class WorkStealingDeque
+ * @brief Single-owner, multi-thief deque of pointers.
+ * @tparam T Element type; items are stored as T*
+ */
+template<typename T>
+class WorkStealingDeque {
+public:
+    /**
+     * @param capacity Maximum number of queued items (rounded up to a power of two)
+     */
+    explicit WorkStealingDeque(size_t capacity = 4096) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        mask_ = static_cast<int64_t>(rounded - 1);
+        buffer_ = std::make_unique<std::atomic<T*>[]>(rounded);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Pushes an item at the bottom. Owner only.
+     * @return False if the deque is full
+     */
+    bool push(T* item) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t > mask_) {
+            return false;
+        }
+        buffer_[b & mask_].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Pops the most recently pushed item. Owner only.
+     * @return Item, or nullptr if empty (or the last item was stolen concurrently)
+     */
+    T* pop() {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = buffer_[b & mask_].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last item: race against thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * @brief Takes the oldest item. Any thread.
+     * @return Item, or nullptr if empty or another thread won the race
+     */
+    T* steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        T* item = buffer_[t & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /**
+     * @brief Approximate number of queued items (exact only when no other thread is active).
+     */
+    size_t size() const {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    size_t capacity() const { return static_cast<size_t>(mask_ + 1); }
+
+private:
+    // Thieves contend on top_, the owner works on bottom_: keep them on separate cache lines
+    alignas(64) std::atomic<int64_t> top_{ 0 };
+    alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    int64_t mask_ = 0;
+    std::unique_ptr<std::atomic<T*>[]> buffer_;
+};
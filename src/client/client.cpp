@@ -21,11 +21,21 @@
  * - **Trail visualization**: Each dot leaves a faded trail to show movement history and delay effects
  * - **Interactive UI**: Press [C] to clear all trails. Arrow keys move the local object. Number keys select latency presets.
  * - **Robust error handling**: Comprehensive validation and error reporting
- * - **Packet loss tracking**: Real packet loss detection via sequence gap analysis
+ * - **Packet loss tracking**: Real packet loss detection via gaps in the server's snapshot sequence
+ *   (snapshots the server skips on purpose, e.g. in dead-reckoning mode, are not counted)
+ * - **Change-driven input**: input is sent when the arrow keys change (plus two repeats and a
+ *   250 ms heartbeat, see InputEncoder) instead of every 33 ms; the server holds it in between
+ * - **Input-to-photon latency**: every sent input is timed from key sampling through send, server
+ *   acknowledgement and reconciliation to the frame that shows it (InputLatencyTracker); the HUD
+ *   shows local and server-confirmed histograms, [E] exports them (also written on exit)
+ * - **Late-latched input**: a FramePacer replaces the 60 FPS framerate limit; each frame waits until
+ *   the predicted frame cost before its present deadline, then samples the keys, sends them and
+ *   renders, instead of sampling first and sleeping after presenting
  *
  * NEW CONTROLS:
  *   - 1-5: Select latency preset
  *   - C: Clear trails
+ *   - E: Export input latency records and histograms (input_latency.csv, input_latency_histograms.csv)
  *
  * Visualization legend:
  *   - Section 1: Local input (green)
@@ -35,8 +45,11 @@
  *   - Section 5: Interpolation (orange)
  *
  * Threading model:
- *   - Main thread: Handles rendering, input, and game logic at 60 FPS
- *   - Network thread: Manages all UDP communication independently with condition variables
+ *   - Main thread: Handles rendering, input, and game logic at 60 FPS, paced by FramePacer
+ *   - Network thread: Runs a coroutine Reactor with two linear loops, one per direction. The send
+ *     loop sleeps until the main thread hands over input or a delayed packet is due; the receive
+ *     loop sleeps until the socket is readable or a delayed packet is due, then drains every
+ *     pending datagram (recvmmsg on Linux) into the delay queue at once
  *   - Communication via thread-safe queues ensures no blocking between threads
  *
  * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
@@ -55,6 +68,7 @@ typedef SOCKET socket_t;
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/uio.h>
 #include <cerrno>
 #include <cstring>
 typedef int socket_t;
@@ -73,10 +87,18 @@ typedef int socket_t;
 #include <queue>
 #include <condition_variable>
 #include <algorithm>
+#include <array>
+#include <optional>
+#include <fstream>
 #include "netcode/common/packet.hpp"
+#include "netcode/common/packet_view.hpp"
 #include "netcode/common/prediction.hpp"
 #include "netcode/common/interpolation.hpp"
 #include "netcode/common/input.hpp"
+#include "netcode/common/frame_pacer.hpp"
+#include "netcode/common/input_encoder.hpp"
+#include "netcode/common/input_latency.hpp"
+#include "netcode/common/reactor.hpp"
 
 #include <SFML/Graphics.hpp>
 
@@ -154,6 +176,20 @@ public:
         }
     }
 
+    /**
+     * @brief Pushes several items under one lock with one wakeup.
+     * @param items Items in order (those beyond the size limit are dropped)
+     */
+    void pushAll(const std::vector<T>& items) {
+        if (items.empty()) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const T& item : items) {
+            if (queue_.size() >= maxSize_) break;
+            queue_.push(item);
+        }
+        cv_.notify_one();
+    }
+
     bool pop(T& item) {
         std::lock_guard<std::mutex> lock(mutex_);
         if (queue_.empty()) return false;
@@ -260,15 +296,19 @@ std::string getCurrentTimestamp() {
 
 /**
  * @brief Represents a packet scheduled for delayed send/receive to simulate network lag.
+ *
+ * The datagram is stored inline (no per-packet heap allocation) and is handed to the
+ * consumer as a PacketView over this storage when its delay expires. Room for a snapshot,
+ * the larger of the two datagrams.
  */
 struct DelayedPacket {
-    std::vector<char> data;
+    std::array<char, Packet::snapshotWireSize()> data;
+    size_t length;
     std::chrono::steady_clock::time_point releaseTime;
     sockaddr_in addr;
     int addrlen;
 
-    DelayedPacket(const char* buf, size_t len, sockaddr_in a, int alen, std::chrono::steady_clock::time_point rel)
-        : data(buf, buf + len), releaseTime(rel), addr(a), addrlen(alen) {}
+    DelayedPacket() : data{}, length(0), releaseTime(), addr{}, addrlen(0) {}
 };
 
 /**
@@ -281,6 +321,12 @@ class DelaySimulator {
     mutable std::mutex mutex_;
     LatencyPresetManager& presetManager;
 
+    std::chrono::steady_clock::time_point nextReleaseTime() {
+        auto delayRange = presetManager.getCurrentDelayRange();
+        std::uniform_int_distribution<int> dist(delayRange.first, delayRange.second);
+        return std::chrono::steady_clock::now() + std::chrono::milliseconds(dist(rng));
+    }
+
 public:
     DelaySimulator(LatencyPresetManager& manager) : rng(std::random_device{}()), presetManager(manager) {}
 
@@ -293,33 +339,72 @@ public:
      */
     void send(const char* buf, size_t len, sockaddr_in addr, int addrlen) {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto delayRange = presetManager.getCurrentDelayRange();
-        std::uniform_int_distribution<int> dist(delayRange.first, delayRange.second);
-        int delay = dist(rng);
-        auto release = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay);
-        queue.emplace_back(buf, len, addr, addrlen, release);
+        DelayedPacket& pkt = queue.emplace_back();
+        pkt.length = std::min(len, pkt.data.size());
+        std::copy(buf, buf + pkt.length, pkt.data.begin());
+        pkt.addr = addr;
+        pkt.addrlen = addrlen;
+        pkt.releaseTime = nextReleaseTime();
     }
 
     /**
-     * @brief Retrieves a ready-to-send packet whose delay has expired.
-     * @param buf   Output buffer to fill with packet data
-     * @param len   Buffer size
-     * @param addr  Output: address for packet
-     * @param addrlen Output: address length
-     * @return      True if a packet is ready, false otherwise
+     * @brief Schedules a batch of packets written directly into queue slots.
+     *
+     * Appends capacity slots, lets fill write a burst of datagrams into them (e.g. one
+     * recvmmsg call), then queues the filled slots, all under one lock.
+     *
+     * @param capacity Most packets to accept
+     * @param fill     Callable (DelayedPacket* const* slots, size_t capacity) -> size_t, returning how
+     *                 many leading slots it wrote; a written slot left with length 0 is discarded
+     * @return         Slots written by fill (discarded ones included)
      */
-    bool getReady(char* buf, size_t len, sockaddr_in& addr, int& addrlen) {
+    template<typename Fill>
+    size_t sendBatchInPlace(size_t capacity, Fill&& fill) {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (!queue.empty() && queue.front().releaseTime <= std::chrono::steady_clock::now()) {
+        const size_t start = queue.size();
+        std::vector<DelayedPacket*> slots(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i] = &queue.emplace_back();  // Appending keeps earlier elements in place
+        }
+        const size_t written = std::min(fill(slots.data(), capacity), capacity);
+        queue.resize(start + written);
+        queue.erase(std::remove_if(queue.begin() + start, queue.end(),
+            [](const DelayedPacket& pkt) { return pkt.length == 0; }), queue.end());
+        for (size_t i = start; i < queue.size(); ++i) {
+            queue[i].releaseTime = nextReleaseTime();
+        }
+        return written;
+    }
+
+    /**
+     * @brief Hands every packet whose delay has expired to a consumer, then drops it.
+     *
+     * The consumer reads the packet in place through a PacketView; nothing is copied out.
+     *
+     * @param consume Callable (const PacketView& view, const sockaddr_in& addr, int addrlen)
+     * @return        Number of packets released
+     */
+    template<typename Consume>
+    size_t releaseReady(Consume&& consume) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        size_t released = 0;
+        while (!queue.empty() && queue.front().releaseTime <= now) {
             const auto& pkt = queue.front();
-            size_t toCopy = std::min(len, pkt.data.size());
-            std::copy(pkt.data.begin(), pkt.data.begin() + toCopy, buf);
-            addr = pkt.addr;
-            addrlen = pkt.addrlen;
+            consume(PacketView(pkt.data.data(), pkt.length), pkt.addr, pkt.addrlen);
             queue.pop_front();
-            return true;
+            ++released;
         }
-        return false;
+        return released;
+    }
+
+    /**
+     * @brief When the oldest queued packet is due (packets leave in order).
+     * @return Its release time, or time_point::max() if nothing is queued
+     */
+    std::chrono::steady_clock::time_point earliestRelease() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue.empty() ? std::chrono::steady_clock::time_point::max() : queue.front().releaseTime;
     }
 
     void clear() {
@@ -398,111 +483,220 @@ struct NetworkStats {
     std::atomic<int> packetsReceived{ 0 };
     std::atomic<int> sendErrors{ 0 };
     std::atomic<int> invalidPacketsReceived{ 0 };
-    std::atomic<int> packetsLost{ 0 };  // Actual packet loss count
+    std::atomic<int> packetsLost{ 0 };  // Snapshots lost on the way (gaps in SnapshotAck::snapshotSeq)
     std::atomic<float> avgRTT{ 100.0f };
     std::chrono::steady_clock::time_point lastServerPacketTime;
     std::mutex timeMutex;
 
-    // Sequence tracking for packet loss detection
-    uint32_t expectedServerSeq{ 1 };
+    // Sequence tracking: snapshot numbers for loss detection, echoed input numbers for RTT
+    uint32_t expectedSnapshotSeq{ 1 };
+    uint32_t newestAckedInput{ 0 };
     std::mutex seqMutex;
+
+    // Stage times of sent inputs: sent and acked here, the rest on the main thread
+    InputLatencyTracker inputLatency;
 };
 
 /**
- * @brief Network thread that handles all UDP communication.
- * @param sock UDP socket
- * @param servAddr Server address
- * @param outgoingQueue Queue for packets to send
- * @param incomingQueue Queue for received packets
- * @param running Flag to control thread lifecycle
- * @param stats Shared statistics structure
- * @param presetManager Latency preset manager for dynamic delay control
+ * @brief Receives every datagram that is ready (up to capacity) into delay queue slots without blocking.
+ *
+ * Uses one recvmmsg call on Linux and a recvfrom loop elsewhere. Each slot gets the length of
+ * the payload and its SnapshotAck, or 0 if the checksum trailer does not verify.
+ *
+ * @param sock     Non-blocking UDP socket
+ * @param slots    Slots to fill, in order
+ * @param capacity Number of slots
+ * @param stats    Statistics (invalid packets are counted here)
+ * @return         Number of slots written
  */
-void networkThread(socket_t sock, sockaddr_in servAddr,
-    ThreadSafeQueue<Packet>& outgoingQueue,
-    ThreadSafeQueue<Packet>& incomingQueue,
-    std::atomic<bool>& running,
-    NetworkStats& stats,
-    LatencyPresetManager& presetManager) {
-
-    char buf[Packet::size()];
-    sockaddr_in fromAddr;
+size_t receiveBatch(socket_t sock, DelayedPacket* const* slots, size_t capacity, NetworkStats& stats) {
+    size_t received = 0;
+#ifdef __linux__
+    std::vector<mmsghdr> messages(capacity);
+    std::vector<iovec> iovs(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        iovs[i] = { slots[i]->data.data(), slots[i]->data.size() };
+        std::memset(&messages[i], 0, sizeof(mmsghdr));
+        messages[i].msg_hdr.msg_name = &slots[i]->addr;
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        messages[i].msg_hdr.msg_iov = &iovs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    const int count = recvmmsg(sock, messages.data(), static_cast<unsigned>(capacity), MSG_DONTWAIT, nullptr);
+    for (int i = 0; i < count; ++i) {
+        DelayedPacket& pkt = *slots[i];
+        pkt.addrlen = static_cast<int>(messages[i].msg_hdr.msg_namelen);
+        pkt.length = messages[i].msg_len;
+    }
+    received = count > 0 ? static_cast<size_t>(count) : 0;
+#else
+    for (; received < capacity; ++received) {
+        DelayedPacket& pkt = *slots[received];
 #ifdef _WIN32
-    int fromSize = sizeof(fromAddr);
+        int fromSize = sizeof(pkt.addr);
 #else
-    socklen_t fromSize = sizeof(fromAddr);
+        socklen_t fromSize = sizeof(pkt.addr);
 #endif
+        const int bytes = recvfrom(sock, pkt.data.data(), static_cast<int>(pkt.data.size()), 0,
+            (sockaddr*)&pkt.addr, &fromSize);
+        if (bytes <= 0) {
+            break;  // Nothing more pending (the socket is non-blocking)
+        }
+        pkt.addrlen = static_cast<int>(fromSize);
+        pkt.length = static_cast<size_t>(bytes);
+    }
+#endif
+    // Verify the checksum trailers up front and queue only the payloads
+    for (size_t i = 0; i < received; ++i) {
+        DelayedPacket& pkt = *slots[i];
+        if (!Packet::hasValidSnapshotChecksum(pkt.data.data(), pkt.length)) {
+            stats.invalidPacketsReceived++;
+            pkt.length = 0;
+        }
+        else {
+            pkt.length = Packet::size() + SnapshotAck::size();
+        }
+    }
+    return received;
+}
 
-    DelaySimulator outgoingDelay(presetManager);
-    DelaySimulator incomingDelay(presetManager);
+/**
+ * @brief When each recent input packet was queued, by sequence number.
+ *
+ * The encoder repeats inputs across packets, so the snapshot answering an input can
+ * arrive several packets later; the RTT has to be timed from that input's own send.
+ * Both loops run on the reactor thread, so no locking is needed.
+ */
+class SendTimes {
+public:
+    void record(uint32_t seq, std::chrono::steady_clock::time_point at) {
+        slots_[seq % slots_.size()] = { seq, at, true };
+    }
 
-    auto lastSendTime = std::chrono::steady_clock::now();
+    std::optional<std::chrono::steady_clock::time_point> find(uint32_t seq) const {
+        const Slot& slot = slots_[seq % slots_.size()];
+        if (!slot.used || slot.seq != seq) return std::nullopt;
+        return slot.at;
+    }
 
-    std::cout << "[Network Thread] Started successfully with condition variables" << std::endl;
+private:
+    struct Slot {
+        uint32_t seq = 0;
+        std::chrono::steady_clock::time_point at;
+        bool used = false;
+    };
+    std::array<Slot, 256> slots_{};
+};
 
-    while (running) {
-        auto now = std::chrono::steady_clock::now();
+/**
+ * @brief Send path: delays input handed over by the main thread, then sends it when due.
+ * @param outgoingReady Raised by the main thread after each push to outgoingQueue
+ * @param sendTimes     Queue time of each packet (shared with receiveLoop for RTT)
+ */
+Task<void> sendLoop(ReactorEvent& outgoingReady, socket_t sock, sockaddr_in servAddr,
+    ThreadSafeQueue<Packet>& outgoingQueue,
+    DelaySimulator& outgoingDelay,
+    NetworkStats& stats,
+    SendTimes& sendTimes) {
 
-        // Wait for outgoing packets with timeout
+    char buf[Packet::wireSize()];
+    while (true) {
         Packet outPacket;
-        if (outgoingQueue.waitAndPop(outPacket, std::chrono::milliseconds(10))) {
-            outPacket.serialize(buf);
-            outgoingDelay.send(buf, Packet::size(), servAddr, sizeof(servAddr));
-            lastSendTime = now;
+        while (outgoingQueue.pop(outPacket)) {
+            outPacket.serializeWithChecksum(buf);
+            outgoingDelay.send(buf, Packet::wireSize(), servAddr, sizeof(servAddr));
+            sendTimes.record(outPacket.seq, std::chrono::steady_clock::now());
         }
 
-        sockaddr_in delayedAddr;
-        int delayedAddrLen;
-        char delayedBuf[Packet::size()];
-        while (outgoingDelay.getReady(delayedBuf, Packet::size(), delayedAddr, delayedAddrLen)) {
-            int result = sendto(sock, delayedBuf, static_cast<int>(Packet::size()), 0,
-                (sockaddr*)&delayedAddr, delayedAddrLen);
+        // Send delayed packets straight from the delay queue storage
+        outgoingDelay.releaseReady([&](const PacketView& view, const sockaddr_in& addr, int addrlen) {
+            int result = sendto(sock, view.data(), static_cast<int>(view.length()), 0,
+                (const sockaddr*)&addr, addrlen);
             if (result < 0) {
                 printSocketError("sendto");
                 stats.sendErrors++;
             }
             else {
                 stats.packetsSent++;
+                stats.inputLatency.sent(view.seq(), std::chrono::steady_clock::now());
             }
-        }
+        });
 
-        int bytes = recvfrom(sock, buf, static_cast<int>(Packet::size()), 0,
-            (sockaddr*)&fromAddr, &fromSize);
-        if (bytes == static_cast<int>(Packet::size())) {
-            incomingDelay.send(buf, Packet::size(), fromAddr, fromSize);
-        }
-        else if (bytes > 0) {
-            stats.invalidPacketsReceived++;
-        }
+        // Sleep until new input arrives or the next delayed packet is due
+        co_await outgoingReady.wait(outgoingDelay.earliestRelease());
+    }
+}
 
-        sockaddr_in incomingAddr;
-        int incomingAddrLen;
-        char incomingBuf[Packet::size()];
-        while (incomingDelay.getReady(incomingBuf, Packet::size(), incomingAddr, incomingAddrLen)) {
-            Packet receivedPacket;
-            receivedPacket.deserialize(incomingBuf);
+/** @brief A server snapshot handed to the main thread: the state and its SnapshotAck. */
+struct ServerSnapshot {
+    Packet packet;
+    SnapshotAck ack;
+};
 
-            if (receivedPacket.isValid()) {
-                // Packet loss detection via sequence gap analysis
+/**
+ * @brief Receive path: drains the socket into the delay queue and hands due packets to the main thread.
+ * @param sendTimes When each input was queued (for the RTT estimate)
+ */
+Task<void> receiveLoop(Reactor& reactor, socket_t sock,
+    ThreadSafeQueue<ServerSnapshot>& incomingQueue,
+    DelaySimulator& incomingDelay,
+    NetworkStats& stats,
+    const SendTimes& sendTimes) {
+
+    const size_t RECEIVE_BATCH = 32;  // Datagrams per recvmmsg call
+    std::vector<ServerSnapshot> released;
+
+    while (true) {
+        // Drain everything pending, a batch at a time, directly into delay queue slots (no staging buffer)
+        while (incomingDelay.sendBatchInPlace(RECEIVE_BATCH, [&](DelayedPacket* const* slots, size_t capacity) {
+            return receiveBatch(sock, slots, capacity, stats);
+        }) == RECEIVE_BATCH) {
+        }
+
+        // Decode released packets in place and hand them to the main thread together
+        const auto now = std::chrono::steady_clock::now();
+        released.clear();
+        incomingDelay.releaseReady([&](const PacketView& datagram, const sockaddr_in&, int) {
+            // The payload is followed by the snapshot's SnapshotAck (both covered by the checksum)
+            const PacketView view(datagram.data(), Packet::size());
+            if (datagram.length() == Packet::size() + SnapshotAck::size() && view.isValid()) {
+                Packet receivedPacket = view.toPacket();
+                SnapshotAck ack;
+                ack.deserialize(datagram.data() + Packet::size());
+
+                // Packet loss detection via gaps in the snapshot sequence. The echoed input
+                // sequence number cannot tell: the server skips snapshots on purpose (dead
+                // reckoning, idle clients under load), and those never take a snapshot number
+                bool newestInput = false;
                 {
                     std::lock_guard<std::mutex> seqLock(stats.seqMutex);
-                    if (receivedPacket.seq > stats.expectedServerSeq) {
-                        // Gap detected - packets were lost
-                        int lostCount = receivedPacket.seq - stats.expectedServerSeq;
+                    newestInput = receivedPacket.seq > stats.newestAckedInput;
+                    if (newestInput) {
+                        stats.newestAckedInput = receivedPacket.seq;
+                    }
+                    if (ack.snapshotSeq > stats.expectedSnapshotSeq) {
+                        // Gap detected - snapshots were lost
+                        int lostCount = ack.snapshotSeq - stats.expectedSnapshotSeq;
                         stats.packetsLost += lostCount;
                         std::cout << "[Network Thread] Detected " << lostCount
-                            << " lost packets (gap: " << stats.expectedServerSeq
-                            << " to " << receivedPacket.seq << ")" << std::endl;
+                            << " lost snapshots (gap: " << stats.expectedSnapshotSeq
+                            << " to " << ack.snapshotSeq << ")" << std::endl;
                     }
-                    stats.expectedServerSeq = receivedPacket.seq + 1;
+                    stats.expectedSnapshotSeq = ack.snapshotSeq + 1;
                 }
 
-                incomingQueue.push(receivedPacket);
+                released.push_back({ receivedPacket, ack });
                 stats.packetsReceived++;
-
-                float rtt = std::chrono::duration<float>(now - lastSendTime).count() * 1000.0f;
-                float currentAvg = stats.avgRTT.load();
-                stats.avgRTT = currentAvg * 0.9f + rtt * 0.1f;
+                stats.inputLatency.acked(receivedPacket.seq, now);
+
+                // Only the first answer to an input times the round trip: the server keeps
+                // sending snapshots for held input long after the packet went out
+                auto sentAt = newestInput ? sendTimes.find(receivedPacket.seq) : std::nullopt;
+                if (sentAt) {
+                    float rtt = std::chrono::duration<float>(now - *sentAt).count() * 1000.0f;
+                    float currentAvg = stats.avgRTT.load();
+                    stats.avgRTT = currentAvg * 0.9f + rtt * 0.1f;
+                }
 
                 {
                     std::lock_guard<std::mutex> lock(stats.timeMutex);
@@ -512,14 +706,64 @@ void networkThread(socket_t sock, sockaddr_in servAddr,
             else {
                 stats.invalidPacketsReceived++;
             }
-        }
+        });
+        incomingQueue.pushAll(released);
 
-        // No sleep needed - condition variable handles efficient waiting
+        // Sleep until a datagram arrives or the next delayed packet is due
+        co_await reactor.readable(sock, incomingDelay.earliestRelease());
     }
+}
+
+/**
+ * @brief Network thread that handles all UDP communication.
+ *
+ * Runs sendLoop and receiveLoop on one Reactor; both share this thread, so the
+ * state they share needs no locking. Returns when the main thread calls reactor.stop().
+ *
+ * @param sock UDP socket (non-blocking)
+ * @param servAddr Server address
+ * @param outgoingQueue Queue for packets to send
+ * @param outgoingReady Raised by the main thread after pushing to outgoingQueue
+ * @param incomingQueue Queue for received snapshots
+ * @param reactor Reactor to run on this thread
+ * @param stats Shared statistics structure
+ * @param presetManager Latency preset manager for dynamic delay control
+ */
+void networkThread(socket_t sock, sockaddr_in servAddr,
+    ThreadSafeQueue<Packet>& outgoingQueue,
+    ReactorEvent& outgoingReady,
+    ThreadSafeQueue<ServerSnapshot>& incomingQueue,
+    Reactor& reactor,
+    NetworkStats& stats,
+    LatencyPresetManager& presetManager) {
+
+    DelaySimulator outgoingDelay(presetManager);
+    DelaySimulator incomingDelay(presetManager);
+
+    SendTimes sendTimes;
+
+    std::cout << "[Network Thread] Started successfully with coroutine reactor" << std::endl;
+
+    reactor.spawn(sendLoop(outgoingReady, sock, servAddr, outgoingQueue, outgoingDelay, stats, sendTimes));
+    reactor.spawn(receiveLoop(reactor, sock, incomingQueue, incomingDelay, stats, sendTimes));
+    reactor.run();
 
     std::cout << "[Network Thread] Shutting down..." << std::endl;
 }
 
+/**
+ * @brief Writes the input latency records (input_latency.csv) and histograms
+ *        (input_latency_histograms.csv) to the working directory.
+ * @return False if a file could not be written
+ */
+bool exportInputLatency(const InputLatencyTracker& tracker) {
+    std::ofstream records("input_latency.csv");
+    tracker.exportCsv(records);
+    std::ofstream histograms("input_latency_histograms.csv");
+    tracker.exportHistograms(histograms);
+    return records.good() && histograms.good();
+}
+
 // -----------------------------------------------------------------------------
 
 int main() {
@@ -582,20 +826,22 @@ int main() {
 
     // (4) Thread communication setup
     ThreadSafeQueue<Packet> outgoingPackets;
-    ThreadSafeQueue<Packet> incomingPackets;
-    std::atomic<bool> networkThreadRunning{ true };
+    ThreadSafeQueue<ServerSnapshot> incomingPackets;
+    Reactor networkReactor;
+    ReactorEvent outgoingReady(networkReactor);
     NetworkStats networkStats;
     LatencyPresetManager presetManager;
 
     // (5) Start network thread
     std::thread netThread(networkThread, sock, servAddr,
-        std::ref(outgoingPackets), std::ref(incomingPackets),
-        std::ref(networkThreadRunning), std::ref(networkStats), std::ref(presetManager));
+        std::ref(outgoingPackets), std::ref(outgoingReady), std::ref(incomingPackets),
+        std::ref(networkReactor), std::ref(networkStats), std::ref(presetManager));
 
     std::cout << "[" << getCurrentTimestamp() << "] Network thread started" << std::endl;
 
     // (6) Simulation state - start at center of play area
     uint32_t seq = 1; // Start from 1 (0 is invalid for packet validation)
+    uint32_t frameId = 1; // Predicted frames; several share one input packet while the keys are held
     float x = 200, y = 300; // Center of play area
 
     // (7) Advanced prediction system (input buffering and reconciliation)
@@ -616,7 +862,8 @@ int main() {
 
     // (9) SFML window and visual setup (five sections for comparison)
     sf::RenderWindow window(sf::VideoMode(1800, 1000), "Advanced Netcode Demo - Multithreaded");
-    window.setFramerateLimit(60);
+    // No framerate limit: it would sleep inside display(), after the input was sampled. The
+    // FramePacer in the main loop sleeps before sampling instead
 
     const float sectionWidth = 340.f;
     const float sectionHeight = 550.f;
@@ -713,7 +960,7 @@ int main() {
     sf::Text instructionsText("", font, 16);
     instructionsText.setPosition(20, 910);
     instructionsText.setFillColor(sf::Color(220, 220, 220));
-    instructionsText.setString("Arrow Keys: move | C: clear trails | 1-5: Select latency preset | Multithreaded networking demonstration");
+    instructionsText.setString("Arrow Keys: move | C: clear trails | 1-5: Select latency preset | E: export input latency | Multithreaded networking demonstration");
 
     sf::Text statusText("", font, 18);
     statusText.setPosition(20, 140);
@@ -725,6 +972,10 @@ int main() {
     sf::Text latencyPresetText("", font, 18);
     latencyPresetText.setPosition(20, 170);
 
+    sf::Text inputLatencyText("", font, 16);
+    inputLatencyText.setPosition(20, 940);
+    inputLatencyText.setFillColor(sf::Color(200, 200, 255));
+
     std::vector<sf::RectangleShape> presetBoxes;
     std::vector<sf::Text> presetLabels;
     const float boxWidth = 280.f;
@@ -751,11 +1002,17 @@ int main() {
 
     // (10) Main loop: simulate, communicate, predict, reconcile, visualize
     auto frameStart = std::chrono::steady_clock::now();
-    auto lastSendTime = std::chrono::steady_clock::now();
+    InputEncoder inputEncoder;
+    FramePacer framePacer;
+    auto lastLatencyUpdate = std::chrono::steady_clock::now();
     bool serverConnected = false;
 
     while (window.isOpen()) {
+        // Sleep until the predicted frame cost before the next present deadline, so the input
+        // below is sampled as late as the frame allows
+        framePacer.waitForLatch();
         auto now = std::chrono::steady_clock::now();
+        framePacer.beginFrame(now);
         float frameDt = std::chrono::duration<float>(now - frameStart).count();
         frameStart = now;
 
@@ -773,6 +1030,12 @@ int main() {
                     interpTrail.clear();
                     std::cout << "[" << getCurrentTimestamp() << "] Trails cleared by user" << std::endl;
                 }
+                else if (event.key.code == sf::Keyboard::E) {
+                    const bool written = exportInputLatency(networkStats.inputLatency);
+                    std::cout << "[" << getCurrentTimestamp() << "] Input latency "
+                        << (written ? "exported to input_latency.csv and input_latency_histograms.csv" : "export failed")
+                        << std::endl;
+                }
                 else if (event.key.code >= sf::Keyboard::Num1 && event.key.code <= sf::Keyboard::Num5) {
                     int presetIndex = event.key.code - sf::Keyboard::Num1;
                     if (presetIndex < static_cast<int>(presetManager.presets.size())) {
@@ -803,23 +1066,23 @@ int main() {
             }
         }
 
-        // c) Gather keyboard input (raw input to send to server)
+        // c) Gather keyboard input (raw input to send to server); latency is measured from here
+        const auto sampledAt = std::chrono::steady_clock::now();
+        networkStats.inputLatency.sampled(sampledAt);
         float inputX = 0.0f, inputY = 0.0f;
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))  inputX = 1.0f;
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))   inputX = -1.0f;
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))   inputY = 1.0f;
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))     inputY = -1.0f;
 
-        // d) Send RAW INPUT to server (server decides position, not client)
-        auto timeSinceLastSend = std::chrono::duration<float>(now - lastSendTime).count();
-        if (timeSinceLastSend >= 0.033f) {  // ~30Hz send rate
-
-            Packet inputPacket{ seq++, inputX, inputY, 0, 0 };
-
-            if (inputPacket.seq > 0) {
-                outgoingPackets.push(inputPacket);
-                lastSendTime = now;
-            }
+        // d) Send RAW INPUT to server (server decides position, not client) when it changes,
+        //    repeated twice for loss and as a heartbeat; the server holds it in between
+        if (inputEncoder.sample(inputX, inputY, now) != InputSend::None) {
+            const InputCommand command(seq++, inputX, inputY, frameDt, sampledAt);
+            Packet inputPacket{ command.sequence, command.vx, command.vy, 0, 0 };
+            networkStats.inputLatency.queued(command.sequence, command.sampledAt);
+            outgoingPackets.push(inputPacket);
+            outgoingReady.set();
         }
 
         // e) LOCAL INPUT: Apply input immediately for responsive feel (green dot)
@@ -833,22 +1096,29 @@ int main() {
         y = std::clamp(y, 30.f, sectionHeight - 30.f);
 
         // f) ADVANCED PREDICTION: Apply input to prediction system
-        InputCommand input(seq - 1, inputX, inputY, frameDt);
+        //    The server acknowledges it by the last input packet sent (seq - 1) and how long it held it
+        InputCommand input(frameId++, inputX, inputY, frameDt, sampledAt);
+        input.packetSeq = seq - 1;
         advancedPrediction.applyInput(input);
         advancedPrediction.update(frameDt);
         auto advPredPos = advancedPrediction.getPredictedPosition();
 
         // g) Process incoming packets from server (SERVER IS AUTHORITATIVE)
-        Packet serverPacket;
-        while (incomingPackets.pop(serverPacket)) {
+        ServerSnapshot snapshot;
+        bool reconciled = false;
+        while (incomingPackets.pop(snapshot)) {
             prevPacket = nextPacket;
             prevRecvTime = nextRecvTime;
 
-            nextPacket = serverPacket;
+            nextPacket = snapshot.packet;
             nextRecvTime = now;
             hasPrev = true;
 
-            advancedPrediction.reconcileWithServer(nextPacket);
+            advancedPrediction.reconcileWithServer(nextPacket, std::chrono::microseconds(snapshot.ack.heldMicros));
+            reconciled = true;
+        }
+        if (reconciled) {
+            networkStats.inputLatency.reconciled(nextPacket.seq, std::chrono::steady_clock::now());
         }
 
         // h) Naive prediction: simple extrapolation from AUTHORITATIVE server packet
@@ -886,7 +1156,8 @@ int main() {
         metrics << "Network Statistics (Server Authoritative):\n";
         metrics << "FPS: " << (1.0f / frameDt) << " | ";
         metrics << "RTT: " << networkStats.avgRTT.load() << " ms | ";
-        metrics << "Input Packets Sent: " << networkStats.packetsSent.load() << " | ";
+        metrics << "Input Packets Sent: " << networkStats.packetsSent.load() << " (" << inputEncoder.changes()
+            << " changes, " << inputEncoder.repeats() << " repeats, " << inputEncoder.heartbeats() << " heartbeats) | ";
         metrics << "Server Updates Received: " << networkStats.packetsReceived.load() << " | ";
         metrics << "Invalid Packets: " << networkStats.invalidPacketsReceived.load() << " | ";
         metrics << "Send Errors: " << networkStats.sendErrors.load() << "\n";
@@ -895,13 +1166,37 @@ int main() {
         int received = networkStats.packetsReceived.load();
         int lost = networkStats.packetsLost.load();
 
-        metrics << "Packets Lost: " << lost << " packets | ";
-        metrics << "Connection Quality: " <<
-            ((sent > 0) ? (100.0f * (float)received / sent) : 0.0f) << "% response rate | ";
+        metrics << "Snapshots Lost: " << lost << " (" << ((received + lost > 0) ? (100.0f * lost / (received + lost)) : 0.0f)
+            << "%) | ";
+        metrics << "Server Updates per Input: " <<
+            ((sent > 0) ? ((float)received / sent) : 0.0f) << " | ";
         metrics << "Unacked Inputs: " << advancedPrediction.getUnackedInputCount() << " | ";
         metrics << "Network Queue: " << outgoingPackets.size() << " out / " << incomingPackets.size() << " in";
         metricsText.setString(metrics.str());
 
+        // Input-to-photon latency: keys read to the frame showing the local prediction, and to the
+        // first frame reconciled with a server snapshot that acknowledges them. Percentiles cover
+        // the recent window and histograms the whole run; refreshed once a second, since the
+        // percentiles sort the window
+        if (now - lastLatencyUpdate >= std::chrono::seconds(1)) {
+            lastLatencyUpdate = now;
+            const InputLatencyTracker& inputLatency = networkStats.inputLatency;
+            auto millis = [](std::chrono::nanoseconds value) { return value.count() / 1e6; };
+            std::stringstream latencyText;
+            latencyText << std::fixed << std::setprecision(1);
+            latencyText << "Input-to-photon (ms): local p50 " << millis(inputLatency.localToDisplay().recent.percentile(0.5))
+                << " p99 " << millis(inputLatency.localToDisplay().recent.percentile(0.99))
+                << " | server-confirmed p50 " << millis(inputLatency.serverConfirmed().recent.percentile(0.5))
+                << " p99 " << millis(inputLatency.serverConfirmed().recent.percentile(0.99))
+                << " (send " << millis(inputLatency.sampleToSend().recent.percentile(0.5))
+                << " + round trip " << millis(inputLatency.sendToAck().recent.percentile(0.5))
+                << " + reconcile " << millis(inputLatency.ackToReconcile().recent.percentile(0.5))
+                << " + display " << millis(inputLatency.reconcileToDisplay().recent.percentile(0.5)) << " at p50)\n";
+            latencyText << "Local: " << InputLatencyTracker::histogramText(inputLatency.localToDisplay().total)
+                << "   |   Confirmed: " << InputLatencyTracker::histogramText(inputLatency.serverConfirmed().total);
+            inputLatencyText.setString(latencyText.str());
+        }
+
         // l) Update connection status
         std::stringstream status;
         if (serverConnected) {
@@ -915,7 +1210,10 @@ int main() {
         statusText.setString(status.str());
 
         std::stringstream threadInfo;
-        threadInfo << "Threading: Main thread (rendering @ " << (int)(1.0f / frameDt) << " FPS) | Network thread (event-driven)";
+        threadInfo << "Threading: Main thread (rendering @ " << (int)(1.0f / frameDt) << " FPS, input latched "
+            << std::fixed << std::setprecision(1)
+            << std::chrono::duration<float, std::milli>(framePacer.predictedCost() + framePacer.config().margin).count()
+            << " ms before present, " << framePacer.missedDeadlines() << " deadlines missed) | Network thread (event-driven)";
         threadingText.setString(threadInfo.str());
 
         const auto& currentPreset = presetManager.getCurrentPreset();
@@ -957,6 +1255,7 @@ int main() {
             window.draw(statusText);
             window.draw(threadingText);
             window.draw(latencyPresetText);
+            window.draw(inputLatencyText);
             window.draw(instructionsText);
 
             for (size_t i = 0; i < presetBoxes.size(); ++i) {
@@ -983,18 +1282,21 @@ int main() {
         }
 
         window.display();
+        const auto presentedAt = std::chrono::steady_clock::now();
+        framePacer.endFrame(presentedAt);
+        networkStats.inputLatency.displayed(presentedAt);
     }
 
     // (11) Cleanup
     std::cout << "[" << getCurrentTimestamp() << "] Shutting down client..." << std::endl;
 
-    networkThreadRunning = false;
+    networkReactor.stop();
     netThread.join();
 
     std::cout << "Final statistics:" << std::endl;
     std::cout << "  Packets sent: " << networkStats.packetsSent.load() << std::endl;
     std::cout << "  Packets received: " << networkStats.packetsReceived.load() << std::endl;
-    std::cout << "  Packets lost (sequence gaps): " << networkStats.packetsLost.load() << std::endl;
+    std::cout << "  Snapshots lost (snapshot sequence gaps): " << networkStats.packetsLost.load() << std::endl;
     std::cout << "  Invalid packets: " << networkStats.invalidPacketsReceived.load() << std::endl;
     std::cout << "  Send errors: " << networkStats.sendErrors.load() << std::endl;
 
@@ -1003,13 +1305,23 @@ int main() {
     int finalLost = networkStats.packetsLost.load();
 
     if (finalSent > 0) {
-        std::cout << "  Connection response rate: " << std::setprecision(2) <<
-            (100.0f * (float)finalReceived / finalSent) << "%" << std::endl;
+        std::cout << "  Server updates per input: " << std::setprecision(2) <<
+            ((float)finalReceived / finalSent) << std::endl;
     }
     if (finalReceived > 0) {
-        std::cout << "  Actual packet loss rate: " << std::setprecision(2) <<
+        std::cout << "  Snapshot loss rate: " << std::setprecision(2) <<
             (100.0f * (float)finalLost / (finalReceived + finalLost)) << "%" << std::endl;
     }
+    std::cout << "  Input latency, local to display (recent): " << networkStats.inputLatency.localToDisplay().recent.summary() << std::endl;
+    std::cout << "  Input latency, server-confirmed (recent): " << networkStats.inputLatency.serverConfirmed().recent.summary() << std::endl;
+    std::cout << "  Frame pacing: " << framePacer.report() << std::endl;
+    if (exportInputLatency(networkStats.inputLatency)) {
+        std::cout << "  Input latency exported to input_latency.csv and input_latency_histograms.csv" << std::endl;
+        if (networkStats.inputLatency.recordsDropped() > 0) {
+            std::cout << "  (input_latency.csv holds the first " << networkStats.inputLatency.records().size()
+                << " inputs; " << networkStats.inputLatency.recordsDropped() << " later ones are only in the histograms)" << std::endl;
+        }
+    }
 
 #ifdef _WIN32
     closesocket(sock);
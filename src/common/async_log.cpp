@@ -0,0 +1,138 @@
+/**
+ * @file async_log.cpp
+ * @brief Record pool, drain thread and rate limiting for AsyncLog.
+ *
+ * @see async_log.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/async_log.hpp"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+
+namespace {
+    /** @brief "HH:MM:SS.mmm" in local time. */
+    void writeTimestamp(std::ostream& out, int64_t wallNs) {
+        const std::time_t seconds = static_cast<std::time_t>(wallNs / 1000000000);
+        const int64_t millis = (wallNs / 1000000) % 1000;
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        out << std::put_time(&local, "%H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << millis
+            << std::setfill(' ');
+    }
+}
+
+AsyncLog::AsyncLog(std::ostream& out, std::ostream& err, const Config& config)
+    : out_(out), err_(err), config_(config), full_(std::max<size_t>(config.capacity, 1)),
+      free_(std::max<size_t>(config.capacity, 1)) {
+    records_ = std::make_unique<Record[]>(full_.capacity());
+    for (size_t i = 0; i < full_.capacity(); ++i) {
+        free_.push(&records_[i]);
+    }
+    drainer_ = std::thread([this] { drainLoop(); });
+}
+
+AsyncLog::~AsyncLog() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        stopping_ = true;
+    }
+    stopCv_.notify_one();
+    drainer_.join();
+}
+
+AsyncLog::Line AsyncLog::info() {
+    return Line(*this, LogLevel::Info);
+}
+
+AsyncLog::Line AsyncLog::warn() {
+    return Line(*this, LogLevel::Warning);
+}
+
+void AsyncLog::drainLoop() {
+    // Wakes on its own schedule (the producer never signals), or at once when stopping
+    std::unique_lock<std::mutex> lock(stopMutex_);
+    while (!stopCv_.wait_for(lock, config_.drainInterval, [this] { return stopping_; })) {
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+    drain();  // The producer has stopped: write what it left
+}
+
+size_t AsyncLog::drain() {
+    size_t written = 0;
+    bool wroteOut = false, wroteErr = false;
+    Record* record = nullptr;
+    while (full_.pop(record)) {
+        std::ostream& stream = record->level == LogLevel::Warning ? err_ : out_;
+        stream << '[';
+        writeTimestamp(stream, record->wallNs);
+        stream << "] ";
+        stream.write(record->text, record->length);
+        stream << '\n';
+        (record->level == LogLevel::Warning ? wroteErr : wroteOut) = true;
+        free_.push(record);
+        ++written;
+    }
+    if (wroteOut) out_.flush();
+    if (wroteErr) err_.flush();
+    return written;
+}
+
+AsyncLog::Line::Line(AsyncLog& log, LogLevel level) : std::ostream(nullptr), log_(log), record_(nullptr) {
+    if (!log_.free_.pop(record_)) {
+        record_ = nullptr;
+        log_.dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;  // No buffer: the stream stays bad and ignores all output
+    }
+    record_->level = level;
+    record_->wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    buffer_.reset(record_->text, Record::TEXT_SIZE);
+    rdbuf(&buffer_);
+}
+
+AsyncLog::Line::~Line() {
+    if (!record_) {
+        return;
+    }
+    record_->length = static_cast<uint16_t>(buffer_.length());
+    log_.full_.push(record_);  // Cannot fail: the ring holds every record of the pool
+}
+
+LogRateLimit::LogRateLimit(uint32_t perWindow, std::chrono::steady_clock::duration window)
+    : perWindow_(perWindow), window_(window) {}
+
+bool LogRateLimit::allow(std::chrono::steady_clock::time_point now) {
+    if (now - windowStart_ >= window_) {
+        windowStart_ = now;
+        inWindow_ = 0;
+    }
+    if (inWindow_ < perWindow_) {
+        ++inWindow_;
+        return true;
+    }
+    ++suppressed_;
+    return false;
+}
+
+uint64_t LogRateLimit::takeSuppressed() {
+    const uint64_t suppressed = suppressed_;
+    suppressed_ = 0;
+    return suppressed;
+}
+
+std::ostream& operator<<(std::ostream& out, Suppressed suppressed) {
+    if (suppressed.count > 0) {
+        out << " (" << suppressed.count << " more suppressed)";
+    }
+    return out;
+}
@@ -0,0 +1,392 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implementation of the double-buffered checkpoint file and its writer thread.
+ *
+ * File layout (host byte order; the file is only read back on the same machine):
+ *
+ *   [FileHeader, padded to 4 KiB][slot 0][slot 1]
+ *   slot = [SlotHeader][payload, up to capacity bytes], padded to a multiple of 4 KiB
+ *
+ * @see checkpoint.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/checkpoint.hpp"
+#include "netcode/common/crc32c.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr uint32_t FILE_MAGIC = 0x4E434346;  // "NCCF"
+    constexpr uint32_t SLOT_MAGIC = 0x4E434353;  // "NCCS"
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr size_t ALIGNMENT = 4096;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;   // Payload bytes per slot
+    };
+
+    struct SlotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t generation;
+        uint64_t size;
+        uint64_t ticks;
+        int64_t savedAt;
+        int64_t savedAtWall;
+        uint32_t crc;        // Over the payload, then every field above
+        uint32_t reserved;
+    };
+
+    size_t alignUp(size_t n) {
+        return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    size_t slotStride(size_t capacity) {
+        return alignUp(sizeof(SlotHeader) + capacity);
+    }
+
+    size_t slotOffset(size_t capacity, int slot) {
+        return ALIGNMENT + static_cast<size_t>(slot) * slotStride(capacity);
+    }
+
+    size_t fileLength(size_t capacity) {
+        return slotOffset(capacity, 2);
+    }
+
+    uint32_t slotCrc(const SlotHeader& header, const char* payload) {
+        uint32_t crc = crc32c(payload, static_cast<size_t>(header.size));
+        return crc32c(&header, offsetof(SlotHeader, crc), crc);
+    }
+
+    /**
+     * @brief Returns the slot's header if it holds a complete checkpoint.
+     */
+    bool validSlot(const char* base, size_t length, size_t capacity, int slot, SlotHeader& header) {
+        const size_t offset = slotOffset(capacity, slot);
+        if (offset + sizeof(SlotHeader) > length) {
+            return false;
+        }
+        std::memcpy(&header, base + offset, sizeof(header));
+        return header.magic == SLOT_MAGIC && header.version == FORMAT_VERSION && header.size <= capacity &&
+            header.crc == slotCrc(header, base + offset + sizeof(SlotHeader));
+    }
+
+    /**
+     * @brief Finds the newest valid slot.
+     * @return Slot index, or -1 if neither is valid
+     */
+    int newestSlot(const char* base, size_t length, size_t capacity, SlotHeader& newest) {
+        int found = -1;
+        for (int slot = 0; slot < 2; ++slot) {
+            SlotHeader header;
+            if (validSlot(base, length, capacity, slot, header) && (found < 0 || header.generation > newest.generation)) {
+                newest = header;
+                found = slot;
+            }
+        }
+        return found;
+    }
+
+    bool validFileHeader(const char* base, size_t length, size_t& capacity) {
+        if (length < ALIGNMENT) {
+            return false;
+        }
+        FileHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        capacity = static_cast<size_t>(header.capacity);
+        return header.magic == FILE_MAGIC && header.version == FORMAT_VERSION && length >= fileLength(capacity);
+    }
+
+#ifndef _WIN32
+    /**
+     * @brief Synchronously flushes a byte range of a mapping (msync needs a page-aligned start).
+     */
+    bool syncRange(char* base, size_t offset, size_t length) {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t start = offset / page * page;
+        return msync(base + start, offset + length - start, MS_SYNC) == 0;
+    }
+#endif
+}
+
+#ifndef _WIN32
+
+bool readCheckpoint(const std::string& path, std::vector<char>& state, CheckpointInfo& info) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(ALIGNMENT)) {
+        close(fd);
+        return false;
+    }
+    const size_t length = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    size_t capacity = 0;
+    SlotHeader newest{};
+    int slot = -1;
+    if (validFileHeader(base, length, capacity)) {
+        slot = newestSlot(base, length, capacity, newest);
+    }
+    if (slot >= 0) {
+        const char* payload = base + slotOffset(capacity, slot) + sizeof(SlotHeader);
+        state.assign(payload, payload + newest.size);
+        info.generation = newest.generation;
+        info.ticks = newest.ticks;
+        info.savedAt = newest.savedAt;
+        info.savedAtWall = newest.savedAtWall;
+    }
+    munmap(mapping, length);
+    return slot >= 0;
+}
+
+CheckpointWriter::CheckpointWriter(std::string path, size_t capacity) : path_(std::move(path)) {
+    if (!mapExisting()) {
+        capacity_ = std::max<size_t>(capacity, 1);
+        if (!createFile(path_, capacity_, base_, length_)) {
+            base_ = nullptr;
+            return;
+        }
+    }
+    open_ = true;
+    thread_ = std::thread([this] { writerLoop(); });
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (base_) {
+        munmap(base_, length_);
+    }
+}
+
+bool CheckpointWriter::mapExisting() {
+    int fd = ::open(path_.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(ALIGNMENT)) {
+        close(fd);
+        return false;
+    }
+    const size_t length = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    char* base = static_cast<char*>(mapping);
+    size_t capacity = 0;
+    if (!validFileHeader(base, length, capacity)) {
+        munmap(mapping, length);
+        return false;  // Foreign or older format: start a new file
+    }
+    SlotHeader newest{};
+    latestSlot_ = newestSlot(base, length, capacity, newest);
+    generation_ = latestSlot_ >= 0 ? newest.generation : 0;
+    base_ = base;
+    length_ = length;
+    capacity_ = capacity;
+    return true;
+}
+
+bool CheckpointWriter::createFile(const std::string& path, size_t capacity, char*& base, size_t& length) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    length = fileLength(capacity);
+    if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        close(fd);
+        return false;
+    }
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<char*>(mapping);
+    const FileHeader header{ FILE_MAGIC, FORMAT_VERSION, capacity };
+    std::memcpy(base, &header, sizeof(header));
+    if (!syncRange(base, 0, sizeof(header))) {
+        munmap(base, length);
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointWriter::writeSlot(char* base, size_t capacity, int slot, const std::vector<char>& data,
+    uint64_t ticks, int64_t savedAt, int64_t savedAtWall) {
+    const size_t offset = slotOffset(capacity, slot);
+    char* payload = base + offset + sizeof(SlotHeader);
+
+    // Invalidate the slot, write and flush the payload, then commit it with the header
+    std::memset(base + offset, 0, sizeof(SlotHeader));
+    if (!data.empty()) {
+        std::memcpy(payload, data.data(), data.size());
+    }
+    if (!syncRange(base, offset, sizeof(SlotHeader) + data.size())) {
+        return false;
+    }
+
+    SlotHeader header{};
+    header.magic = SLOT_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.generation = generation_ + 1;
+    header.size = data.size();
+    header.ticks = ticks;
+    header.savedAt = savedAt;
+    header.savedAtWall = savedAtWall;
+    header.crc = slotCrc(header, payload);
+    std::memcpy(base + offset, &header, sizeof(header));
+    if (!syncRange(base, offset, sizeof(header))) {
+        return false;
+    }
+    generation_ = header.generation;
+    latestSlot_ = slot;
+    return true;
+}
+
+bool CheckpointWriter::grow(size_t needed, const std::vector<char>& data, uint64_t ticks,
+    int64_t savedAt, int64_t savedAtWall) {
+    // Build the larger file beside the old one and swap it in with an atomic rename,
+    // so a valid checkpoint exists on disk throughout
+    const size_t capacity = std::max(needed + needed / 2, capacity_ * 2);
+    const std::string temporary = path_ + ".tmp";
+    char* base = nullptr;
+    size_t length = 0;
+    if (!createFile(temporary, capacity, base, length)) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    if (!writeSlot(base, capacity, 0, data, ticks, savedAt, savedAtWall) ||
+        std::rename(temporary.c_str(), path_.c_str()) != 0) {
+        munmap(base, length);
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    munmap(base_, length_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    base_ = base;
+    length_ = length;
+    capacity_ = capacity;
+    return true;
+}
+
+void CheckpointWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return hasPending_ || stopping_; });
+        if (!hasPending_) {
+            return;  // Stopping with nothing left to write
+        }
+        std::swap(writing_, pending_);
+        const uint64_t ticks = pendingTicks_;
+        const int64_t savedAt = pendingSavedAt_;
+        const int64_t savedAtWall = pendingSavedAtWall_;
+        hasPending_ = false;
+        busy_ = true;
+        const size_t capacity = capacity_;
+        lock.unlock();
+
+        bool ok;
+        if (writing_.size() > capacity) {
+            ok = grow(writing_.size(), writing_, ticks, savedAt, savedAtWall);
+        }
+        else {
+            ok = writeSlot(base_, capacity, latestSlot_ == 0 ? 1 : 0, writing_, ticks, savedAt, savedAtWall);
+        }
+
+        lock.lock();
+        busy_ = false;
+        ok ? ++written_ : ++failures_;
+        idle_.notify_all();
+    }
+}
+
+#else
+
+bool readCheckpoint(const std::string&, std::vector<char>&, CheckpointInfo&) { return false; }
+
+CheckpointWriter::CheckpointWriter(std::string path, size_t) : path_(std::move(path)) {}
+CheckpointWriter::~CheckpointWriter() = default;
+bool CheckpointWriter::mapExisting() { return false; }
+bool CheckpointWriter::createFile(const std::string&, size_t, char*&, size_t&) { return false; }
+bool CheckpointWriter::writeSlot(char*, size_t, int, const std::vector<char>&, uint64_t, int64_t, int64_t) { return false; }
+bool CheckpointWriter::grow(size_t, const std::vector<char>&, uint64_t, int64_t, int64_t) { return false; }
+void CheckpointWriter::writerLoop() {}
+
+#endif
+
+void CheckpointWriter::submit(std::vector<char>& state, uint64_t ticks) {
+    if (!isOpen()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (hasPending_) {
+            ++superseded_;
+        }
+        std::swap(pending_, state);
+        pendingTicks_ = ticks;
+        pendingSavedAt_ = static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        pendingSavedAtWall_ = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        hasPending_ = true;
+    }
+    wake_.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !hasPending_ && !busy_; });
+}
+
+uint64_t CheckpointWriter::written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+uint64_t CheckpointWriter::superseded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return superseded_;
+}
+
+uint64_t CheckpointWriter::failures() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failures_;
+}
+
+size_t CheckpointWriter::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
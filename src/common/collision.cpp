@@ -0,0 +1,184 @@
+/**
+ * @file collision.cpp
+ * @brief Uniform grid binning, candidate pair enumeration and circle overlap resolution.
+ *
+ * @see collision.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/collision.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /** @brief Cell coordinate of a position; out-of-range and NaN positions go to the edge cells. */
+    inline uint32_t cellCoordinate(float position, float origin, float invCell, uint32_t cols) {
+        const float f = (position - origin) * invCell;
+        if (!(f > 0.0f)) {
+            return 0;
+        }
+        return f < static_cast<float>(cols) ? static_cast<uint32_t>(f) : cols - 1;
+    }
+}
+
+void CollisionGrid::build(const float* x, const float* y, size_t count, const CollisionParams& params) {
+    const float span = std::max(params.boundsMax - params.boundsMin, 0.0f);
+    const float diameter = 2.0f * params.radius;
+    // Cells at least one diameter wide: every overlap is within a cell or between neighbours.
+    // No more cells than entities either: empty cells cost a visit each, so a few players in a
+    // large world use a coarse grid
+    const float fit = diameter > 0.0f ? std::floor(span / diameter) : static_cast<float>(MAX_CELLS_PER_AXIS);
+    const float sparse = std::ceil(std::sqrt(static_cast<float>(count)));
+    cols_ = static_cast<uint32_t>(std::clamp(std::min(fit, sparse), 1.0f, static_cast<float>(MAX_CELLS_PER_AXIS)));
+    const float invCell = span > 0.0f ? static_cast<float>(cols_) / span : 0.0f;
+
+    // Counting sort by cell; positions are copied into cell order alongside their slots
+    cellStart_.assign(static_cast<size_t>(cols_) * cols_ + 1, 0);
+    cellOf_.resize(count);
+    for (size_t slot = 0; slot < count; ++slot) {
+        const uint32_t cell = cellCoordinate(y[slot], params.boundsMin, invCell, cols_) * cols_ +
+            cellCoordinate(x[slot], params.boundsMin, invCell, cols_);
+        cellOf_[slot] = cell;
+        ++cellStart_[cell + 1];
+    }
+    const size_t cells = static_cast<size_t>(cols_) * cols_;
+    for (size_t cell = 0; cell < cells; ++cell) {
+        cellStart_[cell + 1] += cellStart_[cell];
+    }
+    order_.resize(count);
+    sx_.resize(count);
+    sy_.resize(count);
+    for (size_t slot = 0; slot < count; ++slot) {
+        const uint32_t to = cellStart_[cellOf_[slot]]++;  // Advances each start to the next cell's start
+        order_[to] = static_cast<uint32_t>(slot);
+        sx_[to] = x[slot];
+        sy_[to] = y[slot];
+    }
+    for (size_t cell = cells; cell > 0; --cell) {
+        cellStart_[cell] = cellStart_[cell - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+template<typename Visit>
+void CollisionGrid::forEachCandidate(Visit&& visit) {
+    const uint32_t cols = cols_;
+    for (uint32_t cy = 0; cy < cols; ++cy) {
+        for (uint32_t cx = 0; cx < cols; ++cx) {
+            const uint32_t cell = cy * cols + cx;
+            const uint32_t begin = cellStart_[cell];
+            const uint32_t end = cellStart_[cell + 1];
+            if (begin == end) {
+                continue;
+            }
+            for (uint32_t i = begin; i < end; ++i) {
+                for (uint32_t j = i + 1; j < end; ++j) {
+                    visit(i, j);
+                }
+            }
+
+            // Forward neighbours only (all have higher cell indices), so each pair is seen once
+            auto against = [&](uint32_t other) {
+                const uint32_t otherBegin = cellStart_[other];
+                const uint32_t otherEnd = cellStart_[other + 1];
+                for (uint32_t i = begin; i < end; ++i) {
+                    for (uint32_t j = otherBegin; j < otherEnd; ++j) {
+                        visit(i, j);
+                    }
+                }
+            };
+            if (cx + 1 < cols) {
+                against(cell + 1);
+            }
+            if (cy + 1 < cols) {
+                if (cx > 0) {
+                    against(cell + cols - 1);
+                }
+                against(cell + cols);
+                if (cx + 1 < cols) {
+                    against(cell + cols + 1);
+                }
+            }
+        }
+    }
+}
+
+size_t CollisionGrid::resolve(float* x, float* y, size_t count, const CollisionParams& params) {
+    pairsTested_ = 0;
+    passes_ = 0;
+    const float diameter = 2.0f * params.radius;
+    const float diameterSq = diameter * diameter;
+    size_t firstContacts = 0;
+
+    for (uint32_t pass = 0; pass < params.iterations; ++pass) {
+        build(x, y, count, params);
+        float* sx = sx_.data();
+        float* sy = sy_.data();
+        const uint32_t* order = order_.data();
+        size_t contacts = 0;
+        uint64_t tested = 0;
+
+        forEachCandidate([&](uint32_t i, uint32_t j) {
+            ++tested;
+            const float dx = sx[j] - sx[i];
+            const float dy = sy[j] - sy[i];
+            const float distanceSq = dx * dx + dy * dy;
+            if (!(distanceSq < diameterSq)) {
+                return;
+            }
+            ++contacts;
+            float pushX;
+            float pushY;
+            if (distanceSq > 1e-12f) {
+                const float distance = std::sqrt(distanceSq);
+                const float half = 0.5f * (diameter - distance) / distance;
+                pushX = dx * half;
+                pushY = dy * half;
+            }
+            else {
+                // Same point: split along x, the lower slot to the left
+                pushX = order[i] < order[j] ? params.radius : -params.radius;
+                pushY = 0.0f;
+            }
+            sx[i] -= pushX;
+            sy[i] -= pushY;
+            sx[j] += pushX;
+            sy[j] += pushY;
+        });
+
+        for (size_t k = 0; k < count; ++k) {
+            x[order[k]] = std::min(params.boundsMax, std::max(params.boundsMin, sx[k]));
+            y[order[k]] = std::min(params.boundsMax, std::max(params.boundsMin, sy[k]));
+        }
+        pairsTested_ += tested;
+        ++passes_;
+        if (pass == 0) {
+            firstContacts = contacts;
+        }
+        if (contacts == 0) {
+            break;
+        }
+    }
+    return firstContacts;
+}
+
+void CollisionGrid::findContacts(const float* x, const float* y, size_t count, const CollisionParams& params,
+    std::vector<Contact>& contacts) {
+    contacts.clear();
+    build(x, y, count, params);
+    const float diameter = 2.0f * params.radius;
+    const float diameterSq = diameter * diameter;
+    uint64_t tested = 0;
+    forEachCandidate([&](uint32_t i, uint32_t j) {
+        ++tested;
+        const float dx = sx_[j] - sx_[i];
+        const float dy = sy_[j] - sy_[i];
+        const float distanceSq = dx * dx + dy * dy;
+        if (distanceSq < diameterSq) {
+            contacts.push_back({ std::min(order_[i], order_[j]), std::max(order_[i], order_[j]),
+                diameter - std::sqrt(distanceSq) });
+        }
+    });
+    pairsTested_ = tested;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file cpu_features.cpp
+ * @brief Implementation of runtime CPU feature detection.
+ *
+ * Uses the compiler builtins on GCC/Clang and CPUID/XGETBV on MSVC.
+ * Non-x86 targets always report the scalar tier.
+ *
+ * @see cpu_features.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/cpu_features.hpp"
+
+#if defined(NETCODE_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#if defined(NETCODE_X86) && defined(_MSC_VER) && !defined(__clang__)
+    /**
+     * @brief Queries CPUID directly (MSVC has no __builtin_cpu_supports).
+     * @param sse42 Output: SSE4.2 support
+     * @param avx2  Output: AVX2 support, including OS-enabled YMM state
+     */
+    void queryCpuid(bool& sse42, bool& avx2) {
+        int regs[4] = {};
+        __cpuid(regs, 0);
+        const int maxLeaf = regs[0];
+
+        __cpuid(regs, 1);
+        sse42 = (regs[2] & (1 << 20)) != 0;
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        const bool avx = (regs[2] & (1 << 28)) != 0;
+
+        avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx) {
+            // XCR0 bits 1 and 2: the OS saves XMM and YMM registers on context switch
+            const bool ymmEnabled = (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(regs, 7, 0);
+            avx2 = ymmEnabled && (regs[1] & (1 << 5)) != 0;
+        }
+    }
+#endif
+
+    struct CpuFeatures {
+        bool sse42 = false;
+        bool avx2 = false;
+
+        CpuFeatures() {
+#if defined(NETCODE_X86) && defined(_MSC_VER) && !defined(__clang__)
+            queryCpuid(sse42, avx2);
+#elif defined(NETCODE_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            sse42 = __builtin_cpu_supports("sse4.2") != 0;
+            avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+        }
+    };
+
+    const CpuFeatures& features() {
+        static const CpuFeatures detected;
+        return detected;
+    }
+}
+
+bool cpuHasSse42() {
+    return features().sse42;
+}
+
+bool cpuHasAvx2() {
+    return features().avx2;
+}
+
+SimdLevel bestSimdLevel() {
+#ifdef NETCODE_X86
+    static const SimdLevel level = cpuHasAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE;
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::SSE:
+        return "SSE";
+    default:
+        return "scalar";
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file entity_store.cpp
+ * @brief Implementation of the sparse-set entity store.
+ *
+ * @see entity_store.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/entity_store.hpp"
+
+namespace {
+    template<typename T>
+    void removeSlot(std::vector<T>& column, size_t slot) {
+        column[slot] = column.back();
+        column.pop_back();
+    }
+}
+
+void EntityStore::reserve(size_t n) {
+    sparse_.reserve(n);
+    generations_.reserve(n);
+    dense_.reserve(n);
+    x_.reserve(n);
+    y_.reserve(n);
+    vx_.reserve(n);
+    vy_.reserve(n);
+    seq_.reserve(n);
+}
+
+EntityId EntityStore::create() {
+    EntityId id;
+    if (!freeIndices_.empty()) {
+        id.index = freeIndices_.back();
+        freeIndices_.pop_back();
+    }
+    else {
+        id.index = static_cast<uint32_t>(sparse_.size());
+        sparse_.push_back(NO_SLOT);
+        generations_.push_back(0);
+    }
+    id.generation = generations_[id.index];
+    sparse_[id.index] = static_cast<uint32_t>(dense_.size());
+
+    dense_.push_back(id);
+    x_.push_back(0.0f);
+    y_.push_back(0.0f);
+    vx_.push_back(0.0f);
+    vy_.push_back(0.0f);
+    seq_.push_back(0);
+    return id;
+}
+
+size_t EntityStore::destroy(EntityId id) {
+    const size_t freed = slot(id);
+    if (freed == NPOS) {
+        return NPOS;
+    }
+
+    // Move the last entity into the freed slot to keep the columns dense
+    const EntityId moved = dense_.back();
+    sparse_[moved.index] = static_cast<uint32_t>(freed);
+    removeSlot(dense_, freed);
+    removeSlot(x_, freed);
+    removeSlot(y_, freed);
+    removeSlot(vx_, freed);
+    removeSlot(vy_, freed);
+    removeSlot(seq_, freed);
+
+    sparse_[id.index] = NO_SLOT;
+    ++generations_[id.index];  // Invalidates every copy of the destroyed id
+    freeIndices_.push_back(id.index);
+    return freed;
+}
+
+void EntityStore::clear() {
+    for (const EntityId& id : dense_) {
+        sparse_[id.index] = NO_SLOT;
+        ++generations_[id.index];
+        freeIndices_.push_back(id.index);
+    }
+    dense_.clear();
+    x_.clear();
+    y_.clear();
+    vx_.clear();
+    vy_.clear();
+    seq_.clear();
+}
+
+bool EntityStore::alive(EntityId id) const {
+    return slot(id) != NPOS;
+}
+
+size_t EntityStore::slot(EntityId id) const {
+    if (id.index >= sparse_.size() || generations_[id.index] != id.generation || sparse_[id.index] == NO_SLOT) {
+        return NPOS;
+    }
+    return sparse_[id.index];
+}
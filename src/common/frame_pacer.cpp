@@ -0,0 +1,91 @@
+/**
+ * @file frame_pacer.cpp
+ * @brief Present deadlines, frame cost prediction and late input latching.
+ *
+ * @see frame_pacer.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/frame_pacer.hpp"
+#include "netcode/common/tick_scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <thread>
+
+FramePacer::FramePacer(const Config& config, Clock::time_point first)
+    : config_(config),
+      deadline_(first == Clock::time_point::min() ? Clock::now() + config.period : first),
+      predicted_(std::chrono::duration_cast<Clock::duration>(config.period / 2)),
+      cost_(std::max<size_t>(config.statsWindow, 1)),
+      latchLateness_(std::max<size_t>(config.statsWindow, 1)) {
+    config_.costWindow = std::max<size_t>(config_.costWindow, 1);
+    recent_.reserve(config_.costWindow);
+}
+
+FramePacer::Clock::duration FramePacer::predictedCost() const {
+    const Clock::duration most = std::chrono::duration_cast<Clock::duration>(config_.period - config_.margin);
+    return std::clamp(predicted_, Clock::duration::zero(), std::max(most, Clock::duration::zero()));
+}
+
+void FramePacer::waitForLatch() const {
+    const Clock::time_point latch = latchTime();
+    const Clock::time_point spinStart = latch - config_.spinWindow;
+    if (Clock::now() < spinStart) {
+        TickScheduler::sleepUntil(spinStart);
+    }
+    while (Clock::now() < latch) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::beginFrame(Clock::time_point now) {
+    began_ = now;
+    latchLateness_.record(std::max(now - latchTime(), Clock::duration::zero()));
+}
+
+void FramePacer::endFrame(Clock::time_point now) {
+    const Clock::duration cost = now - began_;
+    cost_.record(cost);
+    ++frames_;
+    if (now > deadline_) {
+        ++missed_;
+    }
+
+    // Predict from the recent costs only, so the latch follows render cost as it changes
+    if (recent_.size() < config_.costWindow) {
+        recent_.push_back(cost);
+    }
+    else {
+        recent_[recentNext_] = cost;
+    }
+    recentNext_ = (recentNext_ + 1) % config_.costWindow;
+    sorted_.assign(recent_.begin(), recent_.end());
+    const double q = std::clamp(config_.costQuantile, 0.0, 1.0);
+    const size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(sorted_.size())));
+    const size_t index = std::min(rank > 0 ? rank - 1 : 0, sorted_.size() - 1);
+    std::nth_element(sorted_.begin(), sorted_.begin() + static_cast<std::ptrdiff_t>(index), sorted_.end());
+    predicted_ = sorted_[index];
+
+    // Next deadline on the grid; a frame that ran past one or more deadlines drops them
+    deadline_ += std::chrono::duration_cast<Clock::duration>(config_.period);
+    while (deadline_ <= now) {
+        deadline_ += std::chrono::duration_cast<Clock::duration>(config_.period);
+        ++skipped_;
+    }
+}
+
+std::string FramePacer::report() const {
+    auto millis = [](Clock::duration value) {
+        return std::chrono::duration<double, std::milli>(value).count();
+    };
+    std::ostringstream line;
+    line.setf(std::ios::fixed);
+    line.precision(2);
+    line << frames_ << " frames, cost p50 " << millis(cost_.percentile(0.5)) << " ms / p99 "
+        << millis(cost_.percentile(0.99)) << " ms, predicted " << millis(predictedCost()) << " ms, latch late p99 "
+        << millis(latchLateness_.percentile(0.99)) << " ms, " << missed_ << " missed and " << skipped_
+        << " skipped deadlines";
+    return line.str();
+}
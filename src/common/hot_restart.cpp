@@ -0,0 +1,368 @@
+/**
+ * @file hot_restart.cpp
+ * @brief Control socket, SCM_RIGHTS descriptor passing and shared memory state for hot restart.
+ *
+ * @see hot_restart.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/hot_restart.hpp"
+#include "netcode/common/crc32c.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    const char* CONTROL_SOCKET_NAME = "netcode-server.sock";
+
+    /**
+     * @brief True if dir is a real directory (not a symlink) owned by this user and closed to
+     *        everyone else, so nobody else can plant or replace a socket in it.
+     */
+    bool isPrivateDirectory(const std::string& dir) {
+        struct stat info;
+        return lstat(dir.c_str(), &info) == 0 && S_ISDIR(info.st_mode) && info.st_uid == geteuid() &&
+            (info.st_mode & (S_IRWXG | S_IRWXO)) == 0;
+    }
+
+    /** @brief True if the process at the other end of a Unix domain socket runs as this user. */
+    bool peerIsSameUser(int fd) {
+#ifdef __linux__
+        ucred cred{};
+        socklen_t len = sizeof(cred);
+        return getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0 && cred.uid == geteuid();
+#else
+        uid_t uid = 0;
+        gid_t gid = 0;
+        return getpeereid(fd, &uid, &gid) == 0 && uid == geteuid();
+#endif
+    }
+
+    bool makeAddress(const std::string& path, sockaddr_un& addr) {
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return false;
+        }
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    /**
+     * @brief Creates an anonymous shared memory segment holding a copy of bytes.
+     * @return Descriptor of the segment, or -1 on failure
+     */
+    int createSegment(const std::vector<char>& bytes) {
+#ifdef __linux__
+        int fd = memfd_create("netcode-handoff", MFD_CLOEXEC);
+#else
+        // No memfd: create a uniquely named object and unlink it at once
+        const std::string name = "/netcode-handoff-" + std::to_string(getpid());
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            shm_unlink(name.c_str());
+        }
+#endif
+        if (fd < 0) {
+            return -1;
+        }
+        if (bytes.empty()) {
+            return fd;
+        }
+        if (ftruncate(fd, static_cast<off_t>(bytes.size())) != 0) {
+            close(fd);
+            return -1;
+        }
+        void* mapping = mmap(nullptr, bytes.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        std::memcpy(mapping, bytes.data(), bytes.size());
+        munmap(mapping, bytes.size());
+        return fd;
+    }
+
+    /**
+     * @brief Copies size bytes out of a shared memory segment.
+     */
+    bool readSegment(int fd, size_t size, std::vector<char>& bytes) {
+        bytes.clear();
+        if (size == 0) {
+            return true;
+        }
+        // The size comes from the peer: check it against the segment before allocating
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < size) {
+            return false;
+        }
+        bytes.resize(size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        std::memcpy(bytes.data(), mapping, size);
+        munmap(mapping, size);
+        return true;
+    }
+}
+
+std::string controlSocketPath() {
+    // The per-user runtime directory (0700, owned by the user) if there is one, else a private
+    // directory of our own in /tmp; a shared, predictable path would let others take over
+    std::string dir;
+    const char* runtime = std::getenv("XDG_RUNTIME_DIR");
+    if (runtime && runtime[0] == '/') {
+        dir = runtime;
+    }
+    else {
+        dir = "/tmp/netcode-server-" + std::to_string(geteuid());
+        if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) {
+            return std::string();
+        }
+    }
+    if (!isPrivateDirectory(dir)) {
+        return std::string();
+    }
+    return dir + "/" + CONTROL_SOCKET_NAME;
+}
+
+int createControlListener(const std::string& path) {
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) {
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    // A previous server (or the one being replaced) may still own the path; the newest listener wins
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || chmod(path.c_str(), 0600) != 0 ||
+        listen(fd, 1) != 0 || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return fd;
+}
+
+int pollControlListener(int listener) {
+    if (listener < 0) {
+        return -1;
+    }
+    int peer = accept(listener, nullptr, nullptr);
+    if (peer < 0) {
+        return -1;
+    }
+    if (!peerIsSameUser(peer)) {
+        close(peer);  // Only the same user may take our socket and state
+        return -1;
+    }
+    // The listener is non-blocking; the handoff itself uses blocking I/O
+    fcntl(peer, F_SETFL, fcntl(peer, F_GETFL, 0) & ~O_NONBLOCK);
+    return peer;
+}
+
+TakeoverWatcher::TakeoverWatcher(int listener) : listener_(listener) {
+    if (listener_ >= 0) {
+        running_ = true;
+        thread_ = std::thread([this] { watchLoop(); });
+    }
+}
+
+TakeoverWatcher::~TakeoverWatcher() {
+    stop();
+}
+
+int TakeoverWatcher::poll() {
+    if (pending_.load(std::memory_order_relaxed) < 0) {
+        return -1;
+    }
+    return pending_.exchange(-1, std::memory_order_acquire);
+}
+
+void TakeoverWatcher::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    thread_.join();
+    const int peer = pending_.exchange(-1);
+    if (peer >= 0) {
+        close(peer);
+    }
+}
+
+void TakeoverWatcher::watchLoop() {
+    // Short timeouts keep stop() prompt; a takeover waits at most this long to be noticed
+    constexpr long WAIT_MICROS = 50000;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (pending_.load(std::memory_order_acquire) >= 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(WAIT_MICROS));  // Not taken yet
+            continue;
+        }
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(listener_, &readSet);
+        timeval tv{ 0, WAIT_MICROS };
+        if (select(listener_ + 1, &readSet, nullptr, nullptr, &tv) > 0) {
+            const int peer = pollControlListener(listener_);
+            if (peer >= 0) {
+                pending_.store(peer, std::memory_order_release);
+            }
+        }
+    }
+}
+
+bool handOff(int peer, const std::vector<int>& fds, const std::vector<char>& state, HandoffHeader header) {
+    if (fds.size() > MAX_HANDOFF_FDS) {
+        return false;
+    }
+    const int segment = createSegment(state);
+    if (segment < 0) {
+        return false;
+    }
+
+    header.magic = HandoffHeader::MAGIC;
+    header.version = HandoffHeader::VERSION;
+    header.fdCount = static_cast<uint32_t>(fds.size());
+    header.stateSize = state.size();
+    header.stateCrc = crc32c(state.data(), state.size());
+
+    std::vector<int> passed(fds);
+    passed.push_back(segment);
+
+    iovec iov{ &header, sizeof(header) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * (MAX_HANDOFF_FDS + 1))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * passed.size());
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * passed.size());
+    std::memcpy(CMSG_DATA(cmsg), passed.data(), sizeof(int) * passed.size());
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(peer, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    close(segment);  // The receiver holds its own reference now
+    return sent == static_cast<ssize_t>(sizeof(header));
+}
+
+bool awaitAck(int peer, std::chrono::milliseconds timeout) {
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET(peer, &readSet);
+    timeval tv;
+    tv.tv_sec = static_cast<long>(timeout.count() / 1000);
+    tv.tv_usec = static_cast<long>((timeout.count() % 1000) * 1000);
+    if (select(peer + 1, &readSet, nullptr, nullptr, &tv) <= 0) {
+        return false;
+    }
+    char ack = 0;
+    return recv(peer, &ack, 1, 0) == 1 && ack == 'K';
+}
+
+int takeOver(const std::string& path, std::vector<int>& fds, std::vector<char>& state, HandoffHeader& header) {
+    fds.clear();
+    state.clear();
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) {
+        return -1;
+    }
+    int peer = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (peer < 0) {
+        return -1;
+    }
+    // Only accept state from a server running as the same user
+    if (connect(peer, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || !peerIsSameUser(peer)) {
+        close(peer);
+        return -1;
+    }
+
+    // The old server answers on its next tick; give up if it never does
+    timeval tv{ 5, 0 };
+    setsockopt(peer, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    iovec iov{ &header, sizeof(header) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * (MAX_HANDOFF_FDS + 1))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = recvmsg(peer, &msg, 0);
+    } while (received < 0 && errno == EINTR);
+
+    std::vector<int> passed;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const size_t offset = passed.size();
+            passed.resize(offset + count);
+            std::memcpy(passed.data() + offset, CMSG_DATA(cmsg), count * sizeof(int));
+        }
+    }
+
+    bool ok = received == static_cast<ssize_t>(sizeof(header)) && !(msg.msg_flags & MSG_CTRUNC) &&
+        header.magic == HandoffHeader::MAGIC && header.version == HandoffHeader::VERSION &&
+        passed.size() == header.fdCount + 1;
+    if (ok) {
+        ok = readSegment(passed.back(), static_cast<size_t>(header.stateSize), state) &&
+            crc32c(state.data(), state.size()) == header.stateCrc;
+    }
+    if (!passed.empty()) {
+        close(passed.back());  // State segment: copied out (or rejected)
+        passed.pop_back();
+    }
+    if (!ok) {
+        for (int fd : passed) close(fd);
+        state.clear();
+        close(peer);
+        return -1;
+    }
+    fds = passed;
+    return peer;
+}
+
+bool sendAck(int peer) {
+    const char ack = 'K';
+    const bool ok = send(peer, &ack, 1, MSG_NOSIGNAL) == 1;
+    close(peer);
+    return ok;
+}
+
+#else
+
+std::string controlSocketPath() { return std::string(); }
+int createControlListener(const std::string&) { return -1; }
+int pollControlListener(int) { return -1; }
+TakeoverWatcher::TakeoverWatcher(int listener) : listener_(listener) {}
+TakeoverWatcher::~TakeoverWatcher() = default;
+int TakeoverWatcher::poll() { return -1; }
+void TakeoverWatcher::stop() {}
+void TakeoverWatcher::watchLoop() {}
+bool handOff(int, const std::vector<int>&, const std::vector<char>&, HandoffHeader) { return false; }
+bool awaitAck(int, std::chrono::milliseconds) { return false; }
+int takeOver(const std::string&, std::vector<int>&, std::vector<char>&, HandoffHeader&) { return -1; }
+bool sendAck(int) { return false; }
+
+#endif
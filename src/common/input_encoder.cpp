@@ -0,0 +1,40 @@
+/**
+ * @file input_encoder.cpp
+ * @brief Send decisions for change-driven input transmission.
+ *
+ * @see input_encoder.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/input_encoder.hpp"
+
+InputEncoder::InputEncoder(const Config& config) : config_(config) {}
+
+InputSend InputEncoder::sample(float inputX, float inputY, std::chrono::steady_clock::time_point now) {
+    ++frames_;
+    const auto sinceSend = now - lastSend_;
+    InputSend send = InputSend::None;
+    if (!started_ || inputX != lastX_ || inputY != lastY_) {
+        send = InputSend::Change;
+        ++changes_;
+        repeatsLeft_ = config_.redundancy;
+        started_ = true;
+        lastX_ = inputX;
+        lastY_ = inputY;
+    }
+    else if (repeatsLeft_ > 0 && sinceSend >= config_.repeatInterval) {
+        send = InputSend::Repeat;
+        ++repeats_;
+        --repeatsLeft_;
+    }
+    else if (sinceSend >= config_.heartbeat) {
+        send = InputSend::Heartbeat;
+        ++heartbeats_;
+    }
+
+    if (send != InputSend::None) {
+        lastSend_ = now;
+    }
+    return send;
+}
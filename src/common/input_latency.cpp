@@ -0,0 +1,177 @@
+/**
+ * @file input_latency.cpp
+ * @brief Stage bookkeeping, distributions and CSV export for InputLatencyTracker.
+ *
+ * @see input_latency.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/input_latency.hpp"
+#include <algorithm>
+
+namespace {
+    int64_t toTicks(std::chrono::steady_clock::time_point t) {
+        return t.time_since_epoch().count();
+    }
+
+    std::chrono::steady_clock::time_point fromTicks(int64_t ticks) {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ticks));
+    }
+
+    /** @brief Whole milliseconds of a histogram bound. */
+    long long millis(std::chrono::nanoseconds bound) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(bound).count();
+    }
+
+    /** @brief Microseconds from a to b, or -1 if either is unset. */
+    long long micros(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        if (a == std::chrono::steady_clock::time_point() || b == std::chrono::steady_clock::time_point()) {
+            return -1;
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    }
+}
+
+InputLatencyTracker::Distribution::Distribution(size_t window, const std::vector<std::chrono::milliseconds>& buckets)
+    : recent(std::max<size_t>(window, 1)),
+      total(std::vector<std::chrono::nanoseconds>(buckets.begin(), buckets.end())) {}
+
+void InputLatencyTracker::Distribution::record(Clock::duration value) {
+    recent.record(value);
+    total.record(value);
+}
+
+InputLatencyTracker::InputLatencyTracker(const Config& config)
+    : capacity_(std::max<size_t>(config.capacity, 1)), maxRecords_(config.maxRecords),
+      slots_(new Slot[std::max<size_t>(config.capacity, 1)]),
+      localToDisplay_(config.window, config.buckets), serverConfirmed_(config.window, config.buckets),
+      sampleToSend_(config.window, config.buckets), sendToAck_(config.window, config.buckets),
+      ackToReconcile_(config.window, config.buckets), reconcileToDisplay_(config.window, config.buckets) {}
+
+void InputLatencyTracker::sampled(Clock::time_point at) {
+    frameSampled_ = at;
+}
+
+void InputLatencyTracker::queued(uint32_t seq, Clock::time_point sampledAt) {
+    Slot& slot = slotOf(seq);
+    slot.sent.store(0, std::memory_order_relaxed);
+    slot.acked.store(0, std::memory_order_relaxed);
+    slot.sampled.store(toTicks(sampledAt), std::memory_order_relaxed);
+    slot.seq.store(seq, std::memory_order_release);
+}
+
+void InputLatencyTracker::sent(uint32_t seq, Clock::time_point at) {
+    Slot& slot = slotOf(seq);
+    if (slot.seq.load(std::memory_order_acquire) == seq) {
+        slot.sent.store(toTicks(at), std::memory_order_release);
+    }
+}
+
+void InputLatencyTracker::acked(uint32_t seq, Clock::time_point at) {
+    if (seq <= lastAcked_) {
+        return;  // Already acknowledged, e.g. a snapshot of held input
+    }
+    const uint32_t oldest = seq - std::min<uint32_t>(seq - lastAcked_, static_cast<uint32_t>(capacity_)) + 1;
+    for (uint32_t s = oldest; s <= seq; ++s) {
+        Slot& slot = slotOf(s);
+        if (slot.seq.load(std::memory_order_acquire) == s) {
+            slot.acked.store(toTicks(at), std::memory_order_release);
+        }
+    }
+    lastAcked_ = seq;
+}
+
+void InputLatencyTracker::reconciled(uint32_t seq, Clock::time_point at) {
+    if (seq <= lastReconciled_) {
+        return;
+    }
+    const uint32_t oldest = seq - std::min<uint32_t>(seq - lastReconciled_, static_cast<uint32_t>(capacity_)) + 1;
+    for (uint32_t s = oldest; s <= seq; ++s) {
+        if (slotOf(s).seq.load(std::memory_order_acquire) == s) {
+            awaitingDisplay_.emplace_back(s, at);
+        }
+    }
+    lastReconciled_ = seq;
+}
+
+void InputLatencyTracker::displayed(Clock::time_point at) {
+    if (frameSampled_ != Clock::time_point()) {
+        localToDisplay_.record(at - frameSampled_);
+        frameSampled_ = Clock::time_point();
+    }
+
+    for (const auto& [seq, reconciledAt] : awaitingDisplay_) {
+        Slot& slot = slotOf(seq);
+        if (slot.seq.load(std::memory_order_acquire) != seq) {
+            continue;  // Overwritten by a much newer input
+        }
+        const Record record{ seq, fromTicks(slot.sampled.load(std::memory_order_relaxed)),
+            fromTicks(slot.sent.load(std::memory_order_acquire)), fromTicks(slot.acked.load(std::memory_order_acquire)),
+            reconciledAt, at };
+        serverConfirmed_.record(at - record.sampled);
+        reconcileToDisplay_.record(at - reconciledAt);
+        if (record.sent != Clock::time_point()) {
+            sampleToSend_.record(record.sent - record.sampled);
+        }
+        if (record.acked != Clock::time_point()) {
+            ackToReconcile_.record(reconciledAt - record.acked);
+            if (record.sent != Clock::time_point()) {
+                sendToAck_.record(record.acked - record.sent);
+            }
+        }
+        if (records_.size() < maxRecords_) {
+            records_.push_back(record);
+        }
+        else {
+            ++recordsDropped_;
+        }
+    }
+    awaitingDisplay_.clear();
+}
+
+std::string InputLatencyTracker::histogramText(const LatencyHistogram& histogram) {
+    const auto& bounds = histogram.bounds();
+    const auto& counts = histogram.counts();
+    std::string text;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (!text.empty()) {
+            text += "  ";
+        }
+        text += i < bounds.size() ? "<" + std::to_string(millis(bounds[i])) : ">=" + std::to_string(millis(bounds.back()));
+        text += ": " + std::to_string(counts[i]);
+    }
+    return text;
+}
+
+void InputLatencyTracker::exportCsv(std::ostream& out) const {
+    out << "seq,sample_to_send_us,send_to_ack_us,ack_to_reconcile_us,reconcile_to_display_us,confirmed_us\n";
+    for (const Record& r : records_) {
+        out << r.seq << ',' << micros(r.sampled, r.sent) << ',' << micros(r.sent, r.acked) << ','
+            << micros(r.acked, r.reconciled) << ',' << micros(r.reconciled, r.displayed) << ','
+            << micros(r.sampled, r.displayed) << '\n';
+    }
+}
+
+void InputLatencyTracker::exportHistograms(std::ostream& out) const {
+    const std::pair<const char*, const Distribution*> distributions[] = {
+        { "local_to_display", &localToDisplay_ }, { "server_confirmed", &serverConfirmed_ },
+        { "sample_to_send", &sampleToSend_ }, { "send_to_ack", &sendToAck_ },
+        { "ack_to_reconcile", &ackToReconcile_ }, { "reconcile_to_display", &reconcileToDisplay_ },
+    };
+    out << "distribution,upper_ms,count\n";
+    for (const auto& [name, distribution] : distributions) {
+        const auto& bounds = distribution->total.bounds();
+        const auto& counts = distribution->total.counts();
+        for (size_t i = 0; i < counts.size(); ++i) {
+            out << name << ',';
+            if (i < bounds.size()) {
+                out << millis(bounds[i]);
+            }
+            else {
+                out << "inf";
+            }
+            out << ',' << counts[i] << '\n';
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file io_pipeline.cpp
+ * @brief PacketPipe buffer pool and the receive/send threads of IoThreads.
+ *
+ * @see io_pipeline.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/io_pipeline.hpp"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <vector>
+
+namespace {
+    // How long an idle I/O thread sleeps before checking whether it should stop
+    constexpr auto IDLE_WAIT = std::chrono::milliseconds(5);
+
+    /** @brief Adds the growth of a transport counter since the last call to a shared counter. */
+    void accumulate(std::atomic<uint64_t>& shared, uint64_t current, uint64_t& last) {
+        if (current != last) {
+            shared.fetch_add(current - last, std::memory_order_relaxed);
+            last = current;
+        }
+    }
+}
+
+PacketPipe::PacketPipe(size_t capacity) : full_(capacity), free_(capacity) {
+    buffers_ = std::make_unique<PacketBuffer[]>(full_.capacity());
+    for (size_t i = 0; i < full_.capacity(); ++i) {
+        free_.push(&buffers_[i]);
+    }
+}
+
+PacketBuffer* PacketPipe::acquire() {
+    PacketBuffer* buffer = nullptr;
+    free_.pop(buffer);
+    return buffer;
+}
+
+void PacketPipe::publish(PacketBuffer* buffer) {
+    // Cannot fail: the ring holds every buffer of the pool
+    full_.push(buffer);
+}
+
+void PacketPipe::notify() {
+    // Pairs with the fence in wait(): either the consumer sees the buffer or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        sleepCv_.notify_one();
+    }
+}
+
+PacketBuffer* PacketPipe::poll() {
+    PacketBuffer* buffer = nullptr;
+    full_.pop(buffer);
+    return buffer;
+}
+
+void PacketPipe::release(PacketBuffer* buffer) {
+    free_.push(buffer);
+}
+
+bool PacketPipe::wait(std::chrono::microseconds timeout) {
+    if (timeout <= std::chrono::microseconds(0)) {
+        return !full_.empty();
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = sleepCv_.wait_for(lock, timeout, [this] { return !full_.empty(); });
+    sleeping_.store(false, std::memory_order_relaxed);
+    return ready;
+}
+
+IoThreads::IoThreads(SocketHandle sock, TransportKind kind, size_t capacity)
+    : sock_(sock), kind_(kind), inbound_(capacity), outbound_(capacity) {}
+
+IoThreads::~IoThreads() {
+    stop();
+}
+
+bool IoThreads::start() {
+    if (running_) {
+        return false;
+    }
+    running_ = true;
+
+    // Each thread creates its own transport: an io_uring ring belongs to the thread that set it up
+    std::promise<std::string> receiverReady;
+    std::promise<void> senderReady;
+    receiver_ = std::thread([this, &receiverReady] {
+        std::unique_ptr<DatagramTransport> transport = makeTransport(sock_, kind_);
+        receiverReady.set_value(transport->name());
+        receiveLoop(*transport);
+    });
+    sender_ = std::thread([this, &senderReady] {
+        // Send-only: a second receiving transport would take datagrams the send loop never reads
+        std::unique_ptr<DatagramTransport> transport = makeTransport(sock_, kind_, false);
+        senderReady.set_value();
+        sendLoop(*transport);
+    });
+    transportName_ = receiverReady.get_future().get();
+    senderReady.get_future().get();
+    return true;
+}
+
+void IoThreads::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    receiver_.join();
+    sender_.join();
+}
+
+void IoThreads::receiveLoop(DatagramTransport& transport) {
+    std::vector<ReceivedDatagram> batch;
+    uint64_t received = 0;
+    uint64_t kernelDrops = 0;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (transport.receive(batch, IDLE_WAIT) == 0) {
+            continue;
+        }
+        const auto arrival = std::chrono::steady_clock::now();
+        const int64_t arrivalWall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        for (const ReceivedDatagram& datagram : batch) {
+            PacketBuffer* buffer = inbound_.acquire();
+            if (!buffer) {
+                counters_.inboundDrops.fetch_add(1, std::memory_order_relaxed);  // The simulation is behind
+                continue;
+            }
+            buffer->addr = datagram.addr;
+            buffer->size = datagram.size;
+            buffer->truncated = datagram.truncated;
+            buffer->kernelQueueNs = datagram.kernelTime > 0 ? std::max<int64_t>(arrivalWall - datagram.kernelTime, 0) : -1;
+            buffer->arrival = arrival;
+            std::memcpy(buffer->data, datagram.data, datagram.size);
+            inbound_.publish(buffer);
+        }
+        inbound_.notify();
+        accumulate(counters_.received, transport.stats().received, received);
+        accumulate(counters_.kernelDrops, transport.stats().kernelDrops, kernelDrops);
+    }
+}
+
+void IoThreads::sendLoop(DatagramTransport& transport) {
+    uint64_t sent = 0;
+    uint64_t sendErrors = 0;
+    size_t queued = 0;
+    while (true) {
+        if (PacketBuffer* buffer = outbound_.poll()) {
+            transport.send(buffer->addr, buffer->data, buffer->size);
+            outbound_.release(buffer);
+            ++queued;
+            continue;
+        }
+        // Nothing more published: everything taken so far leaves in one flush
+        if (queued > 0) {
+            transport.flush();
+            queued = 0;
+        }
+        accumulate(counters_.sent, transport.stats().sent, sent);
+        accumulate(counters_.sendErrors, transport.stats().sendErrors, sendErrors);
+        if (!running_.load(std::memory_order_acquire)) {
+            break;  // stop() runs on the producer thread, so nothing is published after this
+        }
+        outbound_.wait(IDLE_WAIT);
+    }
+}
@@ -0,0 +1,468 @@
+/**
+ * @file io_uring_transport.cpp
+ * @brief IoUringTransport: ring setup with raw syscalls, multishot recvmsg, batched sendmsg.
+ *
+ * @see io_uring_transport.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/io_uring_transport.hpp"
+
+#ifdef __linux__
+#include <netinet/udp.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+namespace {
+    // user_data tags; send completions carry their slot index
+    constexpr uint64_t RECEIVE_TAG = 1ull << 63;
+    constexpr uint64_t CANCEL_TAG = 1ull << 62;
+    constexpr uint64_t PROVIDE_TAG = 1ull << 61;
+
+    // Buffer groups: the registered ring, and classic provided buffers when the ring does not work
+    constexpr uint16_t RING_GROUP = 0;
+    constexpr uint16_t PROVIDED_GROUP = 1;
+
+    // Where the source address and control messages start in a receive buffer (see PAYLOAD_OFFSET)
+    constexpr size_t NAME_OFFSET = sizeof(io_uring_recvmsg_out);
+    constexpr size_t CONTROL_OFFSET = NAME_OFFSET + sizeof(sockaddr_in);
+    static_assert((IoUringTransport::BUFFER_COUNT & (IoUringTransport::BUFFER_COUNT - 1)) == 0,
+        "Buffer ring size must be a power of two");
+
+    int ioUringSetup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringRegister(int fd, unsigned opcode, const void* arg, unsigned count) {
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    template <typename T>
+    T* ringField(void* base, uint32_t offset) {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+    }
+}
+
+std::unique_ptr<IoUringTransport> IoUringTransport::create(SocketHandle sock, bool receive) {
+    if (sock < 0) {
+        return nullptr;
+    }
+    std::unique_ptr<IoUringTransport> transport(new IoUringTransport());
+    if (!transport->setup(sock, receive)) {
+        return nullptr;
+    }
+    if (!receive) {
+        return transport;
+    }
+
+    // Kernels without multishot recvmsg reject the request at once
+    transport->armReceive();
+    transport->enter(0, IORING_ENTER_GETEVENTS, std::chrono::microseconds(0));
+    transport->reap();
+    if (!transport->armed_ && (transport->receiveError_ == -EINVAL || transport->receiveError_ == -EOPNOTSUPP)) {
+        return nullptr;
+    }
+    return transport;
+}
+
+bool IoUringTransport::setup(SocketHandle sock, bool receive) {
+    params_.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SINGLE_ISSUER;
+    params_.cq_entries = CQ_ENTRIES;
+    ringFd_ = ioUringSetup(SQ_ENTRIES, &params_);
+    if (ringFd_ < 0) {
+        // Older kernels lack the optional flags
+        params_ = io_uring_params{};
+        params_.flags = IORING_SETUP_CQSIZE;
+        params_.cq_entries = CQ_ENTRIES;
+        ringFd_ = ioUringSetup(SQ_ENTRIES, &params_);
+    }
+    if (ringFd_ < 0) {
+        return false;
+    }
+    const unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_EXT_ARG;
+    if ((params_.features & required) != required) {
+        return false;
+    }
+
+    // Submission and completion rings share one mapping
+    const size_t sqSize = params_.sq_off.array + params_.sq_entries * sizeof(unsigned);
+    const size_t cqSize = params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+    ringMapSize_ = std::max(sqSize, cqSize);
+    void* ring = mmap(nullptr, ringMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        return false;
+    }
+    ringMap_ = ring;
+    sqHead_ = ringField<unsigned>(ring, params_.sq_off.head);
+    sqTail_ = ringField<unsigned>(ring, params_.sq_off.tail);
+    sqArray_ = ringField<unsigned>(ring, params_.sq_off.array);
+    sqMask_ = *ringField<unsigned>(ring, params_.sq_off.ring_mask);
+    sqLocalTail_ = *sqTail_;
+    cqHead_ = ringField<unsigned>(ring, params_.cq_off.head);
+    cqTail_ = ringField<unsigned>(ring, params_.cq_off.tail);
+    cqes_ = ringField<io_uring_cqe>(ring, params_.cq_off.cqes);
+    cqMask_ = *ringField<unsigned>(ring, params_.cq_off.ring_mask);
+
+    sqesSize_ = params_.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    // Requests name the socket by index 0 in the registered file table
+    const int fd = sock;
+    if (ioUringRegister(ringFd_, IORING_REGISTER_FILES, &fd, 1) < 0) {
+        return false;
+    }
+
+    receiving_ = receive;
+    if (receiving_ && !setupReceive(sock)) {
+        return false;
+    }
+
+    slots_.resize(SEND_SLOTS);
+    freeSlots_.reserve(SEND_SLOTS);
+    for (uint32_t i = SEND_SLOTS; i-- > 0;) {
+        SendSlot& slot = slots_[i];
+        std::memset(&slot.msg, 0, sizeof(msghdr));
+        slot.msg.msg_name = &slot.addr;
+        slot.msg.msg_namelen = sizeof(sockaddr_in);
+        slot.msg.msg_iov = &slot.iov;
+        slot.msg.msg_iovlen = 1;
+        slot.iov.iov_base = slot.data;
+        freeSlots_.push_back(i);
+    }
+    return true;
+}
+
+bool IoUringTransport::setupReceive(SocketHandle sock) {
+    // Each receive buffer holds one datagram: undo UDP_GRO a SocketTransport may have set
+    // on this socket (such as one in the process this server took over from)
+    const int gro = 0;
+    setsockopt(sock, SOL_UDP, UDP_GRO, &gro, sizeof(gro));
+    enableReceiveMetadata(sock);
+
+    // Buffer ring entries first (page aligned), the buffers after them
+    const size_t ringBytes = BUFFER_COUNT * sizeof(io_uring_buf);
+    bufferRingSize_ = ringBytes + size_t(BUFFER_COUNT) * BUFFER_SIZE;
+    void* buffers = mmap(nullptr, bufferRingSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED) {
+        return false;
+    }
+    bufferRing_ = static_cast<io_uring_buf_ring*>(buffers);
+    buffers_ = static_cast<char*>(buffers) + ringBytes;
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<uint64_t>(bufferRing_);
+    registration.ring_entries = BUFFER_COUNT;
+    registration.bgid = RING_GROUP;
+    if (ioUringRegister(ringFd_, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+        return false;
+    }
+    bufferRingRegistered_ = true;
+
+    std::vector<uint16_t> all(BUFFER_COUNT);
+    for (unsigned i = 0; i < BUFFER_COUNT; ++i) {
+        all[i] = static_cast<uint16_t>(i);
+    }
+    recycle(all);
+
+    receiveMsg_.msg_namelen = sizeof(sockaddr_in);
+    receiveMsg_.msg_controllen = METADATA_CONTROL;
+    pending_.reserve(BUFFER_COUNT);
+    pendingBuffers_.reserve(BUFFER_COUNT);
+    heldBuffers_.reserve(BUFFER_COUNT);
+    return true;
+}
+
+IoUringTransport::~IoUringTransport() {
+    if (sqes_ && cqes_) {
+        flush();
+        for (int i = 0; i < 100 && freeSlots_.size() < slots_.size(); ++i) {
+            enter(1, IORING_ENTER_GETEVENTS, std::chrono::milliseconds(10));
+            reap();
+        }
+        if (armed_) {
+            // Stop taking datagrams off the socket before the ring goes away
+            if (io_uring_sqe* sqe = nextSqe()) {
+                sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                sqe->fd = -1;
+                sqe->addr = RECEIVE_TAG;
+                sqe->user_data = CANCEL_TAG;
+            }
+            for (int i = 0; i < 100 && armed_; ++i) {
+                enter(1, IORING_ENTER_GETEVENTS, std::chrono::milliseconds(10));
+                reap();
+            }
+        }
+    }
+    if (bufferRingRegistered_) {
+        io_uring_buf_reg registration{};
+        registration.bgid = RING_GROUP;
+        ioUringRegister(ringFd_, IORING_UNREGISTER_PBUF_RING, &registration, 1);
+    }
+    if (ringFd_ >= 0) {
+        close(ringFd_);
+    }
+    if (bufferRing_) {
+        munmap(bufferRing_, bufferRingSize_);
+    }
+    if (sqes_) {
+        munmap(sqes_, sqesSize_);
+    }
+    if (ringMap_) {
+        munmap(ringMap_, ringMapSize_);
+    }
+}
+
+unsigned IoUringTransport::unsubmitted() const {
+    return sqLocalTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+}
+
+io_uring_sqe* IoUringTransport::nextSqe() {
+    if (unsubmitted() >= params_.sq_entries) {
+        enter(0, 0, std::chrono::microseconds(0));
+        if (unsubmitted() >= params_.sq_entries) {
+            return nullptr;
+        }
+    }
+    const unsigned index = sqLocalTail_ & sqMask_;
+    sqArray_[index] = index;
+    ++sqLocalTail_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+}
+
+int IoUringTransport::enter(unsigned minComplete, unsigned flags, std::chrono::microseconds timeout) {
+    __atomic_store_n(sqTail_, sqLocalTail_, __ATOMIC_RELEASE);
+    const unsigned toSubmit = unsubmitted();
+    ++stats_.syscalls;
+    if (minComplete == 0) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, toSubmit, 0, flags, nullptr, 0));
+    }
+    __kernel_timespec ts{};
+    ts.tv_sec = timeout.count() / 1000000;
+    ts.tv_nsec = (timeout.count() % 1000000) * 1000;
+    io_uring_getevents_arg arg{};
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete,
+        flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+}
+
+void IoUringTransport::armReceive() {
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) {
+        return;
+    }
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = 0;
+    sqe->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->addr = reinterpret_cast<uint64_t>(&receiveMsg_);
+    sqe->len = 1;
+    sqe->buf_group = providedBuffers_ ? PROVIDED_GROUP : RING_GROUP;
+    sqe->user_data = RECEIVE_TAG;
+    armed_ = true;
+    receiveError_ = 0;
+}
+
+void IoUringTransport::reap() {
+    unsigned head = *cqHead_;
+    const unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes_[head & cqMask_];
+        if (cqe.user_data == CANCEL_TAG || cqe.user_data == PROVIDE_TAG) {
+            continue;
+        }
+        if (cqe.user_data != RECEIVE_TAG) {
+            freeSlots_.push_back(static_cast<uint32_t>(cqe.user_data));
+            if (cqe.res < 0) {
+                ++stats_.sendErrors;
+            }
+            else {
+                ++stats_.sent;
+            }
+            continue;
+        }
+
+        if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            armed_ = false;  // Re-armed by the next receive() (after buffers are returned)
+            if (cqe.res < 0) {
+                receiveError_ = cqe.res;
+            }
+            if (cqe.res == -ENOBUFS && !providedBuffers_
+                && pendingBuffers_.size() + heldBuffers_.size() < BUFFER_COUNT) {
+                useProvidedBuffers();  // The ring had free buffers but the kernel did not take them
+            }
+        }
+        if (cqe.res < 0 || !(cqe.flags & IORING_CQE_F_BUFFER)) {
+            continue;
+        }
+        const uint16_t bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        pendingBuffers_.push_back(bufferId);
+        const char* buffer = buffers_ + size_t(bufferId) * BUFFER_SIZE;
+        if (static_cast<size_t>(cqe.res) < PAYLOAD_OFFSET) {
+            continue;
+        }
+        io_uring_recvmsg_out out;
+        std::memcpy(&out, buffer, sizeof(out));
+        msghdr control{};
+        control.msg_control = const_cast<char*>(buffer + CONTROL_OFFSET);
+        control.msg_controllen = std::min<size_t>(out.controllen, METADATA_CONTROL);
+        ReceivedDatagram datagram;
+        std::memcpy(&datagram.addr, buffer + NAME_OFFSET, sizeof(sockaddr_in));
+        datagram.kernelTime = readMetadata(control).kernelTime;
+        datagram.data = buffer + PAYLOAD_OFFSET;
+        datagram.size = std::min<size_t>({ out.payloadlen, cqe.res - PAYLOAD_OFFSET, MAX_DATAGRAM });
+        datagram.truncated = (out.flags & MSG_TRUNC) != 0 || out.payloadlen > MAX_DATAGRAM;
+        pending_.push_back(datagram);
+        ++stats_.received;
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+}
+
+void IoUringTransport::recycle(std::vector<uint16_t>& bufferIds) {
+    if (bufferIds.empty()) {
+        return;
+    }
+    if (providedBuffers_) {
+        provideBuffers(bufferIds);
+        return;
+    }
+    // Only addr, len and bid: the ring tail shares the first entry's reserved field
+    for (uint16_t id : bufferIds) {
+        io_uring_buf& entry = bufferRing_->bufs[bufferTail_ & (BUFFER_COUNT - 1)];
+        entry.addr = reinterpret_cast<uint64_t>(buffers_ + size_t(id) * BUFFER_SIZE);
+        entry.len = BUFFER_SIZE;
+        entry.bid = id;
+        ++bufferTail_;
+    }
+    __atomic_store_n(&bufferRing_->tail, bufferTail_, __ATOMIC_RELEASE);
+    bufferIds.clear();
+}
+
+void IoUringTransport::provideBuffers(std::vector<uint16_t>& bufferIds) {
+    // One request per run of consecutive ids
+    std::sort(bufferIds.begin(), bufferIds.end());
+    size_t start = 0;
+    while (start < bufferIds.size()) {
+        size_t end = start + 1;
+        while (end < bufferIds.size() && bufferIds[end] == bufferIds[end - 1] + 1) {
+            ++end;
+        }
+        if (io_uring_sqe* sqe = nextSqe()) {
+            sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+            sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+            sqe->fd = static_cast<int>(end - start);
+            sqe->addr = reinterpret_cast<uint64_t>(buffers_ + size_t(bufferIds[start]) * BUFFER_SIZE);
+            sqe->len = BUFFER_SIZE;
+            sqe->off = bufferIds[start];
+            sqe->buf_group = PROVIDED_GROUP;
+            sqe->user_data = PROVIDE_TAG;
+        }
+        start = end;
+    }
+    bufferIds.clear();
+}
+
+void IoUringTransport::useProvidedBuffers() {
+    io_uring_buf_reg registration{};
+    registration.bgid = RING_GROUP;
+    ioUringRegister(ringFd_, IORING_UNREGISTER_PBUF_RING, &registration, 1);
+    bufferRingRegistered_ = false;
+    providedBuffers_ = true;
+
+    // Every buffer not behind a pending or returned datagram goes to the new group
+    std::vector<bool> inUse(BUFFER_COUNT, false);
+    for (uint16_t id : pendingBuffers_) inUse[id] = true;
+    for (uint16_t id : heldBuffers_) inUse[id] = true;
+    std::vector<uint16_t> free;
+    for (unsigned id = 0; id < BUFFER_COUNT; ++id) {
+        if (!inUse[id]) free.push_back(static_cast<uint16_t>(id));
+    }
+    provideBuffers(free);
+}
+
+size_t IoUringTransport::receive(std::vector<ReceivedDatagram>& batch, std::chrono::microseconds timeout) {
+    batch.clear();
+    recycle(heldBuffers_);
+    if (!armed_ && receiving_) {
+        armReceive();
+    }
+    reap();
+    if (pending_.empty()) {
+        // One kernel entry submits queued requests and waits
+        const bool wait = timeout.count() > 0;
+        enter(wait ? 1 : 0, IORING_ENTER_GETEVENTS, timeout);
+        reap();
+    }
+    else if (unsubmitted() > 0) {
+        enter(0, 0, std::chrono::microseconds(0));
+    }
+    batch.swap(pending_);
+    heldBuffers_.swap(pendingBuffers_);
+    return batch.size();
+}
+
+bool IoUringTransport::send(const sockaddr_in& to, const char* data, size_t size) {
+    if (size > MAX_DATAGRAM) {
+        return false;
+    }
+    if (freeSlots_.empty()) {
+        // Every slot in flight: submit and wait for completions (received datagrams stay pending)
+        flush();
+        for (int i = 0; i < 100 && freeSlots_.empty(); ++i) {
+            enter(1, IORING_ENTER_GETEVENTS, std::chrono::milliseconds(10));
+            reap();
+        }
+        if (freeSlots_.empty()) {
+            ++stats_.sendErrors;
+            return false;
+        }
+    }
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) {
+        ++stats_.sendErrors;
+        return false;
+    }
+    const uint32_t index = freeSlots_.back();
+    freeSlots_.pop_back();
+    SendSlot& slot = slots_[index];
+    slot.addr = to;
+    slot.iov.iov_len = size;
+    std::memcpy(slot.data, data, size);
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = 0;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+    sqe->len = 1;
+    sqe->user_data = index;
+    ++queued_;
+    return true;
+}
+
+size_t IoUringTransport::flush() {
+    const size_t count = queued_;
+    queued_ = 0;
+    if (unsubmitted() > 0) {
+        enter(0, 0, std::chrono::microseconds(0));
+    }
+    // Take the completions already posted (most sends complete during submission), so a
+    // send-only transport keeps its slots and counters current without a receive()
+    reap();
+    return count;
+}
+
+const char* IoUringTransport::name() const {
+    return providedBuffers_ ? "io_uring (provided buffers)" : "io_uring";
+}
+#endif
@@ -0,0 +1,186 @@
+/**
+ * @file job_system.cpp
+ * @brief Implementation of the work-stealing job system.
+ *
+ * Job lookup order for a worker: own deque (newest first), own inbox, then
+ * other workers' deques (oldest first) and finally other workers' inboxes.
+ * Idle workers sleep on a condition variable guarded by an epoch counter, so
+ * a submission racing with a worker going to sleep is never lost.
+ *
+ * @see job_system.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/job_system.hpp"
+
+namespace {
+    struct WorkerIdentity {
+        const JobSystem* system = nullptr;
+        size_t index = JobSystem::NOT_A_WORKER;
+    };
+
+    thread_local WorkerIdentity currentIdentity;
+}
+
+JobSystem::JobSystem(size_t workers, WorkerStart onStart) : onStart_(std::move(onStart)) {
+    workers = std::max<size_t>(workers, 1);
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        workers_[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCv_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+size_t JobSystem::currentWorker() const {
+    return currentIdentity.system == this ? currentIdentity.index : NOT_A_WORKER;
+}
+
+void JobSystem::execute(Job* jobs, size_t count) {
+    Batch batch;
+    batch.pending.store(count, std::memory_order_relaxed);
+    const size_t self = currentWorker();
+    batch.externalWaiter = (self == NOT_A_WORKER);
+    for (size_t i = 0; i < count; ++i) {
+        jobs[i].batch = &batch;
+    }
+
+    if (batch.externalWaiter) {
+        for (size_t i = 0; i < count; ++i) {
+            Worker& target = *workers_[jobs[i].affinity % workers_.size()];
+            std::lock_guard<std::mutex> lock(target.inboxMutex);
+            target.inbox.push_back(&jobs[i]);
+        }
+        notifyWork();
+
+        std::unique_lock<std::mutex> lock(batch.mutex);
+        batch.cv.wait(lock, [&] { return batch.done; });
+        return;
+    }
+
+    // On a worker: spawn onto our own deque, run the first job, then help until the batch is done
+    Worker& worker = *workers_[self];
+    for (size_t i = 1; i < count; ++i) {
+        if (!worker.deque.push(&jobs[i])) {
+            runJob(&jobs[i]);
+        }
+    }
+    notifyWork();
+    runJob(&jobs[0]);
+
+    while (batch.pending.load(std::memory_order_acquire) > 0) {
+        if (Job* job = findJob(self)) {
+            runJob(job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::runJob(Job* job) {
+    job->invoke(job->context, job->begin, job->end);
+
+    // The waiter may return as soon as pending reaches zero; read what we need first
+    Batch* batch = job->batch;
+    const bool external = batch->externalWaiter;
+    if (batch->pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && external) {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        batch->done = true;
+        batch->cv.notify_all();
+    }
+}
+
+JobSystem::Job* JobSystem::takeFromInbox(Worker& worker, bool own) {
+    std::lock_guard<std::mutex> lock(worker.inboxMutex);
+    if (worker.inbox.empty()) {
+        return nullptr;
+    }
+    if (!own) {
+        Job* job = worker.inbox.back();
+        worker.inbox.pop_back();
+        return job;
+    }
+
+    // Owner: keep the first job and move the rest to the deque where they can be stolen lock-free
+    Job* job = worker.inbox.front();
+    size_t moved = 1;
+    while (moved < worker.inbox.size() && worker.deque.push(worker.inbox[moved])) {
+        ++moved;
+    }
+    worker.inbox.erase(worker.inbox.begin(), worker.inbox.begin() + static_cast<std::ptrdiff_t>(moved));
+    return job;
+}
+
+JobSystem::Job* JobSystem::findJob(size_t self) {
+    Worker& worker = *workers_[self];
+    if (Job* job = worker.deque.pop()) {
+        return job;
+    }
+    if (Job* job = takeFromInbox(worker, true)) {
+        return job;
+    }
+
+    const size_t n = workers_.size();
+    for (size_t offset = 1; offset < n; ++offset) {
+        if (Job* job = workers_[(self + offset) % n]->deque.steal()) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    for (size_t offset = 1; offset < n; ++offset) {
+        if (Job* job = takeFromInbox(*workers_[(self + offset) % n], false)) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::notifyWork() {
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        sleepCv_.notify_all();
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    currentIdentity.system = this;
+    currentIdentity.index = index;
+    if (onStart_) {
+        onStart_(index);
+    }
+
+    while (true) {
+        const uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        if (Job* job = findJob(index)) {
+            runJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (stopping_) {
+            return;
+        }
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        sleepCv_.wait(lock, [&] { return stopping_ || epoch_.load(std::memory_order_seq_cst) != epoch; });
+        sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+        if (stopping_) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,284 @@
+/**
+ * @file latency_profile.cpp
+ * @brief Core pinning, NUMA placement, socket tuning and tick jitter statistics.
+ *
+ * @see latency_profile.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/latency_profile.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <netinet/ip.h>
+#endif
+#ifdef __linux__
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    int socketOption(SocketHandle sock, int level, int name) {
+        int value = 0;
+#ifdef _WIN32
+        int size = sizeof(value);
+        getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &size);
+#else
+        socklen_t size = sizeof(value);
+        getsockopt(sock, level, name, &value, &size);
+#endif
+        return value;
+    }
+
+    bool setSocketOption(SocketHandle sock, int level, int name, int value) {
+        return setsockopt(sock, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) == 0;
+    }
+
+    /**
+     * @brief Sets a buffer size, forcing it past the system maximum when permitted.
+     */
+    int setBuffer(SocketHandle sock, int option, int forceOption, int bytes) {
+        if (bytes > 0) {
+            // The kernel doubles the value it is given (bookkeeping overhead), so ask for half
+            if (forceOption < 0 || !setSocketOption(sock, SOL_SOCKET, forceOption, bytes / 2)) {
+                setSocketOption(sock, SOL_SOCKET, option, bytes / 2);
+            }
+        }
+        return socketOption(sock, SOL_SOCKET, option);
+    }
+}
+
+SocketProfileResult applySocketProfile(SocketHandle sock, const LatencyProfile& profile) {
+    SocketProfileResult result;
+#ifdef __linux__
+    if (profile.busyPollMicros > 0) {
+        result.busyPoll = setSocketOption(sock, SOL_SOCKET, SO_BUSY_POLL, profile.busyPollMicros);
+    }
+    result.receiveBufferBytes = setBuffer(sock, SO_RCVBUF, SO_RCVBUFFORCE, profile.receiveBufferBytes);
+    result.sendBufferBytes = setBuffer(sock, SO_SNDBUF, SO_SNDBUFFORCE, profile.sendBufferBytes);
+#else
+    result.receiveBufferBytes = setBuffer(sock, SO_RCVBUF, -1, profile.receiveBufferBytes);
+    result.sendBufferBytes = setBuffer(sock, SO_SNDBUF, -1, profile.sendBufferBytes);
+#endif
+    if (profile.dscp >= 0) {
+        // DSCP is the upper six bits of the TOS byte (Windows ignores IP_TOS without policy)
+        result.dscp = setSocketOption(sock, IPPROTO_IP, IP_TOS, (profile.dscp & 0x3F) << 2);
+    }
+    return result;
+}
+
+std::vector<int> parseCoreList(const std::string& list) {
+    std::vector<int> cores;
+    std::stringstream stream(list);
+    std::string part;
+    while (std::getline(stream, part, ',')) {
+        part.erase(std::remove_if(part.begin(), part.end(), [](char c) { return c == ' ' || c == '\n'; }), part.end());
+        if (part.empty()) {
+            continue;
+        }
+        int first = 0;
+        int last = 0;
+        char dash = 0;
+        std::istringstream range(part);
+        range >> first;
+        if (range.fail() || first < 0) {
+            return {};
+        }
+        last = first;
+        if (range >> dash) {
+            if (dash != '-' || !(range >> last) || last < first) {
+                return {};
+            }
+        }
+        if (!range.eof()) {
+            return {};
+        }
+        for (int core = first; core <= last; ++core) {
+            cores.push_back(core);
+        }
+    }
+    return cores;
+}
+
+#ifdef __linux__
+bool pinCurrentThread(int core) {
+    if (core < 0 || core >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+int currentCore() {
+    return sched_getcpu();
+}
+
+int numaNodeOfCore(int core) {
+    // The core's sysfs directory has a nodeN link; without one the machine has no NUMA
+    const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(core);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return -1;
+    }
+    int node = 0;
+    while (dirent* entry = readdir(dir)) {
+        int value = 0;
+        if (std::sscanf(entry->d_name, "node%d", &value) == 1) {
+            node = value;
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+std::vector<int> coresOfNode(int node) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (file && std::getline(file, list)) {
+        return parseCoreList(list);
+    }
+    // No NUMA information: every online core
+    std::ifstream online("/sys/devices/system/cpu/online");
+    if (node == 0 && online && std::getline(online, list)) {
+        return parseCoreList(list);
+    }
+    return {};
+}
+
+bool preferLocalMemory(int node) {
+    if (node < 0 || node >= static_cast<int>(8 * sizeof(unsigned long))) {
+        return false;
+    }
+    const unsigned long mask = 1ul << node;
+    return syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, 8 * sizeof(mask)) == 0;
+}
+#else
+bool pinCurrentThread(int) { return false; }
+int currentCore() { return -1; }
+int numaNodeOfCore(int) { return -1; }
+std::vector<int> coresOfNode(int) { return {}; }
+bool preferLocalMemory(int) { return false; }
+#endif
+
+CorePlan planCores(const LatencyProfile& profile, size_t workers) {
+    std::vector<int> cores = profile.cores;
+    if (cores.empty()) {
+        const int here = currentCore();
+        if (here < 0) {
+            return { -1, std::vector<int>(std::max<size_t>(workers, 1), -1) };
+        }
+        cores = coresOfNode(std::max(numaNodeOfCore(here), 0));
+        // Server thread stays where it already runs
+        cores.erase(std::remove(cores.begin(), cores.end(), here), cores.end());
+        cores.insert(cores.begin(), here);
+    }
+
+    if (workers == 0) {
+        workers = std::max<size_t>(cores.size() - 1, 1);
+    }
+    CorePlan plan;
+    plan.server = cores.front();
+    for (size_t i = 0; i < workers; ++i) {
+        plan.workers.push_back(cores.size() > 1 ? cores[1 + i % (cores.size() - 1)] : cores.front());
+    }
+    return plan;
+}
+
+void JitterStats::record(std::chrono::nanoseconds lateness) {
+    if (window_ == 0 || samples_.size() < window_) {
+        samples_.push_back(lateness.count());
+    }
+    else {
+        samples_[next_] = lateness.count();
+        next_ = (next_ + 1) % window_;
+    }
+    max_ = std::max(max_, lateness);
+    dirty_ = true;
+}
+
+std::chrono::nanoseconds JitterStats::percentile(double q) const {
+    if (samples_.empty()) {
+        return std::chrono::nanoseconds(0);
+    }
+    if (dirty_) {
+        sorted_ = samples_;
+        std::sort(sorted_.begin(), sorted_.end());
+        dirty_ = false;
+    }
+    const double clamped = std::min(std::max(q, 0.0), 1.0);
+    const size_t index = static_cast<size_t>(clamped * (sorted_.size() - 1) + 0.5);
+    return std::chrono::nanoseconds(sorted_[index]);
+}
+
+std::string JitterStats::summary() const {
+    auto micros = [](std::chrono::nanoseconds value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.1f", value.count() / 1000.0);
+        return std::string(text);
+    };
+    return "p50 " + micros(percentile(0.5)) + " us, p99 " + micros(percentile(0.99)) + " us, max "
+        + micros(max_) + " us over " + std::to_string(count()) + " ticks";
+}
+
+std::vector<size_t> JitterStats::histogram(const std::vector<std::chrono::nanoseconds>& bounds) const {
+    std::vector<size_t> counts(bounds.size() + 1, 0);
+    for (const int64_t sample : samples_) {
+        const auto bucket = std::upper_bound(bounds.begin(), bounds.end(), std::chrono::nanoseconds(sample));
+        ++counts[static_cast<size_t>(bucket - bounds.begin())];
+    }
+    return counts;
+}
+
+void JitterStats::reset() {
+    samples_.clear();
+    next_ = 0;
+    sorted_.clear();
+    dirty_ = false;
+    max_ = std::chrono::nanoseconds(0);
+}
+
+LatencyHistogram::LatencyHistogram(std::vector<std::chrono::nanoseconds> bounds)
+    : bounds_(std::move(bounds)), counts_(bounds_.size() + 1, 0) {}
+
+void LatencyHistogram::record(std::chrono::nanoseconds delay) {
+    const auto bucket = std::upper_bound(bounds_.begin(), bounds_.end(), delay);
+    ++counts_[static_cast<size_t>(bucket - bounds_.begin())];
+    ++count_;
+    max_ = std::max(max_, delay);
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double q) const {
+    if (count_ == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    // Same rank as JitterStats::percentile(), found by walking the buckets
+    const double clamped = std::min(std::max(q, 0.0), 1.0);
+    const uint64_t rank = static_cast<uint64_t>(clamped * static_cast<double>(count_ - 1) + 0.5);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bounds_.size(); ++i) {
+        seen += counts_[i];
+        if (seen > rank) {
+            return std::min(bounds_[i], max_);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    max_ = std::chrono::nanoseconds(0);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file load_governor.cpp
+ * @brief Load measurement windows, shedding levels and their transitions.
+ *
+ * @see load_governor.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/load_governor.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+const char* loadLevelName(LoadLevel level) {
+    switch (level) {
+    case LoadLevel::Normal: return "normal";
+    case LoadLevel::ReduceIdle: return "reduce-idle";
+    case LoadLevel::CoalesceInputs: return "coalesce-inputs";
+    case LoadLevel::ShedConnections: return "shed-connections";
+    }
+    return "unknown";
+}
+
+LoadGovernor::LoadGovernor(const LoadBudget& budget, Listener listener)
+    : budget_(budget), listener_(std::move(listener)) {}
+
+void LoadGovernor::recordPacket(std::chrono::nanoseconds took) {
+    packetTotal_ += took;
+    ++packets_;
+}
+
+LoadShedding LoadGovernor::sheddingFor(LoadLevel level, const LoadBudget& budget) {
+    LoadShedding shedding;
+    if (level >= LoadLevel::ReduceIdle) {
+        shedding.idleResponseInterval = std::max<uint32_t>(budget.idleResponseInterval, 1);
+    }
+    if (level >= LoadLevel::CoalesceInputs) {
+        shedding.coalesceInputs = true;
+    }
+    if (level >= LoadLevel::ShedConnections) {
+        shedding.admitNewClients = false;
+    }
+    return shedding;
+}
+
+LoadLevel LoadGovernor::endWindow(std::chrono::nanoseconds tickTime) {
+    const std::chrono::nanoseconds packetTime = packets_ ? packetTotal_ / static_cast<int64_t>(packets_) : std::chrono::nanoseconds(0);
+    const double tickLoad = budget_.perTick.count() > 0 ? double(tickTime.count()) / budget_.perTick.count() : 0.0;
+    const double packetLoad = budget_.perPacket.count() > 0 ? double(packetTime.count()) / budget_.perPacket.count() : 0.0;
+    load_ = std::max(tickLoad, packetLoad);
+    packetTotal_ = std::chrono::nanoseconds(0);
+    packets_ = 0;
+    ++windowsAt_[static_cast<size_t>(level_)];
+
+    // Escalate quickly, recover slowly; a window between the thresholds resets both runs
+    overRun_ = load_ > 1.0 ? overRun_ + 1 : 0;
+    calmRun_ = load_ < budget_.recoverBelow ? calmRun_ + 1 : 0;
+    if (overRun_ >= budget_.escalateAfter && level_ != LoadLevel::ShedConnections) {
+        change(static_cast<LoadLevel>(static_cast<uint8_t>(level_) + 1), tickTime, packetTime);
+    }
+    else if (calmRun_ >= budget_.recoverAfter && level_ != LoadLevel::Normal) {
+        change(static_cast<LoadLevel>(static_cast<uint8_t>(level_) - 1), tickTime, packetTime);
+    }
+    ++windows_;
+    return level_;
+}
+
+void LoadGovernor::change(LoadLevel to, std::chrono::nanoseconds tickTime, std::chrono::nanoseconds packetTime) {
+    const LoadTransition transition{ level_, to, sheddingFor(to, budget_), load_, tickTime, packetTime, windows_ };
+    level_ = to;
+    overRun_ = 0;
+    calmRun_ = 0;
+    ++transitions_;
+    if (listener_) {
+        listener_(transition);
+    }
+}
+
+std::string LoadGovernor::report() const {
+    std::ostringstream text;
+    text << "load " << std::fixed << std::setprecision(2) << load_ << " (" << loadLevelName(level_) << "), "
+        << transitions_ << " transitions, windows";
+    for (size_t level = 0; level < LOAD_LEVELS; ++level) {
+        text << " " << loadLevelName(static_cast<LoadLevel>(level)) << ":" << windowsAt_[level];
+    }
+    return text.str();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file movement_kernel.cpp
+ * @brief Scalar, SSE and AVX2 integrate-and-clamp kernels.
+ *
+ * Bit-exactness with the scalar path relies on two details:
+ * - The position update is a separate multiply and add. The AVX2 kernel is
+ *   compiled for "avx2" only (not "fma"), so it cannot be contracted.
+ * - MAXPS/MINPS return the second operand when either is NaN, so
+ *   min(hi, max(lo, v)) yields v for NaN v, matching std::clamp(v, lo, hi),
+ *   which also returns v when neither comparison holds. For -0.0 against a
+ *   +0.0 bound both sides likewise keep v.
+ *
+ * @see movement_kernel.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/movement_kernel.hpp"
+#include <algorithm>
+
+#ifdef NETCODE_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    void integrateScalar(const MovementColumns& c, size_t begin, size_t count, const MovementParams& p) {
+        for (size_t i = begin; i < count; ++i) {
+            const float step = std::clamp(c.dt[i], 0.0f, p.maxStep);
+            c.vx[i] = std::clamp(c.inputX[i], -1.0f, 1.0f) * p.moveSpeed;
+            c.vy[i] = std::clamp(c.inputY[i], -1.0f, 1.0f) * p.moveSpeed;
+            c.x[i] = std::clamp(c.x[i] + c.vx[i] * step, p.boundsMin, p.boundsMax);
+            c.y[i] = std::clamp(c.y[i] + c.vy[i] * step, p.boundsMin, p.boundsMax);
+        }
+    }
+
+#ifdef NETCODE_X86
+    NETCODE_TARGET_SSE2
+    inline __m128 clampSse(__m128 v, __m128 lo, __m128 hi) {
+        return _mm_min_ps(hi, _mm_max_ps(lo, v));
+    }
+
+    NETCODE_TARGET_SSE2
+    size_t integrateSse(const MovementColumns& c, size_t count, const MovementParams& p) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        const __m128 maxStep = _mm_set1_ps(p.maxStep);
+        const __m128 speed = _mm_set1_ps(p.moveSpeed);
+        const __m128 lo = _mm_set1_ps(p.boundsMin);
+        const __m128 hi = _mm_set1_ps(p.boundsMax);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 step = clampSse(_mm_loadu_ps(&c.dt[i]), zero, maxStep);
+            const __m128 vx = _mm_mul_ps(clampSse(_mm_loadu_ps(&c.inputX[i]), minusOne, one), speed);
+            const __m128 vy = _mm_mul_ps(clampSse(_mm_loadu_ps(&c.inputY[i]), minusOne, one), speed);
+            _mm_storeu_ps(&c.vx[i], vx);
+            _mm_storeu_ps(&c.vy[i], vy);
+            _mm_storeu_ps(&c.x[i], clampSse(_mm_add_ps(_mm_loadu_ps(&c.x[i]), _mm_mul_ps(vx, step)), lo, hi));
+            _mm_storeu_ps(&c.y[i], clampSse(_mm_add_ps(_mm_loadu_ps(&c.y[i]), _mm_mul_ps(vy, step)), lo, hi));
+        }
+        return i;
+    }
+
+    NETCODE_TARGET_AVX2
+    inline __m256 clampAvx2(__m256 v, __m256 lo, __m256 hi) {
+        return _mm256_min_ps(hi, _mm256_max_ps(lo, v));
+    }
+
+    NETCODE_TARGET_AVX2
+    size_t integrateAvx2(const MovementColumns& c, size_t count, const MovementParams& p) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 minusOne = _mm256_set1_ps(-1.0f);
+        const __m256 maxStep = _mm256_set1_ps(p.maxStep);
+        const __m256 speed = _mm256_set1_ps(p.moveSpeed);
+        const __m256 lo = _mm256_set1_ps(p.boundsMin);
+        const __m256 hi = _mm256_set1_ps(p.boundsMax);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 step = clampAvx2(_mm256_loadu_ps(&c.dt[i]), zero, maxStep);
+            const __m256 vx = _mm256_mul_ps(clampAvx2(_mm256_loadu_ps(&c.inputX[i]), minusOne, one), speed);
+            const __m256 vy = _mm256_mul_ps(clampAvx2(_mm256_loadu_ps(&c.inputY[i]), minusOne, one), speed);
+            _mm256_storeu_ps(&c.vx[i], vx);
+            _mm256_storeu_ps(&c.vy[i], vy);
+            _mm256_storeu_ps(&c.x[i], clampAvx2(_mm256_add_ps(_mm256_loadu_ps(&c.x[i]), _mm256_mul_ps(vx, step)), lo, hi));
+            _mm256_storeu_ps(&c.y[i], clampAvx2(_mm256_add_ps(_mm256_loadu_ps(&c.y[i]), _mm256_mul_ps(vy, step)), lo, hi));
+        }
+        return i;
+    }
+#endif
+}
+
+void integrateAndClamp(const MovementColumns& columns, size_t count, const MovementParams& params, SimdLevel level) {
+    // Vector kernels handle whole groups of 4/8 lanes; the scalar loop finishes the tail
+    size_t done = 0;
+#ifdef NETCODE_X86
+    if (level == SimdLevel::AVX2 && cpuHasAvx2()) {
+        done = integrateAvx2(columns, count, params);
+    }
+    else if (level != SimdLevel::Scalar) {
+        done = integrateSse(columns, count, params);
+    }
+#else
+    (void)level;
+#endif
+    integrateScalar(columns, done, count, params);
+}
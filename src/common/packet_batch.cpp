@@ -0,0 +1,139 @@
+/**
+ * @file packet_batch.cpp
+ * @brief Implementation of batch packet deserialization and SIMD validation.
+ *
+ * Each validation kernel computes, per lane:
+ *
+ *   valid = (seq != 0) && |x| <= MAX_POSITION && |y| <= MAX_POSITION
+ *                      && |vx| <= MAX_VELOCITY && |vy| <= MAX_VELOCITY
+ *
+ * The absolute value is taken by clearing the sign bit, and the compare is
+ * an ordered <=, so NaN fails the compare and +/-Inf fails the bound. That
+ * folds the std::isfinite() checks of Packet::isValid() into the range
+ * check without changing the result. Lane results are packed with movemask.
+ *
+ * @see packet_batch.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/packet_batch.hpp"
+#include <bitset>
+#include <cmath>
+#include <cstring>
+
+#ifdef NETCODE_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    /**
+     * @brief Scalar reference check for one packet (same result as Packet::isValid()).
+     */
+    inline bool laneValid(const PacketBatch& b, size_t i) {
+        return b.seq[i] != 0 &&
+            std::abs(b.x[i]) <= Packet::MAX_POSITION && std::abs(b.y[i]) <= Packet::MAX_POSITION &&
+            std::abs(b.vx[i]) <= Packet::MAX_VELOCITY && std::abs(b.vy[i]) <= Packet::MAX_VELOCITY;
+    }
+
+    void validateScalar(const PacketBatch& b, size_t begin, uint64_t* mask) {
+        for (size_t i = begin; i < b.size(); ++i) {
+            if (laneValid(b, i)) {
+                mask[i / 64] |= uint64_t{ 1 } << (i % 64);
+            }
+        }
+    }
+
+#ifdef NETCODE_X86
+    NETCODE_TARGET_SSE2
+    size_t validateSse(const PacketBatch& b, uint64_t* mask) {
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        const __m128 maxPos = _mm_set1_ps(Packet::MAX_POSITION);
+        const __m128 maxVel = _mm_set1_ps(Packet::MAX_VELOCITY);
+        const __m128i zero = _mm_setzero_si128();
+
+        const size_t n = b.size();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 ok = _mm_cmple_ps(_mm_andnot_ps(signBit, _mm_loadu_ps(&b.x[i])), maxPos);
+            ok = _mm_and_ps(ok, _mm_cmple_ps(_mm_andnot_ps(signBit, _mm_loadu_ps(&b.y[i])), maxPos));
+            ok = _mm_and_ps(ok, _mm_cmple_ps(_mm_andnot_ps(signBit, _mm_loadu_ps(&b.vx[i])), maxVel));
+            ok = _mm_and_ps(ok, _mm_cmple_ps(_mm_andnot_ps(signBit, _mm_loadu_ps(&b.vy[i])), maxVel));
+
+            const __m128i seq = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.seq[i]));
+            ok = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(seq, zero)), ok);
+
+            mask[i / 64] |= static_cast<uint64_t>(_mm_movemask_ps(ok)) << (i % 64);
+        }
+        return i;
+    }
+
+    NETCODE_TARGET_AVX2
+    size_t validateAvx2(const PacketBatch& b, uint64_t* mask) {
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+        const __m256 maxPos = _mm256_set1_ps(Packet::MAX_POSITION);
+        const __m256 maxVel = _mm256_set1_ps(Packet::MAX_VELOCITY);
+        const __m256i zero = _mm256_setzero_si256();
+
+        const size_t n = b.size();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 ok = _mm256_cmp_ps(_mm256_andnot_ps(signBit, _mm256_loadu_ps(&b.x[i])), maxPos, _CMP_LE_OQ);
+            ok = _mm256_and_ps(ok, _mm256_cmp_ps(_mm256_andnot_ps(signBit, _mm256_loadu_ps(&b.y[i])), maxPos, _CMP_LE_OQ));
+            ok = _mm256_and_ps(ok, _mm256_cmp_ps(_mm256_andnot_ps(signBit, _mm256_loadu_ps(&b.vx[i])), maxVel, _CMP_LE_OQ));
+            ok = _mm256_and_ps(ok, _mm256_cmp_ps(_mm256_andnot_ps(signBit, _mm256_loadu_ps(&b.vy[i])), maxVel, _CMP_LE_OQ));
+
+            const __m256i seq = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.seq[i]));
+            ok = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(seq, zero)), ok);
+
+            mask[i / 64] |= static_cast<uint64_t>(_mm256_movemask_ps(ok)) << (i % 64);
+        }
+        return i;
+    }
+#endif
+}
+
+void PacketBatch::deserialize(const char* buf, size_t count) {
+    seq.resize(count);
+    x.resize(count);
+    y.resize(count);
+    vx.resize(count);
+    vy.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const char* p = buf + i * Packet::size();
+        uint32_t nseq;
+        memcpy(&nseq, p, sizeof(nseq));
+        seq[i] = ntohl(nseq);
+        memcpy(&x[i], p + 4, sizeof(float));
+        memcpy(&y[i], p + 8, sizeof(float));
+        memcpy(&vx[i], p + 12, sizeof(float));
+        memcpy(&vy[i], p + 16, sizeof(float));
+    }
+}
+
+size_t PacketBatch::validate(std::vector<uint64_t>& validMask, SimdLevel level) const {
+    validMask.assign((size() + 63) / 64, 0);
+    if (validMask.empty()) return 0;
+
+    // Vector kernels handle whole groups of 4/8 lanes; the scalar loop finishes the tail
+    size_t done = 0;
+#ifdef NETCODE_X86
+    if (level == SimdLevel::AVX2 && cpuHasAvx2()) {
+        done = validateAvx2(*this, validMask.data());
+    }
+    else if (level != SimdLevel::Scalar) {
+        done = validateSse(*this, validMask.data());
+    }
+#else
+    (void)level;
+#endif
+    validateScalar(*this, done, validMask.data());
+
+    size_t validCount = 0;
+    for (uint64_t word : validMask) {
+        validCount += std::bitset<64>(word).count();
+    }
+    return validCount;
+}
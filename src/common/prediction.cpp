@@ -39,6 +39,8 @@ PredictionSystem::PredictionSystem(float initialX, float initialY)
     , serverX(initialX), serverY(initialY)
     , serverVx(0.0f), serverVy(0.0f)
     , lastAckedSequence(0)
+    , lastAckedHeld(0)
+    , heldCovered(0.0f)
     , errorX(0.0f), errorY(0.0f) {
 }
 
@@ -63,18 +65,44 @@ void PredictionSystem::applyInput(const InputCommand& input) {
  * @brief Reconciles predicted state with the authoritative server state,
  * rolling back, replaying unacknowledged inputs, and preparing for error correction.
  * @param serverPacket The most recent Packet from the server
+ * @param held How long the server has held the acknowledged input
  */
-void PredictionSystem::reconcileWithServer(const Packet& serverPacket) {
+void PredictionSystem::reconcileWithServer(const Packet& serverPacket, std::chrono::microseconds held) {
+    // An older state than the one already reconciled would move the prediction backwards
+    if (serverPacket.seq < lastAckedSequence ||
+        (serverPacket.seq == lastAckedSequence && held < lastAckedHeld)) {
+        return;
+    }
+
     // Update sequence and authoritative state from server
+    const bool newPacket = serverPacket.seq != lastAckedSequence;
     lastAckedSequence = serverPacket.seq;
+    lastAckedHeld = held;
     serverX = serverPacket.x;
     serverY = serverPacket.y;
     serverVx = serverPacket.vx;
     serverVy = serverPacket.vy;
 
-    // Remove acknowledged inputs (those older or equal to server sequence)
+    // Remove acknowledged inputs: the first time a packet is acknowledged, every frame sent
+    // before it and the frame that sent it
+    if (newPacket) {
+        while (!unacknowledgedInputs.empty() &&
+            unacknowledgedInputs.front().packetSeq < lastAckedSequence) {
+            unacknowledgedInputs.pop_front();
+        }
+        if (!unacknowledgedInputs.empty() && unacknowledgedInputs.front().packetSeq == lastAckedSequence) {
+            unacknowledgedInputs.pop_front();
+        }
+        heldCovered = 0.0f;
+    }
+
+    // ...and the frames after it that the server already moved by holding that input: each one
+    // whose midpoint the held time reaches
+    const float heldSeconds = std::chrono::duration<float>(held).count();
     while (!unacknowledgedInputs.empty() &&
-        unacknowledgedInputs.front().sequence <= lastAckedSequence) {
+        unacknowledgedInputs.front().packetSeq == lastAckedSequence &&
+        heldCovered + unacknowledgedInputs.front().dt * 0.5f <= heldSeconds) {
+        heldCovered += unacknowledgedInputs.front().dt;
         unacknowledgedInputs.pop_front();
     }
 
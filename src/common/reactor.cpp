@@ -0,0 +1,331 @@
+/**
+ * @file reactor.cpp
+ * @brief Coroutine reactor: epoll (Linux) or poll/WSAPoll event loop, timers and cross-thread wakeups.
+ *
+ * @see reactor.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/reactor.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+namespace {
+    constexpr int MAX_EVENTS = 64;
+
+    bool wouldBlock() {
+#ifdef _WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+    }
+
+    void closeSocket(SocketHandle sock) {
+#ifdef _WIN32
+        closesocket(sock);
+#else
+        close(sock);
+#endif
+    }
+
+    /** @brief Non-blocking loopback UDP socket connected to itself. */
+    SocketHandle makeWakeSocket() {
+        const SocketHandle sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+#ifdef _WIN32
+        int size = sizeof(addr);
+        u_long mode = 1;
+        ioctlsocket(sock, FIONBIO, &mode);
+#else
+        socklen_t size = sizeof(addr);
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+        bind(sock, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+        getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &size);
+        connect(sock, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+        return sock;
+    }
+
+    /** @brief Milliseconds to wait until a deadline, rounded up so the loop never wakes early. */
+    int timeoutMillis(Reactor::Clock::time_point until) {
+        if (until == Reactor::NEVER) {
+            return -1;
+        }
+        const auto remaining = until - Reactor::Clock::now();
+        if (remaining <= Reactor::Clock::duration::zero()) {
+            return 0;
+        }
+        const auto millis = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+        return static_cast<int>(std::min<decltype(millis)>(millis, 24 * 3600 * 1000));
+    }
+}
+
+Reactor::Reactor() : wakeSocket_(makeWakeSocket()) {
+#ifdef __linux__
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeSocket_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wakeSocket_, &event);
+#endif
+}
+
+Reactor::~Reactor() {
+    tasks_.clear();   // Destroys suspended frames; their waiters go with them
+    waiters_.clear();
+    sockets_.clear();
+    closeSocket(wakeSocket_);
+#ifdef __linux__
+    close(epoll_);
+#endif
+}
+
+void Reactor::spawn(Task<void> task) {
+    ready_.push_back(task.handle_);
+    tasks_.push_back(std::move(task));
+}
+
+void Reactor::run() {
+    runUntil(NEVER);
+}
+
+void Reactor::runUntil(Clock::time_point until) {
+    while (!stopping_.load(std::memory_order_acquire) && !tasks_.empty()) {
+        // Resume everything that became ready; resumed coroutines may make more ready
+        while (!ready_.empty()) {
+            std::vector<std::coroutine_handle<>> batch;
+            batch.swap(ready_);
+            for (const std::coroutine_handle<> handle : batch) {
+                handle.resume();
+            }
+        }
+        tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(),
+            [](const Task<void>& task) { return task.done(); }), tasks_.end());
+        if (tasks_.empty() || Clock::now() >= until) {
+            break;
+        }
+        poll(until);
+    }
+    stopping_.store(false, std::memory_order_release);
+}
+
+void Reactor::stop() {
+    stopping_.store(true, std::memory_order_release);
+    wake();
+}
+
+void Reactor::post(std::function<void()> function) {
+    {
+        std::lock_guard<std::mutex> lock(postedMutex_);
+        posted_.push_back(std::move(function));
+    }
+    wake();
+}
+
+void Reactor::wake() {
+    // One datagram in flight is enough to wake the loop
+    if (!wakePending_.exchange(true, std::memory_order_acq_rel)) {
+        const char byte = 0;
+        send(wakeSocket_, &byte, 1, 0);
+    }
+}
+
+void Reactor::runPosted() {
+    char drain[16];
+    while (recv(wakeSocket_, drain, sizeof(drain), 0) >= 0) {
+    }
+    wakePending_.store(false, std::memory_order_release);
+    std::vector<std::function<void()>> functions;
+    {
+        std::lock_guard<std::mutex> lock(postedMutex_);
+        functions.swap(posted_);
+    }
+    for (const auto& function : functions) {
+        function();
+    }
+}
+
+void Reactor::add(Waiter& waiter) {
+    waiter.id_ = nextId_++;
+    waiter.fired_ = false;
+    waiters_[waiter.id_] = &waiter;
+    if (waiter.deadline_ != NEVER) {
+        timers_.emplace(waiter.deadline_, waiter.id_);
+    }
+    if (waiter.interest_ != Waiter::Interest::None) {
+        SocketWaiters& slot = sockets_[waiter.sock_];
+        (waiter.interest_ == Waiter::Interest::Read ? slot.read : slot.write) = &waiter;
+        arm(waiter.sock_);
+    }
+}
+
+void Reactor::fire(Waiter& waiter, bool result) {
+    if (waiters_.erase(waiter.id_) == 0) {
+        return;
+    }
+    if (waiter.interest_ != Waiter::Interest::None) {
+        auto it = sockets_.find(waiter.sock_);
+        if (it != sockets_.end()) {
+            Waiter*& slot = waiter.interest_ == Waiter::Interest::Read ? it->second.read : it->second.write;
+            if (slot == &waiter) {
+                slot = nullptr;
+            }
+            if (!it->second.read && !it->second.write) {
+                sockets_.erase(it);
+            }
+        }
+    }
+    waiter.fired_ = result;
+    ready_.push_back(waiter.handle_);
+}
+
+void Reactor::handleSocket(SocketHandle sock, bool readable, bool writable) {
+    auto it = sockets_.find(sock);
+    if (it == sockets_.end()) {
+        return;   // Its waiter timed out meanwhile
+    }
+    Waiter* reader = readable ? it->second.read : nullptr;
+    Waiter* writer = writable ? it->second.write : nullptr;
+    if (reader) fire(*reader, true);
+    if (writer) fire(*writer, true);
+    if (sockets_.count(sock)) {
+        arm(sock);   // The other direction is still waited on
+    }
+}
+
+#ifdef __linux__
+void Reactor::arm(SocketHandle sock) {
+    // One-shot registration: the socket reports once, then stays quiet until armed again,
+    // so an unwatched socket with pending data never spins the loop
+    const SocketWaiters& slot = sockets_[sock];
+    epoll_event event{};
+    event.events = EPOLLONESHOT | (slot.read ? EPOLLIN : 0u) | (slot.write ? EPOLLOUT : 0u);
+    event.data.fd = sock;
+    if (epoll_ctl(epoll_, EPOLL_CTL_MOD, sock, &event) != 0 && errno == ENOENT) {
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, sock, &event);
+    }
+}
+
+void Reactor::poll(Clock::time_point until) {
+    if (!timers_.empty()) {
+        until = std::min(until, timers_.top().first);
+    }
+    epoll_event events[MAX_EVENTS];
+    const int count = epoll_wait(epoll_, events, MAX_EVENTS, ready_.empty() ? timeoutMillis(until) : 0);
+    for (int i = 0; i < count; ++i) {
+        const SocketHandle sock = events[i].data.fd;
+        if (sock == wakeSocket_) {
+            runPosted();
+            continue;
+        }
+        const uint32_t flags = events[i].events;
+        const bool failed = (flags & (EPOLLERR | EPOLLHUP)) != 0;
+        handleSocket(sock, failed || (flags & EPOLLIN), failed || (flags & EPOLLOUT));
+    }
+#else
+void Reactor::arm(SocketHandle) {
+    // poll() is given the waited-on sockets on every iteration
+}
+
+void Reactor::poll(Clock::time_point until) {
+    if (!timers_.empty()) {
+        until = std::min(until, timers_.top().first);
+    }
+#ifdef _WIN32
+    std::vector<WSAPOLLFD> fds;
+#else
+    std::vector<pollfd> fds;
+#endif
+    fds.push_back({ wakeSocket_, POLLIN, 0 });
+    for (const auto& [sock, slot] : sockets_) {
+        fds.push_back({ sock, static_cast<short>((slot.read ? POLLIN : 0) | (slot.write ? POLLOUT : 0)), 0 });
+    }
+    const int timeout = ready_.empty() ? timeoutMillis(until) : 0;
+#ifdef _WIN32
+    const int count = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout);
+#else
+    const int count = ::poll(fds.data(), fds.size(), timeout);
+#endif
+    if (count > 0) {
+        if (fds[0].revents) {
+            runPosted();
+        }
+        for (size_t i = 1; i < fds.size(); ++i) {
+            const short flags = fds[i].revents;
+            const bool failed = (flags & (POLLERR | POLLHUP)) != 0;
+            if (flags) {
+                handleSocket(fds[i].fd, failed || (flags & POLLIN), failed || (flags & POLLOUT));
+            }
+        }
+    }
+#endif
+
+    // Expired deadlines; entries of waiters that already fired are skipped
+    const Clock::time_point now = Clock::now();
+    while (!timers_.empty() && timers_.top().first <= now) {
+        const uint64_t id = timers_.top().second;
+        timers_.pop();
+        auto it = waiters_.find(id);
+        if (it != waiters_.end()) {
+            fire(*it->second, false);
+        }
+    }
+}
+
+void ReactorEvent::set() {
+    if (pending_.exchange(true, std::memory_order_acq_rel)) {
+        return;   // Already raised; the waiter has not consumed it yet
+    }
+    reactor_.post([this] {
+        if (waiting_ && pending_.exchange(false, std::memory_order_acq_rel)) {
+            reactor_.fire(*waiting_, true);
+        }
+    });
+}
+
+Task<int> asyncRecvFrom(Reactor& reactor, SocketHandle sock, char* buffer, size_t capacity,
+    sockaddr_in& from, Reactor::Clock::time_point deadline) {
+    while (true) {
+#ifdef _WIN32
+        int size = sizeof(from);
+#else
+        socklen_t size = sizeof(from);
+#endif
+        const int bytes = static_cast<int>(recvfrom(sock, buffer, static_cast<int>(capacity), 0,
+            reinterpret_cast<sockaddr*>(&from), &size));
+        if (bytes >= 0 || !wouldBlock()) {
+            co_return bytes;
+        }
+        if (!co_await reactor.readable(sock, deadline)) {
+            co_return -1;
+        }
+    }
+}
+
+Task<int> asyncSendTo(Reactor& reactor, SocketHandle sock, const char* data, size_t size, const sockaddr_in& to) {
+    while (true) {
+        const int bytes = static_cast<int>(sendto(sock, data, static_cast<int>(size), 0,
+            reinterpret_cast<const sockaddr*>(&to), sizeof(to)));
+        if (bytes >= 0 || !wouldBlock()) {
+            co_return bytes;
+        }
+        co_await reactor.writable(sock);
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file rollback.cpp
+ * @brief Snapshot ring, input prediction and resimulation for RollbackWorld.
+ *
+ * @see rollback.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/rollback.hpp"
+#include <algorithm>
+#include <cstring>
+
+RollbackWorld::RollbackWorld(const Config& config)
+    : config_(config), players_(config.players) {
+    config_.history = std::max<uint32_t>(config_.history, 1);
+    // Inputs are kept for the whole rollback window behind tick() and as far ahead, plus the
+    // tick before the oldest snapshot, whose inputs seed the predictions when replaying from it
+    inputRing_ = 2 * config_.history + 1;
+    state_.assign(4 * players_, 0.0f);
+    snapshots_.assign(static_cast<size_t>(config_.history) * 4 * players_, 0.0f);
+    inputs_.assign(static_cast<size_t>(inputRing_) * players_, InputSlot());
+    inputX_.assign(players_, 0.0f);
+    inputY_.assign(players_, 0.0f);
+    dt_.assign(players_, config_.tickSeconds);
+}
+
+void RollbackWorld::setPlayer(size_t player, float x, float y) {
+    if (player >= players_) {
+        return;
+    }
+    state_[player] = x;
+    state_[players_ + player] = y;
+    state_[2 * players_ + player] = 0.0f;
+    state_[3 * players_ + player] = 0.0f;
+}
+
+RollbackWorld::InputSlot& RollbackWorld::inputAt(uint32_t tick, size_t player) {
+    return inputs_[static_cast<size_t>(tick % inputRing_) * players_ + player];
+}
+
+bool RollbackWorld::setInput(uint32_t tick, size_t player, float inputX, float inputY) {
+    if (player >= players_ || tick >= tick_ + config_.history) {
+        return false;
+    }
+    if (tick < tick_ && tick_ - tick > config_.history) {
+        ++late_;  // Its snapshot is gone: only an authoritative resync can fix this
+        return false;
+    }
+
+    InputSlot& slot = inputAt(tick, player);
+    if (tick < tick_ && (slot.tick != tick || slot.x != inputX || slot.y != inputY)) {
+        pending_ = std::min(pending_, tick);  // The tick ran with a different (predicted) input
+    }
+    slot = { tick, inputX, inputY, true };
+    return true;
+}
+
+void RollbackWorld::simulate(uint32_t tick) {
+    const size_t block = 4 * players_;
+    std::memcpy(snapshots_.data() + static_cast<size_t>(tick % config_.history) * block, state_.data(),
+        block * sizeof(float));
+
+    for (size_t player = 0; player < players_; ++player) {
+        InputSlot& slot = inputAt(tick, player);
+        if (slot.tick != tick || !slot.confirmed) {
+            // Not arrived yet: predict that the player keeps doing what it did last tick
+            const InputSlot& previous = inputAt(tick - 1, player);
+            const bool known = tick > 0 && previous.tick == tick - 1;
+            slot = { tick, known ? previous.x : 0.0f, known ? previous.y : 0.0f, false };
+        }
+        inputX_[player] = slot.x;
+        inputY_[player] = slot.y;
+    }
+
+    float* x = state_.data();
+    float* y = x + players_;
+    integrateAndClamp({ x, y, y + players_, y + 2 * players_, inputX_.data(), inputY_.data(), dt_.data() },
+        players_, config_.movement);
+    if (config_.collisions) {
+        grid_.resolve(x, y, players_, config_.collision);
+    }
+}
+
+void RollbackWorld::advance() {
+    rollback();
+    simulate(tick_);
+    ++tick_;
+}
+
+uint32_t RollbackWorld::rollback() {
+    if (pending_ == UINT32_MAX) {
+        return 0;
+    }
+    return resimulateFrom(pending_);
+}
+
+uint32_t RollbackWorld::resimulateFrom(uint32_t tick) {
+    if (tick >= tick_ || tick_ - tick > config_.history) {
+        return 0;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const size_t block = 4 * players_;
+    std::memcpy(state_.data(), snapshots_.data() + static_cast<size_t>(tick % config_.history) * block,
+        block * sizeof(float));
+    for (uint32_t replay = tick; replay < tick_; ++replay) {
+        simulate(replay);
+    }
+    if (pending_ >= tick) {
+        pending_ = UINT32_MAX;  // Every correction at or after tick is applied now
+    }
+
+    const uint32_t depth = tick_ - tick;
+    ++rollbacks_;
+    resimulated_ += depth;
+    deepest_ = std::max(deepest_, depth);
+    lastRollbackTime_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return depth;
+}
@@ -0,0 +1,653 @@
+/**
+ * @file room.cpp
+ * @brief Implementation of Room simulation and RoomRouter client placement.
+ *
+ * @see room.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/room.hpp"
+#include "netcode/common/job_system.hpp"
+#include "netcode/common/movement_kernel.hpp"
+#include "netcode/common/prediction.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace {
+    template<typename T>
+    void removeColumnSlot(std::vector<T>& column, size_t slot) {
+        column[slot] = column.back();
+        column.pop_back();
+    }
+
+    const uint32_t ROOM_STATE_VERSION = 3;
+
+    // Serialized sizes of one room header, one client and one queued input (see Room::save())
+    constexpr size_t ROOM_HEADER_BYTES = sizeof(uint32_t) + 3 * sizeof(uint64_t);
+    constexpr size_t CLIENT_BYTES = sizeof(ClientId) + sizeof(uint32_t) + sizeof(uint16_t) +
+        4 * sizeof(float) + sizeof(uint32_t) + 2 * sizeof(int64_t) + sizeof(uint32_t) + sizeof(int64_t);
+    constexpr size_t INPUT_BYTES = sizeof(ClientId) + sizeof(uint32_t) + 2 * sizeof(float) + sizeof(int64_t);
+
+    // Fixed-size values are copied in host byte order: saved state only moves between
+    // processes on the same machine
+    template<typename T>
+    void append(std::vector<char>& out, const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    /** @brief Writes into space the caller has already reserved. */
+    template<typename T>
+    void put(char*& cursor, const T& value) {
+        std::memcpy(cursor, &value, sizeof(T));
+        cursor += sizeof(T);
+    }
+
+    template<typename T>
+    bool take(const char*& cursor, const char* end, T& value) {
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    int64_t toTicks(std::chrono::steady_clock::time_point t) {
+        return static_cast<int64_t>(t.time_since_epoch().count());
+    }
+
+    std::chrono::steady_clock::time_point fromTicks(int64_t ticks) {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ticks));
+    }
+
+    const MovementParams ROOM_MOVEMENT{ Room::MOVE_SPEED, Room::BOUNDS_MIN, Room::BOUNDS_MAX, Room::MAX_STEP };
+    const CollisionParams ROOM_COLLISION{ Room::PLAYER_RADIUS, Room::BOUNDS_MIN, Room::BOUNDS_MAX };
+
+    /** @brief Gather buffers for one integration pass (one set per worker thread). */
+    struct MovementScratch {
+        std::vector<size_t> slots;
+        std::vector<float> x, y, vx, vy;
+        std::vector<float> inputX, inputY, dt;
+
+        void resize(size_t n) {
+            x.resize(n); y.resize(n); vx.resize(n); vy.resize(n);
+            inputX.resize(n); inputY.resize(n); dt.resize(n);
+        }
+    };
+}
+
+Room::Room(uint32_t id, size_t capacity) : id_(id), capacity_(capacity) {
+    entities_.reserve(capacity);
+    index_.reserve(capacity);
+    clientIds_.reserve(capacity);
+    addrs_.reserve(capacity);
+    lastUpdate_.reserve(capacity);
+    lastSeen_.reserve(capacity);
+    pending_.reserve(capacity);
+    quietTicks_.reserve(capacity);
+    queued_.reserve(capacity);
+    lastSent_.reserve(capacity);
+    sentAt_.reserve(capacity);
+    snapshotSeq_.reserve(capacity);
+    heldSince_.reserve(capacity);
+}
+
+bool Room::join(ClientId client, const sockaddr_in& addr, std::chrono::steady_clock::time_point now) {
+    if (index_.count(client)) {
+        return true;
+    }
+    if (full()) {
+        return false;
+    }
+
+    const EntityId entity = entities_.create();
+    const size_t slot = entities_.slot(entity);
+    entities_.x()[slot] = SPAWN_X;
+    entities_.y()[slot] = SPAWN_Y;
+    index_[client] = entity;
+
+    clientIds_.push_back(client);
+    addrs_.push_back(addr);
+    lastUpdate_.push_back(now);
+    lastSeen_.push_back(now);
+    pending_.push_back(0);
+    quietTicks_.push_back(0);
+    queued_.push_back(0);
+    lastSent_.push_back(Packet());
+    sentAt_.push_back(std::chrono::steady_clock::time_point::min());
+    snapshotSeq_.push_back(0);
+    heldSince_.push_back(now);
+    return true;
+}
+
+void Room::removeSlot(size_t slot) {
+    removeColumnSlot(clientIds_, slot);
+    removeColumnSlot(addrs_, slot);
+    removeColumnSlot(lastUpdate_, slot);
+    removeColumnSlot(lastSeen_, slot);
+    removeColumnSlot(pending_, slot);
+    removeColumnSlot(quietTicks_, slot);
+    removeColumnSlot(queued_, slot);
+    removeColumnSlot(lastSent_, slot);
+    removeColumnSlot(sentAt_, slot);
+    removeColumnSlot(snapshotSeq_, slot);
+    removeColumnSlot(heldSince_, slot);
+}
+
+bool Room::leave(ClientId client) {
+    auto it = index_.find(client);
+    if (it == index_.end()) {
+        return false;
+    }
+    const size_t last = entities_.size() - 1;
+    const size_t slot = entities_.destroy(it->second);
+    index_.erase(it);
+    removeSlot(slot);
+
+    // Queued input refers to slots; drop the leaver's and retarget the moved client's
+    inbox_.erase(std::remove_if(inbox_.begin(), inbox_.end(),
+        [slot](const QueuedInput& in) { return in.slot == slot; }), inbox_.end());
+    for (auto& in : inbox_) {
+        if (in.slot == last) in.slot = slot;
+    }
+    std::fill(queued_.begin(), queued_.end(), 0);
+    for (size_t i = 0; i < inbox_.size(); ++i) {
+        queued_[inbox_[i].slot] = static_cast<uint32_t>(i + 1);
+    }
+    return true;
+}
+
+void Room::pushInput(ClientId client, uint32_t seq, float inputX, float inputY,
+    std::chrono::steady_clock::time_point arrival) {
+    const size_t slot = slotOf(client);
+    if (slot == EntityStore::NPOS) {
+        return;
+    }
+    lastSeen_[slot] = arrival;
+    if (shedding_.coalesceInputs && queued_[slot]) {
+        // Replace the client's queued input: applied at the newer arrival, it moves the client
+        // for the whole time since its previous update in one step
+        QueuedInput& queued = inbox_[queued_[slot] - 1];
+        if (seq > queued.seq) {
+            queued = { slot, seq, inputX, inputY, arrival };
+            ++coalescedInputs_;
+        }
+        return;
+    }
+    inbox_.push_back({ slot, seq, inputX, inputY, arrival });
+    queued_[slot] = static_cast<uint32_t>(inbox_.size());
+}
+
+size_t Room::holdInputs(std::chrono::steady_clock::time_point now) {
+    const float* vx = entities_.vx();
+    const float* vy = entities_.vy();
+    const uint32_t* lastSeq = entities_.seq();
+    size_t held = 0;
+    for (size_t slot = 0; slot < entities_.size(); ++slot) {
+        if (queued_[slot] || now <= lastUpdate_[slot]) {
+            continue;  // Its own input moves it this tick
+        }
+        if (vx[slot] == 0.0f && vy[slot] == 0.0f) {
+            lastUpdate_[slot] = now;
+            continue;
+        }
+        inbox_.push_back({ slot, lastSeq[slot], vx[slot] / MOVE_SPEED, vy[slot] / MOVE_SPEED, now, true });
+        queued_[slot] = static_cast<uint32_t>(inbox_.size());
+        ++held;
+    }
+    heldInputs_ += held;
+    return held;
+}
+
+size_t Room::acceptInputs(size_t slot) {
+    const size_t first = inputStart_[slot];
+    const size_t last = inputStart_[slot + 1];
+    accepted_[slot] = 0;
+    if (first == last) {
+        return 0;
+    }
+
+    // Drop stale input and fix each survivor's dt, compacting them to the front of the range.
+    // Seq and update time can be final now; positions follow in integrate()
+    uint32_t& lastSeq = entities_.seq()[slot];
+    size_t accepted = 0;
+    for (size_t i = first; i < last; ++i) {
+        if (inputSeq_[i] <= lastSeq && !inputHeld_[i]) {
+            continue;  // Reordered or duplicate input
+        }
+        const size_t to = first + accepted++;
+        inputX_[to] = inputX_[i];
+        inputY_[to] = inputY_[i];
+        inputDt_[to] = std::chrono::duration<float>(inputArrival_[i] - lastUpdate_[slot]).count();
+        lastSeq = inputSeq_[i];
+        lastUpdate_[slot] = inputArrival_[i];
+        if (!inputHeld_[i]) {
+            heldSince_[slot] = inputArrival_[i];
+        }
+    }
+    accepted_[slot] = static_cast<uint32_t>(accepted);
+    pending_[slot] = 1;
+    return accepted;
+}
+
+void Room::integrate(size_t begin, size_t end, size_t rounds) {
+    thread_local MovementScratch scratch;
+    float* x = entities_.x();
+    float* y = entities_.y();
+    float* vx = entities_.vx();
+    float* vy = entities_.vy();
+
+    // Common case: every client sent exactly one fresh input, so the input columns line up
+    // with the entity columns and the kernel runs on both in place
+    const size_t firstInput = inputStart_[begin];
+    if (rounds == 1 && inputStart_[end] - firstInput == end - begin &&
+        std::all_of(accepted_.begin() + begin, accepted_.begin() + end, [](uint32_t n) { return n == 1; })) {
+        integrateAndClamp({ x + begin, y + begin, vx + begin, vy + begin,
+            inputX_.data() + firstInput, inputY_.data() + firstInput, inputDt_.data() + firstInput },
+            end - begin, ROOM_MOVEMENT);
+        return;
+    }
+
+    // Otherwise pass r gathers the r-th accepted input of every client that has one. If that is
+    // every client in the chunk the kernel still updates the entity columns in place; if not,
+    // it runs on a gathered copy of the participants that is scattered back
+    for (size_t round = 0; round < rounds; ++round) {
+        if (std::all_of(accepted_.begin() + begin, accepted_.begin() + end,
+            [round](uint32_t n) { return n > round; })) {
+            const size_t n = end - begin;
+            scratch.resize(n);
+            for (size_t k = 0; k < n; ++k) {
+                const size_t input = inputStart_[begin + k] + round;
+                scratch.inputX[k] = inputX_[input];
+                scratch.inputY[k] = inputY_[input];
+                scratch.dt[k] = inputDt_[input];
+            }
+            integrateAndClamp({ x + begin, y + begin, vx + begin, vy + begin,
+                scratch.inputX.data(), scratch.inputY.data(), scratch.dt.data() }, n, ROOM_MOVEMENT);
+            continue;
+        }
+
+        scratch.slots.clear();
+        for (size_t slot = begin; slot < end; ++slot) {
+            if (accepted_[slot] > round) {
+                scratch.slots.push_back(slot);
+            }
+        }
+        const size_t n = scratch.slots.size();
+        scratch.resize(n);
+        for (size_t k = 0; k < n; ++k) {
+            const size_t slot = scratch.slots[k];
+            const size_t input = inputStart_[slot] + round;
+            scratch.x[k] = x[slot];
+            scratch.y[k] = y[slot];
+            scratch.inputX[k] = inputX_[input];
+            scratch.inputY[k] = inputY_[input];
+            scratch.dt[k] = inputDt_[input];
+        }
+        integrateAndClamp({ scratch.x.data(), scratch.y.data(), scratch.vx.data(), scratch.vy.data(),
+            scratch.inputX.data(), scratch.inputY.data(), scratch.dt.data() }, n, ROOM_MOVEMENT);
+        for (size_t k = 0; k < n; ++k) {
+            const size_t slot = scratch.slots[k];
+            x[slot] = scratch.x[k];
+            y[slot] = scratch.y[k];
+            vx[slot] = scratch.vx[k];
+            vy[slot] = scratch.vy[k];
+        }
+    }
+}
+
+size_t Room::tick(std::vector<RoomOutput>& out, JobSystem* jobs) {
+    const size_t count = entities_.size();
+
+    // Group queued input by client (counting sort keeps each client's arrival order)
+    inputStart_.assign(count + 1, 0);
+    for (const auto& in : inbox_) {
+        ++inputStart_[in.slot + 1];
+    }
+    for (size_t slot = 0; slot < count; ++slot) {
+        inputStart_[slot + 1] += inputStart_[slot];
+    }
+    const size_t queued = inbox_.size();
+    inputSeq_.resize(queued);
+    inputHeld_.resize(queued);
+    inputX_.resize(queued);
+    inputY_.resize(queued);
+    inputArrival_.resize(queued);
+    inputDt_.resize(queued);
+    for (const auto& in : inbox_) {
+        const size_t to = inputStart_[in.slot]++;  // Advances each start to the next client's start
+        inputSeq_[to] = in.seq;
+        inputHeld_[to] = in.held;
+        inputX_[to] = in.inputX;
+        inputY_[to] = in.inputY;
+        inputArrival_[to] = in.arrival;
+    }
+    for (size_t slot = count; slot > 0; --slot) {
+        inputStart_[slot] = inputStart_[slot - 1];
+    }
+    inputStart_[0] = 0;
+    inbox_.clear();
+    std::fill(queued_.begin(), queued_.end(), 0);
+    accepted_.resize(count);
+    snapshots_.resize(count);
+
+    // Clients are independent within a tick: integrate and clamp, then build snapshots, per chunk.
+    // Collisions couple them, so with collisions on the snapshots wait until overlaps are resolved
+    std::atomic<size_t> applied{ 0 };
+    auto buildSnapshots = [&](size_t begin, size_t end) {
+        const float* x = entities_.x();
+        const float* y = entities_.y();
+        const float* vx = entities_.vx();
+        const float* vy = entities_.vy();
+        const uint32_t* lastSeq = entities_.seq();
+        for (size_t slot = begin; slot < end; ++slot) {
+            // Echo the newest sequence number for client-side reconciliation
+            snapshots_[slot] = Packet(lastSeq[slot], x[slot], y[slot], vx[slot], vy[slot]);
+        }
+    };
+    auto simulate = [&](size_t begin, size_t end) {
+        size_t local = 0;
+        size_t rounds = 0;
+        for (size_t slot = begin; slot < end; ++slot) {
+            const size_t accepted = acceptInputs(slot);
+            local += accepted;
+            rounds = std::max(rounds, accepted);
+        }
+        integrate(begin, end, rounds);
+        if (!collisions_) {
+            buildSnapshots(begin, end);
+        }
+        applied.fetch_add(local, std::memory_order_relaxed);
+    };
+    if (jobs) {
+        jobs->parallelFor(0, count, PARALLEL_GRAIN, simulate);
+    }
+    else {
+        simulate(0, count);
+    }
+    if (collisions_) {
+        contacts_ += collisionGrid_.resolve(entities_.x(), entities_.y(), count, ROOM_COLLISION);
+        buildSnapshots(0, count);
+    }
+
+    const float* vx = entities_.vx();
+    const float* vy = entities_.vy();
+    for (size_t slot = 0; slot < count; ++slot) {
+        if (pending_[slot]) {
+            pending_[slot] = 0;
+            if (vx[slot] != 0.0f || vy[slot] != 0.0f) {
+                quietTicks_[slot] = 0;
+            }
+            else if (quietTicks_[slot]++ % std::max<uint32_t>(shedding_.idleResponseInterval, 1) != 0) {
+                ++suppressedSnapshots_;  // Still idle: the last snapshot it got is current
+                continue;
+            }
+            if (deadReckoning_.enabled) {
+                if (!extrapolationDrifted(slot)) {
+                    ++deadReckoned_;
+                    continue;
+                }
+                lastSent_[slot] = snapshots_[slot];
+                sentAt_[slot] = lastUpdate_[slot];
+            }
+            // How long the echoed input has been held: the client's frames after sending it that
+            // this state already includes
+            const auto held = std::chrono::duration_cast<std::chrono::microseconds>(lastUpdate_[slot] - heldSince_[slot]);
+            const uint32_t heldMicros = static_cast<uint32_t>(std::clamp<int64_t>(held.count(), 0, UINT32_MAX));
+            out.push_back({ addrs_[slot], snapshots_[slot], { ++snapshotSeq_[slot], heldMicros } });
+        }
+    }
+    return applied.load(std::memory_order_relaxed);
+}
+
+bool Room::extrapolationDrifted(size_t slot) const {
+    if (sentAt_[slot] == std::chrono::steady_clock::time_point::min() ||
+        lastUpdate_[slot] - sentAt_[slot] >= deadReckoning_.heartbeat) {
+        return true;
+    }
+    // Where the client thinks it is: the same extrapolation it runs on the last snapshot
+    const float dt = std::chrono::duration<float>(lastUpdate_[slot] - sentAt_[slot]).count();
+    const auto [px, py] = predictPosition(lastSent_[slot], dt);
+    const float dx = px - entities_.x()[slot];
+    const float dy = py - entities_.y()[slot];
+    return dx * dx + dy * dy > deadReckoning_.threshold * deadReckoning_.threshold;
+}
+
+std::vector<ClientId> Room::evictIdle(std::chrono::steady_clock::time_point cutoff) {
+    std::vector<ClientId> idle;
+    for (size_t slot = 0; slot < lastSeen_.size(); ++slot) {
+        if (lastSeen_[slot] < cutoff) {
+            idle.push_back(clientIds_[slot]);
+        }
+    }
+    for (ClientId id : idle) {
+        leave(id);
+    }
+    return idle;
+}
+
+void Room::save(std::vector<char>& out) const {
+    // Size the buffer once and fill it column by column
+    const size_t start = out.size();
+    out.resize(start + ROOM_HEADER_BYTES + size() * CLIENT_BYTES + inbox_.size() * INPUT_BYTES);
+    char* cursor = out.data() + start;
+
+    put(cursor, id_);
+    put(cursor, static_cast<uint64_t>(capacity_));
+    put(cursor, static_cast<uint64_t>(size()));
+    for (size_t slot = 0; slot < size(); ++slot) {
+        put(cursor, clientIds_[slot]);
+        put(cursor, addrs_[slot].sin_addr.s_addr);
+        put(cursor, addrs_[slot].sin_port);
+        put(cursor, entities_.x()[slot]);
+        put(cursor, entities_.y()[slot]);
+        put(cursor, entities_.vx()[slot]);
+        put(cursor, entities_.vy()[slot]);
+        put(cursor, entities_.seq()[slot]);
+        put(cursor, toTicks(lastUpdate_[slot]));
+        put(cursor, toTicks(lastSeen_[slot]));
+        put(cursor, snapshotSeq_[slot]);
+        put(cursor, toTicks(heldSince_[slot]));
+    }
+
+    // Queued input is stored by client, since slots are reassigned on load
+    put(cursor, static_cast<uint64_t>(inbox_.size()));
+    for (const QueuedInput& in : inbox_) {
+        put(cursor, clientIds_[in.slot]);
+        put(cursor, in.seq);
+        put(cursor, in.inputX);
+        put(cursor, in.inputY);
+        put(cursor, toTicks(in.arrival));
+    }
+}
+
+std::unique_ptr<Room> Room::load(const char*& cursor, const char* end, std::chrono::steady_clock::duration shift) {
+    uint32_t id = 0;
+    uint64_t capacity = 0, count = 0;
+    if (!take(cursor, end, id) || !take(cursor, end, capacity) || !take(cursor, end, count) || count > capacity) {
+        return nullptr;
+    }
+    // The capacity is reserved up front: never trust it (or the count) beyond what the data can hold
+    if (capacity > MAX_LOADED_CAPACITY || count > static_cast<uint64_t>(end - cursor) / CLIENT_BYTES) {
+        return nullptr;
+    }
+
+    auto room = std::make_unique<Room>(id, static_cast<size_t>(capacity));
+    for (uint64_t i = 0; i < count; ++i) {
+        ClientId client = 0;
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        float x = 0, y = 0, vx = 0, vy = 0;
+        uint32_t seq = 0, snapshotSeq = 0;
+        int64_t lastUpdate = 0, lastSeen = 0, heldSince = 0;
+        if (!take(cursor, end, client) || !take(cursor, end, addr.sin_addr.s_addr) || !take(cursor, end, addr.sin_port) ||
+            !take(cursor, end, x) || !take(cursor, end, y) || !take(cursor, end, vx) || !take(cursor, end, vy) ||
+            !take(cursor, end, seq) || !take(cursor, end, lastUpdate) || !take(cursor, end, lastSeen) ||
+            !take(cursor, end, snapshotSeq) || !take(cursor, end, heldSince)) {
+            return nullptr;
+        }
+        if (room->index_.count(client) || !room->join(client, addr, fromTicks(lastUpdate) + shift)) {
+            return nullptr;
+        }
+        const size_t slot = room->size() - 1;
+        room->entities_.x()[slot] = x;
+        room->entities_.y()[slot] = y;
+        room->entities_.vx()[slot] = vx;
+        room->entities_.vy()[slot] = vy;
+        room->entities_.seq()[slot] = seq;
+        room->lastSeen_[slot] = fromTicks(lastSeen) + shift;
+        room->snapshotSeq_[slot] = snapshotSeq;
+        room->heldSince_[slot] = fromTicks(heldSince) + shift;
+    }
+
+    uint64_t queued = 0;
+    if (!take(cursor, end, queued) || queued > static_cast<uint64_t>(end - cursor) / INPUT_BYTES) {
+        return nullptr;
+    }
+    room->inbox_.reserve(static_cast<size_t>(queued));
+    for (uint64_t i = 0; i < queued; ++i) {
+        ClientId client = 0;
+        uint32_t seq = 0;
+        float inputX = 0, inputY = 0;
+        int64_t arrival = 0;
+        if (!take(cursor, end, client) || !take(cursor, end, seq) || !take(cursor, end, inputX) ||
+            !take(cursor, end, inputY) || !take(cursor, end, arrival)) {
+            return nullptr;
+        }
+        const size_t slot = room->slotOf(client);
+        if (slot == EntityStore::NPOS) {
+            return nullptr;
+        }
+        room->inbox_.push_back({ slot, seq, inputX, inputY, fromTicks(arrival) + shift });
+    }
+    return room;
+}
+
+size_t Room::slotOf(ClientId client) const {
+    auto it = index_.find(client);
+    return it == index_.end() ? EntityStore::NPOS : entities_.slot(it->second);
+}
+
+RoomRouter::RoomRouter(size_t roomCapacity, size_t maxRooms)
+    : roomCapacity_(std::max<size_t>(roomCapacity, 1)), maxRooms_(maxRooms) {
+    rooms_.reserve(maxRooms_);
+}
+
+Room* RoomRouter::route(ClientId client, const sockaddr_in& addr, std::chrono::steady_clock::time_point now) {
+    auto it = assignment_.find(client);
+    if (it != assignment_.end()) {
+        return it->second;
+    }
+
+    if (!shedding_.admitNewClients) {
+        ++refused_;
+        return nullptr;
+    }
+
+    Room* target = nullptr;
+    for (auto& room : rooms_) {
+        if (!room->full()) {
+            target = room.get();
+            break;
+        }
+    }
+    if (!target) {
+        if (rooms_.size() >= maxRooms_) {
+            return nullptr;
+        }
+        rooms_.push_back(std::make_unique<Room>(static_cast<uint32_t>(rooms_.size()), roomCapacity_));
+        target = rooms_.back().get();
+        target->setCollisions(collisions_);
+        target->setDeadReckoning(deadReckoning_);
+        target->setShedding(shedding_);
+    }
+
+    target->join(client, addr, now);
+    assignment_[client] = target;
+    return target;
+}
+
+void RoomRouter::setCollisions(bool enabled) {
+    collisions_ = enabled;
+    for (auto& room : rooms_) {
+        room->setCollisions(enabled);
+    }
+}
+
+void RoomRouter::setDeadReckoning(const DeadReckoning& mode) {
+    deadReckoning_ = mode;
+    for (auto& room : rooms_) {
+        room->setDeadReckoning(mode);
+    }
+}
+
+void RoomRouter::setShedding(const LoadShedding& shedding) {
+    shedding_ = shedding;
+    for (auto& room : rooms_) {
+        room->setShedding(shedding);
+    }
+}
+
+Room* RoomRouter::find(ClientId client) const {
+    auto it = assignment_.find(client);
+    return it == assignment_.end() ? nullptr : it->second;
+}
+
+size_t RoomRouter::evictIdle(std::chrono::steady_clock::time_point cutoff) {
+    size_t removed = 0;
+    for (auto& room : rooms_) {
+        for (ClientId id : room->evictIdle(cutoff)) {
+            assignment_.erase(id);
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+void RoomRouter::save(std::vector<char>& out) const {
+    append(out, ROOM_STATE_VERSION);
+    append(out, static_cast<uint64_t>(roomCapacity_));
+    append(out, static_cast<uint64_t>(rooms_.size()));
+    for (const auto& room : rooms_) {
+        room->save(out);
+    }
+}
+
+bool RoomRouter::load(const char* data, size_t size, std::chrono::steady_clock::duration shift) {
+    rooms_.clear();
+    assignment_.clear();
+
+    const char* cursor = data;
+    const char* end = data + size;
+    uint32_t version = 0;
+    uint64_t roomCapacity = 0, roomCount = 0;
+    bool ok = take(cursor, end, version) && version == ROOM_STATE_VERSION &&
+        take(cursor, end, roomCapacity) && roomCapacity == roomCapacity_ &&
+        take(cursor, end, roomCount) && roomCount <= maxRooms_;
+
+    for (uint64_t i = 0; ok && i < roomCount; ++i) {
+        std::unique_ptr<Room> room = Room::load(cursor, end, shift);
+        // Room ids index per-room buffers (outboxes), so they must stay dense and in order
+        ok = room && room->id() == i && room->capacity() == roomCapacity_;
+        if (!ok) {
+            break;
+        }
+        for (size_t slot = 0; slot < room->size(); ++slot) {
+            ok = ok && assignment_.emplace(room->clientAt(slot), room.get()).second;
+        }
+        room->setCollisions(collisions_);
+        room->setDeadReckoning(deadReckoning_);
+        room->setShedding(shedding_);
+        rooms_.push_back(std::move(room));
+    }
+
+    if (!ok || cursor != end) {
+        rooms_.clear();
+        assignment_.clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file snapshot_codec.cpp
+ * @brief Implementation of the range-coded snapshot codec and its model trainer.
+ *
+ * The coder is the carry-propagating range coder used by LZMA (64-bit low,
+ * 32-bit range, byte-wise renormalization) driven by static frequencies.
+ * Two tweaks keep it efficient for 20-byte payloads:
+ *   - The first output byte of this coder is always zero, so it is omitted
+ *     and the decoder starts from an implicit zero.
+ *   - On flush, the final value is rounded to the point in the coding
+ *     interval with the most trailing zero bytes, and trailing zeros are
+ *     dropped; the decoder reads zeros past the end of its input.
+ *
+ * @see snapshot_codec.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/snapshot_codec.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+#include "snapshot_model.inl"
+
+    /**
+     * @brief Cumulative frequency tables derived from the trained model at compile time.
+     */
+    struct CumulativeModel {
+        std::array<std::array<uint16_t, 257>, SNAPSHOT_SYMBOLS> cum{};
+    };
+
+    constexpr CumulativeModel buildCumulativeModel(const SnapshotFrequencyTable& freq) {
+        CumulativeModel model{};
+        for (size_t ctx = 0; ctx < SNAPSHOT_SYMBOLS; ++ctx) {
+            uint32_t total = 0;
+            for (size_t s = 0; s < 256; ++s) {
+                model.cum[ctx][s] = static_cast<uint16_t>(total);
+                total += freq[ctx][s];
+            }
+            model.cum[ctx][256] = static_cast<uint16_t>(total);
+        }
+        return model;
+    }
+
+    constexpr bool modelIsComplete(const SnapshotFrequencyTable& freq) {
+        for (size_t ctx = 0; ctx < SNAPSHOT_SYMBOLS; ++ctx) {
+            uint32_t total = 0;
+            for (size_t s = 0; s < 256; ++s) {
+                if (freq[ctx][s] == 0) return false;  // Every byte value must stay encodable
+                total += freq[ctx][s];
+            }
+            if (total != (1u << SNAPSHOT_MODEL_BITS)) return false;
+        }
+        return true;
+    }
+
+    static_assert(modelIsComplete(SNAPSHOT_MODEL_FREQUENCIES),
+        "snapshot_model.inl: every context needs nonzero frequencies summing to 1 << SNAPSHOT_MODEL_BITS");
+
+    constexpr CumulativeModel MODEL = buildCumulativeModel(SNAPSHOT_MODEL_FREQUENCIES);
+
+    constexpr uint32_t TOP = 1u << 24;
+
+    class RangeEncoder {
+        uint8_t* out_;
+        size_t capacity_;
+        size_t pos_ = 0;
+        bool overflow_ = false;
+        bool firstByte_ = true;
+        uint64_t low_ = 0;
+        uint32_t range_ = 0xFFFFFFFFu;
+        uint8_t cache_ = 0;
+        uint64_t cacheSize_ = 1;
+
+        void put(uint8_t byte) {
+            if (firstByte_) {
+                firstByte_ = false;  // Always zero for this coder; the decoder assumes it
+                return;
+            }
+            if (pos_ < capacity_) out_[pos_++] = byte;
+            else overflow_ = true;
+        }
+
+        void shiftLow() {
+            if (static_cast<uint32_t>(low_) < 0xFF000000u || (low_ >> 32) != 0) {
+                const uint8_t carry = static_cast<uint8_t>(low_ >> 32);
+                uint8_t temp = cache_;
+                do {
+                    put(static_cast<uint8_t>(temp + carry));
+                    temp = 0xFF;
+                } while (--cacheSize_ != 0);
+                cache_ = static_cast<uint8_t>(low_ >> 24);
+            }
+            ++cacheSize_;
+            low_ = (low_ & 0x00FFFFFFu) << 8;
+        }
+
+    public:
+        RangeEncoder(uint8_t* out, size_t capacity) : out_(out), capacity_(capacity) {}
+
+        void encode(uint32_t start, uint32_t size) {
+            range_ >>= SNAPSHOT_MODEL_BITS;
+            low_ += static_cast<uint64_t>(start) * range_;
+            range_ *= size;
+            while (range_ < TOP) {
+                range_ <<= 8;
+                shiftLow();
+            }
+        }
+
+        /**
+         * @brief Flushes the coder and returns the encoded length (0 on overflow).
+         */
+        size_t finish() {
+            // Pick the value in [low, low + range) with the most trailing zero bits
+            for (int shift = 32; shift > 0; shift -= 8) {
+                const uint64_t mask = (uint64_t{ 1 } << shift) - 1;
+                const uint64_t rounded = (low_ + mask) & ~mask;
+                if (rounded < low_ + range_) {
+                    low_ = rounded;
+                    break;
+                }
+            }
+            for (int i = 0; i < 5; ++i) {
+                shiftLow();
+            }
+            if (overflow_) return 0;
+
+            // The decoder reads zeros past the end, so trailing zero bytes are implicit
+            while (pos_ > 1 && out_[pos_ - 1] == 0) {
+                --pos_;
+            }
+            return pos_;
+        }
+    };
+
+    class RangeDecoder {
+        const uint8_t* in_;
+        size_t length_;
+        size_t pos_ = 0;
+        uint32_t range_ = 0xFFFFFFFFu;
+        uint32_t code_ = 0;
+
+        uint8_t next() { return pos_ < length_ ? in_[pos_++] : 0; }
+
+    public:
+        RangeDecoder(const uint8_t* in, size_t length) : in_(in), length_(length) {
+            for (int i = 0; i < 4; ++i) {
+                code_ = (code_ << 8) | next();
+            }
+        }
+
+        /**
+         * @brief Decodes one symbol from a model context.
+         * @return False if the stream does not correspond to any symbol (corrupt input)
+         */
+        bool decode(const std::array<uint16_t, 257>& cum, uint8_t& symbol) {
+            range_ >>= SNAPSHOT_MODEL_BITS;
+            const uint32_t value = code_ / range_;
+            if (value >= cum[256]) return false;
+
+            // Last cumulative entry <= value
+            const auto it = std::upper_bound(cum.begin(), cum.end(), static_cast<uint16_t>(value));
+            const size_t s = static_cast<size_t>(it - cum.begin()) - 1;
+            symbol = static_cast<uint8_t>(s);
+
+            code_ -= cum[s] * range_;
+            range_ *= static_cast<uint32_t>(cum[s + 1] - cum[s]);
+            while (range_ < TOP) {
+                code_ = (code_ << 8) | next();
+                range_ <<= 8;
+            }
+            return true;
+        }
+    };
+
+    uint32_t floatBits(float f) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    float bitsToFloat(uint32_t bits) {
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /** @brief Maps small signed deltas (wrapped in uint32) to small unsigned values. */
+    uint32_t zigzag(uint32_t delta) {
+        return (delta << 1) ^ (0u - (delta >> 31));
+    }
+
+    uint32_t unzigzag(uint32_t value) {
+        return (value >> 1) ^ (0u - (value & 1));
+    }
+
+    void putResidual(uint8_t* symbols, uint32_t current, uint32_t reference) {
+        const uint32_t residual = zigzag(current - reference);
+        for (int i = 0; i < 4; ++i) {
+            symbols[i] = static_cast<uint8_t>(residual >> (8 * i));
+        }
+    }
+
+    uint32_t getResidual(const uint8_t* symbols, uint32_t reference) {
+        uint32_t residual = 0;
+        for (int i = 0; i < 4; ++i) {
+            residual |= static_cast<uint32_t>(symbols[i]) << (8 * i);
+        }
+        return reference + unzigzag(residual);
+    }
+}
+
+void snapshotToSymbols(const Packet& snapshot, const Packet& baseline, uint8_t* symbols) {
+    putResidual(symbols + 0, snapshot.seq, baseline.seq);
+    putResidual(symbols + 4, floatBits(snapshot.x), floatBits(baseline.x));
+    putResidual(symbols + 8, floatBits(snapshot.y), floatBits(baseline.y));
+    putResidual(symbols + 12, floatBits(snapshot.vx), floatBits(baseline.vx));
+    putResidual(symbols + 16, floatBits(snapshot.vy), floatBits(baseline.vy));
+}
+
+Packet snapshotFromSymbols(const uint8_t* symbols, const Packet& baseline) {
+    Packet snapshot;
+    snapshot.seq = getResidual(symbols + 0, baseline.seq);
+    snapshot.x = bitsToFloat(getResidual(symbols + 4, floatBits(baseline.x)));
+    snapshot.y = bitsToFloat(getResidual(symbols + 8, floatBits(baseline.y)));
+    snapshot.vx = bitsToFloat(getResidual(symbols + 12, floatBits(baseline.vx)));
+    snapshot.vy = bitsToFloat(getResidual(symbols + 16, floatBits(baseline.vy)));
+    return snapshot;
+}
+
+size_t encodeSnapshot(const Packet& snapshot, const Packet& baseline, char* out, size_t capacity) {
+    uint8_t symbols[SNAPSHOT_SYMBOLS];
+    snapshotToSymbols(snapshot, baseline, symbols);
+
+    // Worst case is 12 bits per symbol plus flush, so 2x the raw size never overflows
+    uint8_t coded[2 * SNAPSHOT_SYMBOLS];
+    RangeEncoder encoder(coded, sizeof(coded));
+    for (size_t i = 0; i < SNAPSHOT_SYMBOLS; ++i) {
+        const auto& cum = MODEL.cum[i];
+        encoder.encode(cum[symbols[i]], static_cast<uint32_t>(cum[symbols[i] + 1] - cum[symbols[i]]));
+    }
+    const size_t codedLength = encoder.finish();
+
+    if (codedLength == 0 || codedLength >= Packet::size()) {
+        // Incompressible: store raw. A length of exactly Packet::size() marks raw on decode.
+        if (capacity < Packet::size()) return 0;
+        snapshot.serialize(out);
+        return Packet::size();
+    }
+    if (capacity < codedLength) return 0;
+    memcpy(out, coded, codedLength);
+    return codedLength;
+}
+
+bool decodeSnapshot(const char* in, size_t length, const Packet& baseline, Packet& snapshot) {
+    if (length == Packet::size()) {
+        snapshot.deserialize(in);
+        return true;
+    }
+    if (length == 0 || length > Packet::size()) {
+        return false;
+    }
+
+    uint8_t symbols[SNAPSHOT_SYMBOLS];
+    RangeDecoder decoder(reinterpret_cast<const uint8_t*>(in), length);
+    for (size_t i = 0; i < SNAPSHOT_SYMBOLS; ++i) {
+        if (!decoder.decode(MODEL.cum[i], symbols[i])) {
+            return false;
+        }
+    }
+    snapshot = snapshotFromSymbols(symbols, baseline);
+    return true;
+}
+
+// --- SnapshotModelTrainer implementation ---
+
+void SnapshotModelTrainer::observe(const Packet& snapshot, const Packet& baseline) {
+    uint8_t symbols[SNAPSHOT_SYMBOLS];
+    snapshotToSymbols(snapshot, baseline, symbols);
+    for (size_t i = 0; i < SNAPSHOT_SYMBOLS; ++i) {
+        counts_[i][symbols[i]]++;
+    }
+    samples_++;
+}
+
+SnapshotFrequencyTable SnapshotModelTrainer::frequencies() const {
+    constexpr uint32_t total = 1u << SNAPSHOT_MODEL_BITS;
+    SnapshotFrequencyTable table{};
+
+    for (size_t ctx = 0; ctx < SNAPSHOT_SYMBOLS; ++ctx) {
+        // Every symbol keeps frequency 1 so unseen bytes remain encodable;
+        // the rest of the budget is split proportionally to the observed counts.
+        const uint32_t budget = total - 256;
+        uint32_t assigned = 0;
+        for (size_t s = 0; s < 256; ++s) {
+            uint32_t share = samples_ > 0
+                ? static_cast<uint32_t>(counts_[ctx][s] * budget / samples_)
+                : budget / 256;
+            table[ctx][s] = static_cast<uint16_t>(1 + share);
+            assigned += table[ctx][s];
+        }
+
+        // Rounding leftovers go to the most frequent symbol
+        const auto top = std::max_element(counts_[ctx].begin(), counts_[ctx].end()) - counts_[ctx].begin();
+        table[ctx][top] = static_cast<uint16_t>(table[ctx][top] + (total - assigned));
+    }
+    return table;
+}
+
+std::string SnapshotModelTrainer::toSource() const {
+    const SnapshotFrequencyTable table = frequencies();
+    static const char* fieldNames[] = { "seq", "x", "y", "vx", "vy" };
+
+    std::ostringstream src;
+    src << "// Generated by SnapshotModelTrainer::toSource() from " << samples_ << " snapshots.\n";
+    src << "// Regenerate with: netcode_tests \"[Train]\" (writes snapshot_model.inl to the working directory).\n";
+    src << "constexpr SnapshotFrequencyTable SNAPSHOT_MODEL_FREQUENCIES = {{\n";
+    for (size_t ctx = 0; ctx < SNAPSHOT_SYMBOLS; ++ctx) {
+        src << "    // " << fieldNames[ctx / 4] << " residual, byte " << (ctx % 4) << "\n";
+        src << "    {{";
+        for (size_t s = 0; s < 256; ++s) {
+            if (s % 16 == 0) src << "\n        ";
+            src << table[ctx][s] << (s + 1 < 256 ? "," : "");
+            if (s % 16 != 15) src << " ";
+        }
+        src << "\n    }}" << (ctx + 1 < SNAPSHOT_SYMBOLS ? "," : "") << "\n";
+    }
+    src << "}};\n";
+    return src.str();
+}
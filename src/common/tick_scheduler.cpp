@@ -0,0 +1,129 @@
+/**
+ * @file tick_scheduler.cpp
+ * @brief Absolute-deadline tick scheduling with hybrid sleep/spin waiting and catch-up policies.
+ *
+ * @see tick_scheduler.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/tick_scheduler.hpp"
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace {
+    const std::vector<std::chrono::nanoseconds> REPORT_BUCKETS = {
+        std::chrono::microseconds(10), std::chrono::microseconds(50), std::chrono::microseconds(100),
+        std::chrono::microseconds(500), std::chrono::milliseconds(1), std::chrono::milliseconds(5)
+    };
+    const char* const REPORT_LABELS[] = { "<10us", "<50us", "<100us", "<500us", "<1ms", "<5ms", ">=5ms" };
+
+    std::string histogramLine(const JitterStats& stats) {
+        std::ostringstream line;
+        line << stats.summary() << " [";
+        const std::vector<size_t> counts = stats.histogram(REPORT_BUCKETS);
+        for (size_t i = 0; i < counts.size(); ++i) {
+            line << (i ? " " : "") << REPORT_LABELS[i] << ":" << counts[i];
+        }
+        line << "]";
+        return line.str();
+    }
+}
+
+TickScheduler::TickScheduler(const Config& config, Clock::time_point first)
+    : config_(config), next_(first == Clock::time_point::min() ? Clock::now() + config.interval : first) {}
+
+void TickScheduler::sleepUntil(Clock::time_point deadline) {
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC, so the deadline can be handed to the kernel as is;
+    // an absolute sleep does not drift if the thread is preempted before it sleeps
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    if (sinceEpoch <= 0) {
+        return;
+    }
+    timespec target{};
+    target.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+    target.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+void TickScheduler::waitForTick() const {
+    if (Clock::now() < spinStart()) {
+        sleepUntil(spinStart());
+    }
+    while (Clock::now() < next_) {
+        std::this_thread::yield();
+    }
+}
+
+void TickScheduler::beginTick(Clock::time_point now) {
+    deadline_ = next_;
+    began_ = now;
+    if (!late_) {
+        startJitter_.record(now - deadline_);
+    }
+    late_ = false;
+    ++ticks_;
+}
+
+void TickScheduler::endTick(Clock::time_point now) {
+    const Clock::duration took = now - began_;
+    if (took > config_.interval) {
+        overruns_.record(took - config_.interval);
+    }
+
+    const Clock::time_point following = deadline_ + config_.interval;
+    if (now < following) {
+        next_ = following;
+        catchUpRun_ = 0;
+        return;
+    }
+
+    // Deadlines already passed after following, each one interval apart
+    const uint64_t missed = static_cast<uint64_t>((now - following) / config_.interval);
+    late_ = true;
+    switch (config_.policy) {
+    case CatchUp::Compress:
+        if (catchUpRun_ < config_.maxCompressed) {
+            ++catchUpRun_;
+            ++compressed_;
+            next_ = following;
+            break;
+        }
+        catchUpRun_ = 0;
+        [[fallthrough]];
+    case CatchUp::Skip:
+        next_ = following + missed * config_.interval;
+        skipped_ += missed;
+        break;
+    case CatchUp::RunLate:
+        next_ = now;
+        break;
+    }
+}
+
+std::string TickScheduler::report() const {
+    std::ostringstream text;
+    text << "start jitter " << histogramLine(startJitter_) << "; "
+        << ticks_ << " ticks, " << skipped_ << " skipped, " << compressed_ << " compressed\n"
+        << "overruns " << histogramLine(overruns_);
+    return text.str();
+}
+
+void TickScheduler::resetStats() {
+    startJitter_.reset();
+    overruns_.reset();
+    ticks_ = 0;
+    skipped_ = 0;
+    compressed_ = 0;
+}
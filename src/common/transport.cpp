@@ -0,0 +1,318 @@
+/**
+ * @file transport.cpp
+ * @brief SocketTransport (recvmmsg/sendmmsg with UDP GSO/GRO, or recvfrom/sendto) and backend selection.
+ *
+ * @see transport.hpp
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include "netcode/common/transport.hpp"
+#include "netcode/common/io_uring_transport.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+#ifdef __linux__
+#include <linux/sock_diag.h>
+#include <netinet/udp.h>
+#include <ctime>
+#endif
+
+namespace {
+    /**
+     * @brief Waits until the socket is readable or the timeout expires.
+     */
+    bool waitReadable(SocketHandle sock, std::chrono::microseconds timeout) {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(sock, &readSet);
+        timeval tv;
+        tv.tv_sec = static_cast<long>(timeout.count() / 1000000);
+        tv.tv_usec = static_cast<long>(timeout.count() % 1000000);
+        return select(static_cast<int>(sock + 1), &readSet, nullptr, nullptr, &tv) > 0;
+    }
+
+#ifdef __linux__
+    // Largest UDP payload over IPv4; a GSO send may not exceed it in total
+    constexpr size_t MAX_GSO_BYTES = 65507;
+
+    bool sameDestination(const sockaddr_in& a, const sockaddr_in& b) {
+        return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+    }
+#endif
+}
+
+#ifdef __linux__
+void DatagramTransport::enableReceiveMetadata(SocketHandle sock) {
+    const int on = 1;
+    setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+    setsockopt(sock, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+
+    // Drops before this transport existed (such as in a process this server took over from) are not ours
+    uint32_t meminfo[SK_MEMINFO_VARS] = {};
+    socklen_t size = sizeof(meminfo);
+    if (getsockopt(sock, SOL_SOCKET, SO_MEMINFO, meminfo, &size) == 0 && size > SK_MEMINFO_DROPS * sizeof(uint32_t)) {
+        dropBaseline_ = meminfo[SK_MEMINFO_DROPS];
+    }
+}
+
+DatagramTransport::MessageMetadata DatagramTransport::readMetadata(const msghdr& msg) {
+    static_assert(CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(int)) <= METADATA_CONTROL,
+        "Control buffer must hold a timestamp, a drop counter and a GRO segment size");
+    MessageMetadata metadata;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&msg), cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec time;
+            std::memcpy(&time, CMSG_DATA(cmsg), sizeof(time));
+            metadata.kernelTime = int64_t(time.tv_sec) * 1000000000 + time.tv_nsec;
+        }
+        else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+            // The socket's drop counter when this datagram was queued (wraps at 2^32)
+            uint32_t counter = 0;
+            std::memcpy(&counter, CMSG_DATA(cmsg), sizeof(counter));
+            stats_.kernelDrops = std::max<uint64_t>(stats_.kernelDrops, counter - dropBaseline_);
+        }
+        else if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int size = 0;
+            std::memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+            metadata.groSegment = static_cast<size_t>(size);
+        }
+    }
+    return metadata;
+}
+#endif
+
+SocketTransport::SocketTransport(SocketHandle sock, bool offload, bool receive)
+    : sock_(sock), queue_(BATCH) {
+#ifdef __linux__
+    // GSO needs no socket option (a send the kernel rejects turns it off); GRO does
+    gso_ = offload;
+#else
+    (void)offload;
+#endif
+    if (!receive) {
+        return;  // GRO and the metadata options belong to whoever receives
+    }
+#ifdef __linux__
+    const int gro = offload ? 1 : 0;
+    gro_ = setsockopt(sock_, SOL_UDP, UDP_GRO, &gro, sizeof(gro)) == 0 && offload;
+    enableReceiveMetadata(sock_);
+#endif
+    slotSize_ = gro_ ? GRO_BUFFER : MAX_DATAGRAM;
+    receiveBuffers_.reset(new char[BATCH * slotSize_]);
+    receiveAddrs_.resize(BATCH);
+}
+
+size_t SocketTransport::receive(std::vector<ReceivedDatagram>& batch, std::chrono::microseconds timeout) {
+    batch.clear();
+    if (!receiveBuffers_) {
+        return 0;
+    }
+    ++stats_.syscalls;
+    if (!waitReadable(sock_, std::max(timeout, std::chrono::microseconds(0)))) {
+        return 0;
+    }
+
+#ifdef __linux__
+    // One call drains up to BATCH messages; with GRO a message may hold several datagrams
+    mmsghdr messages[BATCH];
+    iovec iovs[BATCH];
+    alignas(cmsghdr) char control[BATCH][METADATA_CONTROL];
+    for (size_t i = 0; i < BATCH; ++i) {
+        iovs[i] = { receiveBuffers_.get() + i * slotSize_, slotSize_ };
+        std::memset(&messages[i], 0, sizeof(mmsghdr));
+        messages[i].msg_hdr.msg_name = &receiveAddrs_[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        messages[i].msg_hdr.msg_iov = &iovs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_control = control[i];
+        messages[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+    ++stats_.syscalls;
+    const int count = recvmmsg(sock_, messages, BATCH, MSG_DONTWAIT, nullptr);
+    for (int i = 0; i < count; ++i) {
+        const char* data = receiveBuffers_.get() + i * slotSize_;
+        const size_t length = messages[i].msg_len;
+        const bool truncated = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+
+        // A coalesced buffer carries its segment size; every segment but the last has exactly that size
+        const MessageMetadata metadata = readMetadata(messages[i].msg_hdr);
+        const size_t segment = gro_ ? metadata.groSegment : 0;
+        if (segment == 0 || segment >= length) {
+            batch.push_back({ receiveAddrs_[i], data, std::min(length, MAX_DATAGRAM), truncated || length > MAX_DATAGRAM,
+                metadata.kernelTime });
+            continue;
+        }
+        for (size_t offset = 0; offset < length; offset += segment) {
+            const size_t size = std::min(segment, length - offset);
+            const bool last = offset + size >= length;
+            batch.push_back({ receiveAddrs_[i], data + offset, std::min(size, MAX_DATAGRAM),
+                size > MAX_DATAGRAM || (last && truncated), metadata.kernelTime });
+            ++stats_.groSegments;
+        }
+    }
+#else
+    // One datagram per call; keep going while more are ready
+    for (size_t i = 0; i < BATCH; ++i) {
+        if (i > 0) {
+            ++stats_.syscalls;
+            if (!waitReadable(sock_, std::chrono::microseconds(0))) {
+                break;
+            }
+        }
+        char* buffer = receiveBuffers_.get() + i * slotSize_;
+#ifdef _WIN32
+        int addrSize = sizeof(sockaddr_in);
+#else
+        socklen_t addrSize = sizeof(sockaddr_in);
+#endif
+        ++stats_.syscalls;
+        const int bytes = recvfrom(sock_, buffer, static_cast<int>(MAX_DATAGRAM), 0,
+            reinterpret_cast<sockaddr*>(&receiveAddrs_[i]), &addrSize);
+        if (bytes < 0) {
+#ifdef _WIN32
+            if (WSAGetLastError() == WSAEMSGSIZE) {
+                batch.push_back({ receiveAddrs_[i], buffer, MAX_DATAGRAM, true });
+                continue;
+            }
+#endif
+            break;
+        }
+        batch.push_back({ receiveAddrs_[i], buffer, static_cast<size_t>(bytes), false });
+    }
+#endif
+    stats_.received += batch.size();
+    return batch.size();
+}
+
+bool SocketTransport::send(const sockaddr_in& to, const char* data, size_t size) {
+    if (size > MAX_DATAGRAM) {
+        return false;
+    }
+    if (queued_ == queue_.size()) {
+        flush();
+    }
+    Outgoing& out = queue_[queued_++];
+    out.addr = to;
+    out.size = size;
+    std::memcpy(out.data, data, size);
+    return true;
+}
+
+size_t SocketTransport::flush() {
+    const size_t count = queued_;
+    queued_ = 0;
+
+#ifdef __linux__
+    iovec iovs[BATCH];
+    for (size_t i = 0; i < count; ++i) {
+        iovs[i] = { queue_[i].data, queue_[i].size };
+    }
+    mmsghdr messages[BATCH];
+    size_t segments[BATCH];
+    alignas(cmsghdr) char control[BATCH][CMSG_SPACE(sizeof(uint16_t))];
+
+    size_t index = 0;
+    while (index < count) {
+        // One message per run of datagrams to the same destination with the same size
+        // (the last may be shorter); the kernel splits a run back into datagrams (GSO)
+        size_t messageCount = 0;
+        for (size_t position = index; position < count; ++messageCount) {
+            const Outgoing& first = queue_[position];
+            size_t run = 1;
+            size_t bytes = first.size;
+            while (gso_ && first.size > 0 && position + run < count) {
+                const Outgoing& next = queue_[position + run];
+                if (!sameDestination(next.addr, first.addr) || next.size > first.size || bytes + next.size > MAX_GSO_BYTES) {
+                    break;
+                }
+                bytes += next.size;
+                ++run;
+                if (next.size < first.size) {
+                    break;
+                }
+            }
+
+            msghdr& msg = messages[messageCount].msg_hdr;
+            std::memset(&messages[messageCount], 0, sizeof(mmsghdr));
+            msg.msg_name = const_cast<sockaddr_in*>(&first.addr);
+            msg.msg_namelen = sizeof(sockaddr_in);
+            msg.msg_iov = &iovs[position];
+            msg.msg_iovlen = run;
+            if (run > 1) {
+                msg.msg_control = control[messageCount];
+                msg.msg_controllen = sizeof(control[messageCount]);
+                cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                const uint16_t segmentSize = static_cast<uint16_t>(first.size);
+                std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+            }
+            segments[messageCount] = run;
+            position += run;
+        }
+
+        ++stats_.syscalls;
+        const int sent = sendmmsg(sock_, messages, static_cast<unsigned>(messageCount), 0);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (segments[0] > 1 && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP)) {
+                gso_ = false;  // No UDP GSO in this kernel or on this route; send datagrams separately from now on
+                continue;
+            }
+            stats_.sendErrors += segments[0];  // The first remaining message failed; skip it and continue
+            index += segments[0];
+            continue;
+        }
+        for (int m = 0; m < sent; ++m) {
+            stats_.sent += segments[m];
+            if (segments[m] > 1) {
+                stats_.gsoSegments += segments[m];
+            }
+            index += segments[m];
+        }
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        ++stats_.syscalls;
+        const int sent = sendto(sock_, queue_[i].data, static_cast<int>(queue_[i].size), 0,
+            reinterpret_cast<const sockaddr*>(&queue_[i].addr), sizeof(sockaddr_in));
+        if (sent < 0) {
+            ++stats_.sendErrors;
+        }
+        else {
+            ++stats_.sent;
+        }
+    }
+#endif
+    return count;
+}
+
+const char* SocketTransport::name() const {
+#ifdef __linux__
+    return "recvmmsg/sendmmsg";
+#else
+    return "recvfrom/sendto";
+#endif
+}
+
+std::unique_ptr<DatagramTransport> makeTransport(SocketHandle sock, TransportKind preferred, bool receive) {
+#ifdef __linux__
+    if (preferred == TransportKind::IoUring) {
+        if (auto transport = IoUringTransport::create(sock, receive)) {
+            return transport;
+        }
+    }
+#else
+    (void)preferred;
+#endif
+    return std::make_unique<SocketTransport>(sock, true, receive);
+}
@@ -1,30 +1,80 @@
 /**
  * @file server.cpp
- * @brief Cross-platform UDP server for network programming project.
+ * @brief UDP server for network programming project (Linux first; portable fallbacks elsewhere).
  *
  * Listens for UDP packets from clients on port 54000,
- * decodes each packet, processes input commands, and sends back authoritative game state.
+ * decodes each packet, routes the client to a room (match), and simulates
+ * all rooms in parallel at a fixed tick rate, sending back authoritative game state.
  *
  * Demonstrates:
  * - Use of Winsock (on Windows) or BSD sockets (on macOS/Linux) for raw UDP communication
  * - Serialization/deserialization of custom packet types (see Packet in packet.hpp)
  * - Authoritative server-side game simulation for multiplayer games
- * - Client input processing and server-side physics
+ * - Session sharding: many independent rooms per process on a worker thread pool
+ * - Client input processing and server-side physics, with players colliding as circles
+ *   (uniform grid broadphase, circle narrowphase; see collision.hpp)
  * - Robust error handling and packet validation
+ * - Hot restart: a new binary started with --takeover receives the bound socket and
+ *   all room state from the running server and continues without dropping sessions; the
+ *   control socket is private to the user ($XDG_RUNTIME_DIR, or --control=PATH)
+ * - Crash recovery: room state is checkpointed to a memory-mapped file every second
+ *   (written on a background thread) and restored on the next start
+ * - Batched datagram I/O (DatagramTransport): recvmmsg/sendmmsg, or with --io-uring
+ *   a multishot io_uring receive into a provided buffer ring (falls back if unavailable)
+ * - Low-latency profile (--low-latency, --cores=LIST): threads pinned to cores of one NUMA
+ *   node with node-local memory, busy polling, large socket buffers and DSCP marking
+ * - Pipelined I/O: a receive thread and a send thread exchange pooled packet buffers with
+ *   the simulation thread through lock-free rings, so socket calls never stall a tick.
+ *   Its log lines go through an AsyncLog ring to a writer thread (per-datagram warnings
+ *   rate-limited), and a TakeoverWatcher thread waits on the control socket
+ * - Precise ticks (TickScheduler): absolute deadlines, sleeping until just before each one and
+ *   spinning the rest; overrun catch-up policy chosen with --catch-up=skip|compress|run-late
+ * - Dead reckoning (--dead-reckoning[=UNITS]): a client is only sent a snapshot when its own
+ *   linear extrapolation of the last one is off by more than UNITS (default 2), or every 200 ms.
+ *   Snapshots carry their own per-client sequence number (SnapshotAck), so clients count only
+ *   lost snapshots as loss, never skipped ones
+ * - Held input: clients only send input when it changes (plus repeats and a heartbeat), so
+ *   before every tick a moving client that sent nothing keeps moving with its last input
+ * - Overload shedding (LoadGovernor): when packet or tick processing exceeds its budget, idle
+ *   clients are answered less often, queued inputs are coalesced and new clients are refused,
+ *   step by step, and undone once the load has stayed low
  *
  * Program flow:
  * 1. Initialize socket API (WSAStartup on Windows; nothing needed on Unix)
  * 2. Create a UDP socket (socket)
  * 3. Bind the socket to port 54000 (bind)
- * 4. Enter main loop:
- *    a. Wait for incoming packets (recvfrom)
- *    b. Deserialize the buffer into a Packet struct
+ * 4. Start the I/O threads: the receive thread takes every ready datagram in batches
+ *    (transport->receive) and passes each in a pooled buffer to the simulation thread;
+ *    the send thread sends whatever the simulation thread publishes (transport->send, flush)
+ * 5. Enter the simulation loop:
+ *    a. Wait for buffers from the receive thread until shortly before the next tick is due,
+ *       then keep polling for them until it is (the spin window)
+ *    b. For each datagram, record how long it queued in the kernel (SO_TIMESTAMPNS),
+ *       verify the CRC32C trailer, then decode the packet in place
+ *       from the pooled buffer (PacketView)
  *    c. Validate packet contents for security
- *    d. Process input commands and update server-side player state
- *    e. Send back authoritative player position to the client (sendto)
- * 5. Cleanup resources on shutdown (closesocket/WSACleanup on Windows, close() on Unix)
+ *    d. Route the client to its room (the first packet joins a room) and queue the input
+ *    e. Every tick, hold the last input of moving clients that sent none, simulate all rooms
+ *       on the worker pool, then serialize every room's
+ *       authoritative positions into pooled buffers for the send thread; the tick's time and
+ *       the time spent per datagram decide the load shedding level for the next tick
+ *    f. Every 60 ticks, hand a serialized copy of all rooms to the checkpoint writer;
+ *       every 600 ticks, print histograms of tick start jitter and tick overruns, and the load
+ *    g. Every tick, check whether the watcher thread accepted a takeover request; if so hand
+ *       the socket and state to the new process and exit once it confirms
+ * 6. Cleanup resources on shutdown (closesocket/WSACleanup on Windows, close() on Unix)
  *
- * This code is portable and will compile and run on both Windows and Unix-like systems.
+ * Platforms: Linux is the target. Its fast paths sit behind __linux__ checks and fall back
+ * where they are missing:
+ *   - io_uring (--io-uring) and recvmmsg/sendmmsg with UDP GSO/GRO -> one recvfrom/sendto per datagram
+ *   - epoll in the Reactor -> poll() on other POSIX systems, WSAPoll() on Windows
+ *   - clock_nanosleep(TIMER_ABSTIME) in TickScheduler -> std::this_thread::sleep_until
+ *   - memfd_create for the handoff segment -> an unlinked shm_open object on other POSIX systems
+ *   - SO_TIMESTAMPNS, SO_BUSY_POLL, core pinning and NUMA policy -> not measured / not applied
+ * Hot restart (SCM_RIGHTS over a Unix domain socket) and the memory-mapped checkpoint need
+ * POSIX; on Windows they are compiled out (hot restart reports itself unavailable and the
+ * server starts fresh, without crash recovery), and the rest runs on Winsock with the
+ * fallbacks above. Only the Linux build is load-tested.
  *
  * @author Aryan Malekian & Jonathan Skomsy Hbertz,  w/ use of A.I. Models
  * @date 20.05.2025
@@ -38,6 +88,7 @@ typedef SOCKET socket_t;
 #pragma comment(lib, "Ws2_32.lib")
 #else
 #include <sys/socket.h>
+#include <sys/select.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cerrno>
@@ -49,24 +100,23 @@ typedef int socket_t;
 #include <chrono>
 #include <iomanip>
 #include <sstream>
-#include <unordered_map>
+#include <vector>
+#include <thread>
 #include <cmath>
+#include <cstdlib>
 #include <algorithm>
+#include "netcode/common/async_log.hpp"
+#include "netcode/common/checkpoint.hpp"
+#include "netcode/common/hot_restart.hpp"
+#include "netcode/common/io_pipeline.hpp"
+#include "netcode/common/latency_profile.hpp"
+#include "netcode/common/load_governor.hpp"
 #include "netcode/common/packet.hpp"
-
-/**
- * @struct ClientState
- * @brief Server-side state for each connected client
- */
-struct ClientState {
-    float x, y;           // Authoritative position
-    float vx, vy;         // Current velocity  
-    uint32_t lastSeq;     // Last processed sequence number
-    std::chrono::steady_clock::time_point lastUpdate;
-
-    ClientState() : x(200.0f), y(300.0f), vx(0.0f), vy(0.0f), lastSeq(0),
-        lastUpdate(std::chrono::steady_clock::now()) {}
-};
+#include "netcode/common/packet_view.hpp"
+#include "netcode/common/room.hpp"
+#include "netcode/common/room_scheduler.hpp"
+#include "netcode/common/tick_scheduler.hpp"
+#include "netcode/common/transport.hpp"
 
 /**
  * @brief Prints detailed error information for socket operations.
@@ -138,7 +188,72 @@ std::string getCurrentTimestamp() {
     return ss.str();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Unix domain socket where a replacement server asks for our sockets and state: private to
+    // this user ($XDG_RUNTIME_DIR or /tmp/netcode-server-UID), or wherever --control=PATH says
+    std::string controlPath = controlSocketPath();
+    const auto HANDOFF_ACK_TIMEOUT = std::chrono::milliseconds(2000);
+    // Crash recovery file (in the working directory) and how often it is written
+    const std::string CHECKPOINT_PATH = "netcode-server.ckpt";
+    const uint64_t CHECKPOINT_INTERVAL_TICKS = 60;
+    // How often tick timing (start jitter and overruns) is printed
+    const uint64_t JITTER_REPORT_TICKS = 600;
+
+    bool takeover = false;
+    TransportKind transportKind = TransportKind::Socket;
+    bool lowLatency = false;
+    LatencyProfile latencyProfile;
+    TickScheduler::CatchUp catchUp = TickScheduler::CatchUp::Skip;
+    DeadReckoning deadReckoning;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--takeover") {
+            takeover = true;
+        }
+        else if (std::string(argv[i]).rfind("--control=", 0) == 0) {
+            controlPath = std::string(argv[i]).substr(10);
+        }
+        else if (std::string(argv[i]) == "--io-uring") {
+            transportKind = TransportKind::IoUring;
+        }
+        else if (std::string(argv[i]) == "--low-latency") {
+            lowLatency = true;
+        }
+        else if (std::string(argv[i]).rfind("--cores=", 0) == 0) {
+            // First core for this thread, the rest for workers; implies --low-latency
+            latencyProfile.cores = parseCoreList(std::string(argv[i]).substr(8));
+            if (latencyProfile.cores.empty()) {
+                std::cerr << "Invalid core list: " << argv[i] << " (expected e.g. --cores=2-5,8)" << std::endl;
+                return 1;
+            }
+            lowLatency = true;
+        }
+        else if (std::string(argv[i]).rfind("--catch-up=", 0) == 0) {
+            // What to do with ticks missed by an overrunning tick
+            const std::string policy = std::string(argv[i]).substr(11);
+            if (policy == "skip") catchUp = TickScheduler::CatchUp::Skip;
+            else if (policy == "compress") catchUp = TickScheduler::CatchUp::Compress;
+            else if (policy == "run-late") catchUp = TickScheduler::CatchUp::RunLate;
+            else {
+                std::cerr << "Invalid catch-up policy: " << argv[i] << " (expected skip, compress or run-late)" << std::endl;
+                return 1;
+            }
+        }
+        else if (std::string(argv[i]) == "--dead-reckoning") {
+            deadReckoning.enabled = true;
+        }
+        else if (std::string(argv[i]).rfind("--dead-reckoning=", 0) == 0) {
+            // Send only when the client's extrapolation drifts past this many world units
+            const std::string value = std::string(argv[i]).substr(17);
+            char* end = nullptr;
+            deadReckoning.threshold = std::strtof(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || !(deadReckoning.threshold > 0.0f)) {
+                std::cerr << "Invalid dead-reckoning threshold: " << argv[i] << " (expected e.g. --dead-reckoning=2.5)" << std::endl;
+                return 1;
+            }
+            deadReckoning.enabled = true;
+        }
+    }
+
 #ifdef _WIN32
     // (1) Initialize Winsock API (required on Windows)
     WSADATA wsa;
@@ -151,176 +266,445 @@ int main() {
     std::cout << "[" << getCurrentTimestamp() << "] Starting UDP server on Unix-like system" << std::endl;
 #endif
 
-    // (2) Create a UDP socket (IPv4, datagram, UDP protocol)
-    socket_t sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    // (4) Rooms, worker pool and buffers for incoming packets (set up before the socket: a takeover restores into them)
+    const size_t ROOM_CAPACITY = 8;                                       // Clients per match
+    const size_t MAX_ROOMS = 512;
+    const auto TICK_INTERVAL = std::chrono::microseconds(1000000 / 60);   // 60 Hz simulation
+    const auto IDLE_TIMEOUT = std::chrono::seconds(10);                   // Silent clients leave their room
+
+    // Low-latency profile: pin this thread before anything is allocated, so the rooms and their
+    // client state (created and first touched here) land on its NUMA node, then pin each worker
+    size_t workerCount = std::max(1u, std::thread::hardware_concurrency());
+    CorePlan cores;
+    JobSystem::WorkerStart pinWorker;
+    if (lowLatency) {
+        cores = planCores(latencyProfile, 0);
+        workerCount = cores.workers.size();
+        const bool pinned = pinCurrentThread(cores.server);
+        const int node = numaNodeOfCore(cores.server);
+        const bool local = preferLocalMemory(node);
+        std::cout << "[" << getCurrentTimestamp() << "] Low-latency profile: server thread "
+            << (pinned ? "pinned to core " + std::to_string(cores.server) : std::string("not pinned"))
+            << ", NUMA node " << node << (local ? " (local memory preferred)" : " (default memory policy)")
+            << ", workers on cores";
+        for (int core : cores.workers) {
+            std::cout << " " << core;
+        }
+        std::cout << std::endl;
+        pinWorker = [&cores](size_t worker) { pinCurrentThread(cores.workers[worker]); };
+    }
+
+    RoomRouter router(ROOM_CAPACITY, MAX_ROOMS);
+    router.setCollisions(true);  // Players push each other apart instead of passing through
+    router.setDeadReckoning(deadReckoning);
+    RoomScheduler scheduler(workerCount, pinWorker);
+    std::vector<std::vector<RoomOutput>> outboxes(MAX_ROOMS);  // One per room: workers may interleave rooms
+
+    uint64_t ticks = 0;
+    TickScheduler tickClock({ TICK_INTERVAL, catchUp });
+
+    // Everything the simulation loop logs is written by the log's own thread
+    AsyncLog log;
+
+    // Overload shedding: half a tick for the tick itself, LoadBudget's default per datagram
+    LoadBudget loadBudget;
+    loadBudget.perTick = TICK_INTERVAL / 2;
+    LoadGovernor governor(loadBudget, [&router, &log](const LoadTransition& change) {
+        router.setShedding(change.shedding);
+        log.info() << "Load " << (change.to > change.from ? "shedding" : "recovered") << ": "
+            << loadLevelName(change.from) << " -> " << loadLevelName(change.to) << " (load " << std::fixed << std::setprecision(2)
+            << change.load << ", tick " << change.tickTime.count() / 1000.0 << " us, "
+            << change.packetTime.count() / 1000.0 << " us per datagram)";
+    });
+    socket_t sock;
+
+    if (takeover) {
+        // (2+3) Receive the already bound socket and the room state from the running server
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<int> fds;
+        std::vector<char> state;
+        HandoffHeader header;
+        int peer = takeOver(controlPath, fds, state, header);
+        if (peer < 0 || fds.size() != 1) {
+            std::cerr << "[" << getCurrentTimestamp() << "] ERROR: Takeover from " << controlPath
+                << " failed (is a server running as this user?)" << std::endl;
+            return 1;
+        }
+        sock = fds[0];
+        if (!router.load(state.data(), state.size())) {
+            // Without an ack the old server keeps running; leave it the socket
+            std::cerr << "[" << getCurrentTimestamp() << "] ERROR: Handed-off state is incompatible with this build" << std::endl;
+            return 1;
+        }
+        ticks = header.ticks;
+        tickClock.setNextTick(std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(header.nextTick)));
+        sendAck(peer);
+
+        const auto took = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[" << getCurrentTimestamp() << "] Took over " << router.clientCount() << " client(s) in "
+            << router.rooms().size() << " room(s) in " << std::fixed << std::setprecision(2) << took << " ms" << std::endl;
+    }
+    else {
+        // (2) Create a UDP socket (IPv4, datagram, UDP protocol)
+        sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
 #ifdef _WIN32
-    if (sock == INVALID_SOCKET) {
+        if (sock == INVALID_SOCKET) {
 #else
-    if (sock < 0) {
+        if (sock < 0) {
 #endif
-        printSocketError("socket");
+            printSocketError("socket");
 #ifdef _WIN32
-        WSACleanup();
+            WSACleanup();
 #endif
-        return 1;
-    }
-    std::cout << "[" << getCurrentTimestamp() << "] UDP socket created successfully" << std::endl;
+            return 1;
+        }
+        std::cout << "[" << getCurrentTimestamp() << "] UDP socket created successfully" << std::endl;
 
-    // (3) Prepare the server address struct and bind the socket to port 54000
-    sockaddr_in serverAddr{};
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_addr.s_addr = INADDR_ANY;   
-    serverAddr.sin_port = htons(54000);        
+        // (3) Prepare the server address struct and bind the socket to port 54000
+        sockaddr_in serverAddr{};
+        serverAddr.sin_family = AF_INET;
+        serverAddr.sin_addr.s_addr = INADDR_ANY;   
+        serverAddr.sin_port = htons(54000);        
 
-    if (bind(sock, (sockaddr*)&serverAddr, sizeof(serverAddr))
+        if (bind(sock, (sockaddr*)&serverAddr, sizeof(serverAddr))
 #ifdef _WIN32
-        == SOCKET_ERROR
+            == SOCKET_ERROR
 #else
-        < 0
+            < 0
 #endif
-        ) {
-        printSocketError("bind");
+            ) {
+            printSocketError("bind");
 #ifdef _WIN32
-        closesocket(sock);
-        WSACleanup();
+            closesocket(sock);
+            WSACleanup();
 #else
-        close(sock);
+            close(sock);
 #endif
-        return 1;
+            return 1;
+        }
+
+        std::cout << "[" << getCurrentTimestamp() << "] Server bound to port 54000 and listening..." << std::endl;
+
+        // Resume from the last checkpoint if the previous server died. Stored times are
+        // rebased to now, so the downtime counts neither as movement nor as idle time
+        std::vector<char> state;
+        CheckpointInfo info;
+        if (readCheckpoint(CHECKPOINT_PATH, state, info)) {
+            const auto savedAt = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(info.savedAt));
+            if (router.load(state.data(), state.size(), std::chrono::steady_clock::now() - savedAt)) {
+                ticks = info.ticks;
+                const auto age = std::chrono::system_clock::now().time_since_epoch() - std::chrono::nanoseconds(info.savedAtWall);
+                std::cout << "[" << getCurrentTimestamp() << "] Restored " << router.clientCount() << " client(s) in "
+                    << router.rooms().size() << " room(s) from checkpoint " << info.generation << " ("
+                    << std::chrono::duration_cast<std::chrono::seconds>(age).count() << " s old)" << std::endl;
+            }
+            else {
+                std::cerr << "[" << getCurrentTimestamp() << "] WARNING: Checkpoint " << CHECKPOINT_PATH
+                    << " does not match this build, starting empty" << std::endl;
+            }
+        }
     }
 
-    std::cout << "[" << getCurrentTimestamp() << "] Server bound to port 54000 and listening..." << std::endl;
+    if (lowLatency) {
+        const SocketProfileResult tuned = applySocketProfile(sock, latencyProfile);
+        std::cout << "[" << getCurrentTimestamp() << "] Socket profile: busy poll "
+            << (tuned.busyPoll ? std::to_string(latencyProfile.busyPollMicros) + " us" : std::string("unavailable"))
+            << ", receive buffer " << tuned.receiveBufferBytes / 1024 << " KiB, send buffer "
+            << tuned.sendBufferBytes / 1024 << " KiB, DSCP "
+            << (tuned.dscp ? std::to_string(latencyProfile.dscp) : std::string("unmarked")) << std::endl;
+    }
+
+    CheckpointWriter checkpoints(CHECKPOINT_PATH);
+    std::vector<char> checkpointState;
+    if (!checkpoints.isOpen()) {
+        std::cerr << "[" << getCurrentTimestamp() << "] WARNING: Cannot open " << CHECKPOINT_PATH
+            << ", crash recovery disabled" << std::endl;
+    }
     std::cout << "Waiting for client connections..." << std::endl;
     std::cout << "Server Mode: AUTHORITATIVE (processes input and sends back game state)" << std::endl;
 
-    // (4) Buffer and address storage for incoming packets
-    char buf[static_cast<int>(Packet::size())];
-    sockaddr_in clientAddr;
-#ifdef _WIN32
-    int clientAddrSize = sizeof(clientAddr);
-#else
-    socklen_t clientAddrSize = sizeof(clientAddr);
-#endif
+    const int control = controlPath.empty() ? -1 : createControlListener(controlPath);
+    if (control < 0) {
+        std::cerr << "[" << getCurrentTimestamp() << "] WARNING: No control socket"
+            << (controlPath.empty() ? std::string(" (no private runtime directory, use --control=PATH)") : " at " + controlPath)
+            << ", hot restart unavailable" << std::endl;
+    }
+    TakeoverWatcher takeovers(control);
+
+    std::cout << "Rooms: up to " << MAX_ROOMS << " x " << ROOM_CAPACITY << " clients, ticking at 60 Hz on "
+        << scheduler.workerCount() << " worker threads" << std::endl;
+
+    // Datagram I/O runs on its own threads (batched; --io-uring asks for the io_uring backend and
+    // falls back if the kernel lacks it). This thread only exchanges pooled buffers with them
+    IoThreads io(sock, transportKind);
+    io.start();
+    if (transportKind == TransportKind::IoUring && io.transportName().find("io_uring") == std::string::npos) {
+        std::cerr << "[" << getCurrentTimestamp() << "] WARNING: io_uring unavailable, using "
+            << io.transportName() << std::endl;
+    }
+    std::cout << "Datagram I/O: " << io.transportName() << " on a receive thread and a send thread" << std::endl;
+    if (deadReckoning.enabled) {
+        std::cout << "Dead reckoning: snapshots when extrapolation is off by more than " << deadReckoning.threshold
+            << " units, at least every " << deadReckoning.heartbeat.count() << " ms" << std::endl;
+    }
 
     uint64_t totalPacketsReceived = 0;
     uint64_t validPacketsProcessed = 0;
     uint64_t invalidPacketsDropped = 0;
+    uint64_t checksumFailures = 0;
+    uint64_t outboundDrops = 0;
+    // Kernel receive to user space, per datagram; fixed buckets, so the stats line never sorts
+    LatencyHistogram kernelQueueing({ std::chrono::microseconds(5), std::chrono::microseconds(10), std::chrono::microseconds(20),
+        std::chrono::microseconds(50), std::chrono::microseconds(100), std::chrono::microseconds(200), std::chrono::microseconds(500),
+        std::chrono::milliseconds(1), std::chrono::milliseconds(2), std::chrono::milliseconds(5), std::chrono::milliseconds(10) });
+    // A peer can trigger these once per datagram: a few lines per second each, the rest counted
+    LogRateLimit badSizeLog, badChecksumLog, badSeqLog, roomsFullLog;
+    auto suppressedSnapshots = [&router]() {
+        uint64_t total = 0;
+        for (const auto& room : router.rooms()) total += room->suppressedSnapshots();
+        return total;
+    };
+    auto deadReckonedSnapshots = [&router]() {
+        uint64_t total = 0;
+        for (const auto& room : router.rooms()) total += room->deadReckonedSnapshots();
+        return total;
+    };
+    auto coalescedInputs = [&router]() {
+        uint64_t total = 0;
+        for (const auto& room : router.rooms()) total += room->coalescedInputs();
+        return total;
+    };
+    auto heldInputs = [&router]() {
+        uint64_t total = 0;
+        for (const auto& room : router.rooms()) total += room->heldInputs();
+        return total;
+    };
+
+    // Validates one received datagram and queues its input in the client's room. Returns the time
+    // spent decoding and applying it, which is what the load governor budgets; the clock is read
+    // before any log line or statistics, so those never count as load
+    auto processPacket = [&](const PacketBuffer& datagram) -> std::chrono::nanoseconds {
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = [start]() { return std::chrono::steady_clock::now() - start; };
+        totalPacketsReceived++;
+        const sockaddr_in& clientAddr = datagram.addr;
+        if (datagram.kernelQueueNs >= 0) {
+            kernelQueueing.record(std::chrono::nanoseconds(datagram.kernelQueueNs));
+        }
 
-    // Client state management
-    std::unordered_map<uint32_t, ClientState> clients; 
-
-    // Server constants
-    const float MOVE_SPEED = 120.0f;        
-    const float BOUNDS_MIN = 30.0f;         
-    const float BOUNDS_MAX = 310.0f;        
+        if (datagram.truncated || datagram.size != Packet::wireSize()) {
+            invalidPacketsDropped++;
+            const auto took = elapsed();
+            if (badSizeLog.allow(datagram.arrival)) {
+                log.warn() << "WARNING: Received packet with invalid size: " << (datagram.truncated ? "over " : "")
+                    << datagram.size << " bytes (expected " << Packet::wireSize() << " bytes). Packet dropped." << Suppressed{ badSizeLog.takeSuppressed() };
+            }
+            return took;
+        }
 
-    // (5) Main server loop: receive, process input, simulate, and send authoritative state
-    while (true) {
-        clientAddrSize = sizeof(clientAddr);
+        // Reject corrupted or foreign datagrams before any field is decoded
+        if (!Packet::hasValidChecksum(datagram.data, datagram.size)) {
+            checksumFailures++;
+            invalidPacketsDropped++;
+            const auto took = elapsed();
+            if (badChecksumLog.allow(datagram.arrival)) {
+                char clientIP[INET_ADDRSTRLEN];
+                inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
+                log.warn() << "WARNING: Checksum mismatch from " << clientIP << ":" << ntohs(clientAddr.sin_port)
+                    << ". Packet dropped." << Suppressed{ badChecksumLog.takeSuppressed() };
+            }
+            return took;
+        }
 
-        int bytes = recvfrom(sock, buf, static_cast<int>(Packet::size()), 0,
-            (sockaddr*)&clientAddr, &clientAddrSize);
+        // Read fields in place from the pooled buffer (no intermediate Packet copy)
+        PacketView inputPacket(datagram.data, Packet::size());
+        const uint32_t inputSeq = inputPacket.seq();
 
-        if (bytes < 0) {
-#ifdef _WIN32
-            int error = WSAGetLastError();
-            if (error != WSAEWOULDBLOCK) {  
-                printSocketError("recvfrom");
-            }
-#else
-            if (errno != EWOULDBLOCK && errno != EAGAIN) {
-                printSocketError("recvfrom");
+        // Basic packet validation
+        if (inputSeq == 0) {
+            invalidPacketsDropped++;
+            const auto took = elapsed();
+            if (badSeqLog.allow(datagram.arrival)) {
+                char clientIP[INET_ADDRSTRLEN];
+                inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
+                log.warn() << "WARNING: Invalid packet received from " << clientIP << ":" << ntohs(clientAddr.sin_port)
+                    << " (seq=0). Packet dropped." << Suppressed{ badSeqLog.takeSuppressed() };
             }
-#endif
-            continue;
+            return took;
         }
 
-        totalPacketsReceived++;
-
-        if (bytes != static_cast<int>(Packet::size())) {
-            std::cerr << "[" << getCurrentTimestamp() << "] WARNING: Received packet with invalid size: "
-                << bytes << " bytes (expected " << Packet::size() << " bytes). Packet dropped." << std::endl;
+        // Route to the client's room; the first valid packet is the handshake that assigns one
+        const ClientId clientId = makeClientId(clientAddr);
+        const bool isNewClient = router.find(clientId) == nullptr;
+        Room* room = router.route(clientId, clientAddr, datagram.arrival);
+        if (!room && !router.shedding().admitNewClients) {
+            return elapsed();  // Shedding new clients: counted by the router, not logged per datagram
+        }
+        if (!room) {
             invalidPacketsDropped++;
-            continue;
+            const auto took = elapsed();
+            if (roomsFullLog.allow(datagram.arrival)) {
+                char clientIP[INET_ADDRSTRLEN];
+                inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
+                log.warn() << "WARNING: All rooms full, rejecting " << clientIP << ":" << ntohs(clientAddr.sin_port) << Suppressed{ roomsFullLog.takeSuppressed() };
+            }
+            return took;
         }
 
-        // Deserialize the packet
-        Packet inputPacket;
-        inputPacket.deserialize(buf);
+        validPacketsProcessed++;
+        room->pushInput(clientId, inputSeq, inputPacket.x(), inputPacket.y(), datagram.arrival);
+        const auto took = elapsed();
 
-        // Basic packet validation
-        if (inputPacket.seq == 0) {
+        if (isNewClient) {
             char clientIP[INET_ADDRSTRLEN];
             inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
-            std::cerr << "[" << getCurrentTimestamp() << "] WARNING: Invalid packet received from "
-                << clientIP << ":" << ntohs(clientAddr.sin_port)
-                << " (seq=0). Packet dropped." << std::endl;
-            invalidPacketsDropped++;
-            continue;
+            log.info() << "Client " << clientIP << ":" << ntohs(clientAddr.sin_port)
+                << " joined room " << room->id() << " (" << room->size() << "/" << room->capacity() << ")";
         }
 
-        validPacketsProcessed++;
-
-        uint32_t clientId = clientAddr.sin_addr.s_addr;
+        if (totalPacketsReceived % 100 == 0) {
+            const IoCounters& counters = io.counters();
+            double validRate = (double)validPacketsProcessed / totalPacketsReceived * 100.0;
+            log.info() << "Statistics: "
+                << totalPacketsReceived << " total, "
+                << validPacketsProcessed << " valid (" << std::fixed << std::setprecision(1) << validRate << "%), "
+                << invalidPacketsDropped << " dropped (" << checksumFailures << " bad checksum), "
+                << router.clientCount() << " active clients in "
+                << router.rooms().size() << " rooms, " << scheduler.steals() << " steals, "
+                << counters.sendErrors.load() << " send errors, kernel queueing p50 <= "
+                << kernelQueueing.percentile(0.5).count() / 1000.0 << " us / p99 <= "
+                << kernelQueueing.percentile(0.99).count() / 1000.0 << " us, "
+                << counters.kernelDrops.load() << " kernel drops, "
+                << counters.inboundDrops.load() << " inbound / " << outboundDrops << " outbound pipeline drops, "
+                << heldInputs() << " inputs held, " << deadReckonedSnapshots() << " snapshots left to dead reckoning, load "
+                << governor.load() << " (" << loadLevelName(governor.level()) << "), " << suppressedSnapshots()
+                << " idle snapshots skipped, " << coalescedInputs() << " inputs coalesced, "
+                << router.refusedClients() << " new client datagrams refused, " << log.dropped() << " log lines dropped";
+            kernelQueueing.reset();
+        }
+        return took;
+    };
 
-        auto& client = clients[clientId];
+    // (5) Simulation loop: take input from the receive thread, and simulate all rooms once per tick
+    while (true) {
         auto now = std::chrono::steady_clock::now();
 
-        if (inputPacket.seq > client.lastSeq) {
-            float dt = std::chrono::duration<float>(now - client.lastUpdate).count();
-            dt = std::clamp(dt, 0.0f, 0.1f); // Sanity check: max 100ms per frame
-
-            float inputX = std::clamp(inputPacket.x, -1.0f, 1.0f);
-            float inputY = std::clamp(inputPacket.y, -1.0f, 1.0f);
-
-            client.vx = inputX * MOVE_SPEED;
-            client.vy = inputY * MOVE_SPEED;
+        if (tickClock.due(now)) {
+            tickClock.beginTick(now);
+            std::vector<Room*> active;
+            for (const auto& room : router.rooms()) {
+                if (!room->empty()) {
+                    active.push_back(room.get());
+                }
+            }
 
-            client.x += client.vx * dt;
-            client.y += client.vy * dt;
+            // Rooms are independent: each worker simulates its rooms into their outboxes
+            scheduler.run(active, [&](Room& room, size_t) {
+                std::vector<RoomOutput>& out = outboxes[room.id()];
+                out.clear();
+                room.holdInputs(now);
+                room.tick(out, &scheduler.jobs());
+            });
+
+            // Snapshots go to the send thread in pooled buffers; it sends them in one batch
+            PacketPipe& outbound = io.outbound();
+            for (Room* room : active) {
+                for (const auto& output : outboxes[room->id()]) {
+                    PacketBuffer* buffer = outbound.acquire();
+                    if (!buffer) {
+                        outboundDrops++;  // The send thread is behind
+                        continue;
+                    }
+                    output.packet.serializeSnapshot(buffer->data, output.ack);
+                    buffer->addr = output.addr;
+                    buffer->size = Packet::snapshotWireSize();
+                    outbound.publish(buffer);
+                }
+            }
+            outbound.notify();
 
-            client.x = std::clamp(client.x, BOUNDS_MIN, BOUNDS_MAX);
-            client.y = std::clamp(client.y, BOUNDS_MIN, BOUNDS_MAX);
+            if (++ticks % 60 == 0) {
+                size_t evicted = router.evictIdle(now - IDLE_TIMEOUT);
+                if (evicted > 0) {
+                    log.info() << "Removed " << evicted << " idle client(s), " << router.clientCount() << " remaining";
+                }
+            }
 
-            client.lastSeq = inputPacket.seq;
-            client.lastUpdate = now;
+            // Copy the world on this thread (cheap); the writer thread does the file I/O
+            if (ticks % CHECKPOINT_INTERVAL_TICKS == 0) {
+                checkpointState.clear();
+                router.save(checkpointState);
+                checkpoints.submit(checkpointState, ticks);
+            }
 
-            char clientIP[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
+            // The report below is not part of the tick's load
+            const auto worked = std::chrono::steady_clock::now();
+            if (ticks % JITTER_REPORT_TICKS == 0) {
+                log.info() << "Tick timing (" << (lowLatency ? "low-latency profile" : "default")
+                    << "): " << tickClock.report() << "\n" << governor.report();
+                tickClock.resetStats();
+            }
 
-            std::cout << "[" << getCurrentTimestamp() << "] Processed input from " << clientIP << ":" << ntohs(clientAddr.sin_port)
-                << " seq=" << inputPacket.seq << " input=(" << std::fixed << std::setprecision(2)
-                << inputX << "," << inputY << ") -> pos=(" << client.x << "," << client.y << ")" << std::endl;
+            // Schedules the next tick on the grid; an overrun is handled by the catch-up policy.
+            // The tick's time also closes the load window, which may change shedding for the next tick
+            const auto tickEnd = std::chrono::steady_clock::now();
+            governor.endWindow(worked - now);
+            tickClock.endTick(tickEnd);
+
+#ifndef _WIN32
+            // Hot restart: hand everything over between ticks, so the new process owns the next one.
+            // The watcher thread accepted the request; taking it is an atomic exchange
+            const int peer = takeovers.poll();
+            if (peer >= 0) {
+                const auto start = std::chrono::steady_clock::now();
+                checkpoints.flush();  // The new server writes the checkpoint file from now on
+
+                // Stop the I/O threads first (this tick's snapshots go out, an armed io_uring receive
+                // is cancelled), then apply the input they already received
+                io.stop();
+                while (PacketBuffer* buffer = io.inbound().poll()) {
+                    processPacket(*buffer);
+                    io.inbound().release(buffer);
+                }
+
+                std::vector<char> state;
+                router.save(state);
+                HandoffHeader header;
+                header.ticks = ticks;
+                header.nextTick = static_cast<int64_t>(tickClock.nextTick().time_since_epoch().count());
+
+                const bool sent = handOff(peer, { sock }, state, header);
+                const auto handedOff = std::chrono::steady_clock::now();
+                if (sent && awaitAck(peer, HANDOFF_ACK_TIMEOUT)) {
+                    log.info() << "Handed " << router.clientCount() << " client(s) ("
+                        << state.size() << " bytes) to the new server in " << std::fixed << std::setprecision(2)
+                        << std::chrono::duration<double, std::milli>(handedOff - start).count() << " ms, exiting";
+                    close(peer);
+                    takeovers.stop();
+                    close(control);  // The new server owns the control path now
+                    break;
+                }
+                log.warn() << "WARNING: Takeover failed, continuing to serve";
+                close(peer);
+                io.start();
+            }
+#endif
+            continue;
         }
 
-        Packet responsePacket;
-        responsePacket.seq = inputPacket.seq;  // Echo back the sequence number for reconciliation
-        responsePacket.x = client.x;           // Server's authoritative position
-        responsePacket.y = client.y;
-        responsePacket.vx = client.vx;         // Server's computed velocity
-        responsePacket.vy = client.vy;
-
-        responsePacket.serialize(buf);
-        int sentBytes = sendto(sock, buf, static_cast<int>(Packet::size()), 0,
-            (sockaddr*)&clientAddr, clientAddrSize);
-
-        if (sentBytes < 0) {
-            printSocketError("sendto");
+        // Apply every input that is ready, then sleep until more arrives or the spin window before
+        // the next tick begins; inside the window, keep polling so the tick starts on time
+        PacketPipe& inbound = io.inbound();
+        if (PacketBuffer* buffer = inbound.poll()) {
+            governor.recordPacket(processPacket(*buffer));
+            inbound.release(buffer);
+            continue;
         }
-        else if (sentBytes != static_cast<int>(Packet::size())) {
-            char clientIP[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &clientAddr.sin_addr, clientIP, INET_ADDRSTRLEN);
-            std::cerr << "[" << getCurrentTimestamp() << "] WARNING: Partial send to " << clientIP
-                << " (" << sentBytes << "/" << Packet::size() << " bytes)" << std::endl;
+        if (now < tickClock.spinStart()) {
+            inbound.wait(std::chrono::duration_cast<std::chrono::microseconds>(tickClock.spinStart() - now));
         }
-
-        if (totalPacketsReceived % 100 == 0) {
-            double validRate = (double)validPacketsProcessed / totalPacketsReceived * 100.0;
-            std::cout << "[" << getCurrentTimestamp() << "] Statistics: "
-                << totalPacketsReceived << " total, "
-                << validPacketsProcessed << " valid (" << std::setprecision(1) << validRate << "%), "
-                << invalidPacketsDropped << " dropped, "
-                << clients.size() << " active clients" << std::endl;
+        else {
+            std::this_thread::yield();
         }
     }
 
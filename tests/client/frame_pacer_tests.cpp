@@ -0,0 +1,215 @@
+/**
+ * @file frame_pacer_tests.cpp
+ * @brief Unit tests and benchmark for the late-latching frame pacer.
+ *
+ * Coverage:
+ * - Deadlines follow the absolute grid; the latch is deadline - predicted cost - margin
+ * - The cost prediction is a quantile of the recent costs, follows changes and never exceeds period - margin
+ * - A frame past its deadline is a miss, and passed deadlines are skipped keeping the grid's phase
+ * - waitForLatch() never returns early
+ * - Frame cost and latch lateness statistics keep only the last statsWindow frames
+ * - Benchmark: input-to-photon latency of a framerate-limited loop vs the paced loop (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/frame_pacer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = FramePacer::Clock;
+    const Clock::time_point T0 = Clock::time_point(std::chrono::hours(1));
+
+    /** @brief Runs one frame that latches at latchTime() plus lateness and costs cost. */
+    void runFrame(FramePacer& pacer, Clock::duration cost, Clock::duration lateness = 0ns) {
+        const Clock::time_point latch = pacer.latchTime() + lateness;
+        pacer.beginFrame(latch);
+        pacer.endFrame(latch + cost);
+    }
+
+    /** @brief Busy-waits for duration, standing in for simulation and rendering. */
+    void work(Clock::duration duration) {
+        const Clock::time_point until = Clock::now() + duration;
+        while (Clock::now() < until) {}
+    }
+}
+
+TEST_CASE("FramePacer: deadlines and latch time", "[FramePacer]") {
+    FramePacer pacer({ 16ms, 1ms }, T0);
+    CHECK(pacer.deadline() == T0);
+    CHECK(pacer.predictedCost() == 8ms);    // Half a period before any measurement
+    CHECK(pacer.latchTime() == T0 - 9ms);
+
+    for (int i = 0; i < 10; ++i) {
+        runFrame(pacer, 3ms, 20us);
+    }
+    CHECK(pacer.deadline() == T0 + 10 * 16ms);
+    CHECK(pacer.predictedCost() == 3ms);
+    CHECK(pacer.latchTime() == pacer.deadline() - 4ms);
+    CHECK(pacer.frames() == 10);
+    CHECK(pacer.missedDeadlines() == 0);
+    CHECK(pacer.skippedDeadlines() == 0);
+    CHECK(pacer.latchLateness().max() == 20us);
+    CHECK(pacer.frameCost().percentile(0.5) == 3ms);
+}
+
+TEST_CASE("FramePacer: cost prediction", "[FramePacer]") {
+    FramePacerConfig config;
+    config.period = 16ms;
+    config.margin = 1ms;
+    config.costWindow = 10;
+    config.costQuantile = 0.9;
+    FramePacer pacer(config, T0);
+
+    SECTION("Quantile of the recent costs") {
+        for (int ms = 1; ms <= 10; ++ms) {
+            runFrame(pacer, std::chrono::milliseconds(ms));
+        }
+        CHECK(pacer.predictedCost() == 9ms);   // One slow frame in ten does not move the latch
+    }
+
+    SECTION("Only the last costWindow frames count") {
+        for (int i = 0; i < 10; ++i) {
+            runFrame(pacer, 6ms);
+        }
+        CHECK(pacer.predictedCost() == 6ms);
+        for (int i = 0; i < 10; ++i) {
+            runFrame(pacer, 2ms);
+        }
+        CHECK(pacer.predictedCost() == 2ms);
+    }
+
+    SECTION("Never more than period - margin") {
+        for (int i = 0; i < 10; ++i) {
+            runFrame(pacer, 30ms);
+        }
+        CHECK(pacer.predictedCost() == 15ms);
+        CHECK(pacer.latchTime() == pacer.deadline() - 16ms);
+    }
+}
+
+TEST_CASE("FramePacer: misses skip passed deadlines", "[FramePacer]") {
+    FramePacer pacer({ 10ms, 1ms }, T0);
+    pacer.beginFrame(T0 - 2ms);
+    pacer.endFrame(T0 + 35ms);          // Misses T0; 10, 20 and 30 pass during the frame
+    CHECK(pacer.missedDeadlines() == 1);
+    CHECK(pacer.skippedDeadlines() == 3);
+    CHECK(pacer.deadline() == T0 + 40ms);
+
+    runFrame(pacer, 2ms);               // Back on the grid
+    CHECK(pacer.missedDeadlines() == 1);
+    CHECK(pacer.deadline() == T0 + 50ms);
+}
+
+TEST_CASE("FramePacer: statistics stay bounded", "[FramePacer]") {
+    FramePacerConfig config;
+    config.period = 16ms;
+    config.margin = 1ms;
+    config.statsWindow = 100;
+    FramePacer pacer(config, T0);
+
+    runFrame(pacer, 12ms, 2ms);
+    for (int i = 0; i < 1000; ++i) {
+        runFrame(pacer, 3ms);
+    }
+    CHECK(pacer.frames() == 1001);
+    CHECK(pacer.frameCost().count() == 100);
+    CHECK(pacer.latchLateness().count() == 100);
+    CHECK(pacer.frameCost().percentile(0.99) == 3ms);  // The slow first frame has left the window
+    CHECK(pacer.frameCost().max() == 12ms);            // max() still covers it
+    CHECK(pacer.latchLateness().max() == 2ms);
+}
+
+TEST_CASE("FramePacer: waitForLatch is never early", "[FramePacer]") {
+    FramePacer pacer({ 10ms, 1ms, 200us });
+    for (int i = 0; i < 5; ++i) {
+        const Clock::time_point latch = pacer.latchTime();
+        pacer.waitForLatch();
+        const Clock::time_point now = Clock::now();
+        CHECK(now >= latch);
+        pacer.beginFrame(now);
+        pacer.endFrame(Clock::now());
+    }
+}
+
+/*
+ * Frames are shown at the first display refresh (a 60 Hz grid starting at the
+ * loop's start) at or after they are presented, as with vsync or a compositor.
+ * Render cost: 3 ms +- 1 ms, with a 7 ms frame every 50th.
+ *
+ * The framerate-limited loop is the client as it was: sample at the top,
+ * render, present, then sleep for what is left of 1/60 s since the previous
+ * frame, timed from when the sleep returned (sf::Window::display()).
+ */
+TEST_CASE("FramePacer: input-to-photon latency, framerate limit vs late latch", "[.][Benchmark][FramePacer]") {
+    constexpr int FRAMES = 600;
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000 / 60));
+
+    auto photon = [&](Clock::time_point start, Clock::time_point presented) {
+        const auto refreshes = (presented - start + period - 1ns) / period;
+        return start + refreshes * period;
+    };
+    auto renderCost = [](std::mt19937& rng, int frame) {
+        std::uniform_int_distribution<int> jitter(-1000, 1000);
+        return frame % 50 == 49 ? Clock::duration(7ms) : Clock::duration(3ms + std::chrono::microseconds(jitter(rng)));
+    };
+    auto print = [](const char* name, const JitterStats& toPresent, const JitterStats& toPhoton, uint64_t late) {
+        auto ms = [](std::chrono::nanoseconds value) { return std::chrono::duration<double, std::milli>(value).count(); };
+        std::printf("%-24s sample->present p50 %5.2f ms | sample->photon p50 %5.2f / p99 %5.2f / max %5.2f ms | %llu frames late\n",
+            name, ms(toPresent.percentile(0.5)), ms(toPhoton.percentile(0.5)), ms(toPhoton.percentile(0.99)),
+            ms(toPhoton.max()), static_cast<unsigned long long>(late));
+    };
+
+    {
+        std::mt19937 rng(7);
+        JitterStats toPresent, toPhoton;
+        uint64_t late = 0;
+        const Clock::time_point start = Clock::now();
+        Clock::time_point limiterStart = start;
+        Clock::time_point lastPhoton = start;
+        for (int i = 0; i < FRAMES; ++i) {
+            const Clock::time_point sampled = Clock::now();
+            work(renderCost(rng, i));
+            const Clock::time_point presented = Clock::now();
+            const Clock::time_point shown = photon(start, presented);
+            late += shown > lastPhoton + period ? 1 : 0;
+            lastPhoton = shown;
+            toPresent.record(presented - sampled);
+            toPhoton.record(shown - sampled);
+            std::this_thread::sleep_for(period - (Clock::now() - limiterStart));
+            limiterStart = Clock::now();
+        }
+        print("framerate limit", toPresent, toPhoton, late);
+    }
+
+    {
+        std::mt19937 rng(7);
+        JitterStats toPresent, toPhoton;
+        uint64_t late = 0;
+        const Clock::time_point start = Clock::now();
+        FramePacer pacer(FramePacerConfig(), start + period);
+        Clock::time_point lastPhoton = start;
+        for (int i = 0; i < FRAMES; ++i) {
+            pacer.waitForLatch();
+            const Clock::time_point sampled = Clock::now();
+            pacer.beginFrame(sampled);
+            work(renderCost(rng, i));
+            const Clock::time_point presented = Clock::now();
+            pacer.endFrame(presented);
+            const Clock::time_point shown = photon(start, presented);
+            late += shown > lastPhoton + period ? 1 : 0;
+            lastPhoton = shown;
+            toPresent.record(presented - sampled);
+            toPhoton.record(shown - sampled);
+        }
+        print("late latch (FramePacer)", toPresent, toPhoton, late);
+        std::printf("  %s\n", pacer.report().c_str());
+    }
+}
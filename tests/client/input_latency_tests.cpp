@@ -0,0 +1,158 @@
+/**
+ * @file input_latency_tests.cpp
+ * @brief Unit tests for input-to-photon latency tracking.
+ *
+ * Coverage:
+ * - Each stage of a sent input is timed from its own timestamps, and the confirmed latency
+ *   runs from key sampling to the first frame shown after reconciliation
+ * - Local-to-display is measured once per frame
+ * - A later acknowledgement confirms inputs whose packets were lost; repeated
+ *   acknowledgements (held input) are not counted twice
+ * - Histograms and the CSV export reflect the records
+ * - Memory stays bounded: percentiles cover the recent window, histograms every sample,
+ *   and records stop at maxRecords (the rest are counted)
+ * - Stage times written by a second thread arrive intact
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/input_latency.hpp"
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::milliseconds;
+}
+
+TEST_CASE("InputLatency: stages of a sent input", "[InputLatency][client]") {
+    InputLatencyTracker tracker;
+    const auto t0 = Clock::now();
+
+    tracker.sampled(t0);
+    tracker.queued(1, t0);
+    tracker.displayed(t0 + milliseconds(4));      // The local prediction is on screen
+    tracker.sent(1, t0 + milliseconds(10));
+    tracker.acked(1, t0 + milliseconds(70));
+    tracker.acked(1, t0 + milliseconds(86));      // Held input: same sequence again
+    tracker.reconciled(1, t0 + milliseconds(75));
+    tracker.reconciled(1, t0 + milliseconds(91));
+    CHECK(tracker.records().empty());             // Not on screen yet
+    tracker.displayed(t0 + milliseconds(80));
+
+    REQUIRE(tracker.records().size() == 1);
+    const auto& record = tracker.records()[0];
+    CHECK(record.seq == 1);
+    CHECK(record.acked == t0 + milliseconds(70));
+    CHECK(tracker.localToDisplay().total.count() == 1);
+    CHECK(tracker.localToDisplay().total.max() == milliseconds(4));
+    CHECK(tracker.sampleToSend().total.max() == milliseconds(10));
+    CHECK(tracker.sendToAck().total.max() == milliseconds(60));
+    CHECK(tracker.ackToReconcile().total.max() == milliseconds(5));
+    CHECK(tracker.reconcileToDisplay().total.max() == milliseconds(5));
+    CHECK(tracker.serverConfirmed().total.max() == milliseconds(80));
+
+    // A frame without new samples adds nothing
+    tracker.displayed(t0 + milliseconds(96));
+    CHECK(tracker.localToDisplay().total.count() == 1);
+    CHECK(tracker.records().size() == 1);
+}
+
+TEST_CASE("InputLatency: a later acknowledgement confirms lost inputs", "[InputLatency][client]") {
+    InputLatencyConfig config;
+    config.buckets = { milliseconds(85), milliseconds(95) };
+    InputLatencyTracker tracker(config);
+    const auto t0 = Clock::now();
+    for (uint32_t seq = 1; seq <= 3; ++seq) {
+        tracker.queued(seq, t0 + milliseconds(10 * seq));
+    }
+    tracker.sent(1, t0 + milliseconds(11));
+    tracker.sent(3, t0 + milliseconds(31));       // Packet 2 was dropped before the socket
+    tracker.acked(3, t0 + milliseconds(100));
+    tracker.reconciled(3, t0 + milliseconds(105));
+    tracker.displayed(t0 + milliseconds(110));
+
+    REQUIRE(tracker.records().size() == 3);
+    CHECK(tracker.records()[1].seq == 2);
+    CHECK(tracker.records()[1].sent == Clock::time_point());
+    CHECK(tracker.serverConfirmed().total.count() == 3);
+    CHECK(tracker.serverConfirmed().total.max() == milliseconds(100));
+    CHECK(tracker.sendToAck().total.count() == 2);      // Only where both ends are known
+    CHECK(tracker.sampleToSend().total.count() == 2);
+
+    CHECK(InputLatencyTracker::histogramText(tracker.serverConfirmed().total) == "<85: 1  <95: 1  >=95: 1");
+
+    std::ostringstream csv;
+    tracker.exportCsv(csv);
+    CHECK(csv.str() ==
+        "seq,sample_to_send_us,send_to_ack_us,ack_to_reconcile_us,reconcile_to_display_us,confirmed_us\n"
+        "1,1000,89000,5000,5000,100000\n"
+        "2,-1,-1,5000,5000,90000\n"
+        "3,1000,69000,5000,5000,80000\n");
+
+    std::ostringstream histograms;
+    tracker.exportHistograms(histograms);
+    const std::string text = histograms.str();
+    CHECK(text.rfind("distribution,upper_ms,count\n", 0) == 0);
+    CHECK(text.find("server_confirmed,85,1\nserver_confirmed,95,1\nserver_confirmed,inf,1\n") != std::string::npos);
+    CHECK(text.find("send_to_ack,85,1\nsend_to_ack,95,1\nsend_to_ack,inf,0\n") != std::string::npos);
+}
+
+TEST_CASE("InputLatency: network thread stage times arrive intact", "[InputLatency][client]") {
+    constexpr uint32_t INPUTS = 2000;
+    InputLatencyConfig config;
+    config.capacity = 4096;
+    InputLatencyTracker tracker(config);
+    const auto t0 = Clock::now();
+    for (uint32_t seq = 1; seq <= INPUTS; ++seq) {
+        tracker.queued(seq, t0 + milliseconds(seq));
+    }
+    std::thread network([&] {
+        for (uint32_t seq = 1; seq <= INPUTS; ++seq) {
+            tracker.sent(seq, t0 + milliseconds(seq + 2));
+            tracker.acked(seq, t0 + milliseconds(seq + 50));
+        }
+    });
+    network.join();
+    tracker.reconciled(INPUTS, t0 + milliseconds(INPUTS + 60));
+    tracker.displayed(t0 + milliseconds(INPUTS + 70));
+
+    REQUIRE(tracker.records().size() == INPUTS);
+    CHECK(tracker.sampleToSend().total.max() == milliseconds(2));
+    CHECK(tracker.sendToAck().recent.percentile(0.0) == milliseconds(48));
+    CHECK(tracker.sendToAck().total.max() == milliseconds(48));
+}
+
+TEST_CASE("InputLatency: memory stays bounded over a long run", "[InputLatency][client]") {
+    InputLatencyConfig config;
+    config.window = 100;
+    config.maxRecords = 50;
+    InputLatencyTracker tracker(config);
+    const auto t0 = Clock::now();
+
+    // 1000 frames, each sending an input confirmed 40 ms later, then 100 frames at 60 ms
+    for (uint32_t seq = 1; seq <= 1100; ++seq) {
+        const auto sampled = t0 + milliseconds(seq);
+        const auto latency = milliseconds(seq <= 1000 ? 40 : 60);
+        tracker.sampled(sampled);
+        tracker.queued(seq, sampled);
+        tracker.displayed(sampled + milliseconds(5));
+        tracker.sent(seq, sampled);
+        tracker.acked(seq, sampled + latency);
+        tracker.reconciled(seq, sampled + latency);
+        tracker.displayed(sampled + latency);
+    }
+
+    CHECK(tracker.serverConfirmed().recent.count() == 100);
+    CHECK(tracker.serverConfirmed().recent.percentile(0.0) == milliseconds(60));   // Only the last 100
+    CHECK(tracker.serverConfirmed().total.count() == 1100);
+    CHECK(tracker.serverConfirmed().total.counts()[3] == 1000);                    // <50 ms
+    CHECK(tracker.serverConfirmed().total.counts()[4] == 100);                     // <100 ms
+    CHECK(tracker.localToDisplay().recent.count() == 100);
+    CHECK(tracker.records().size() == 50);
+    CHECK(tracker.records().back().seq == 50);
+    CHECK(tracker.recordsDropped() == 1050);
+}
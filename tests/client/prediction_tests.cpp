@@ -8,6 +8,9 @@
  *
  * Extended with edge cases, error conditions, and boundary testing.
  *
+ * Also runs the demo client's loop against a real Room: input sent only on change, held by
+ * the server in between, and reconciled against the held time each snapshot echoes.
+ *
  * @author Aryan Malekian & Jonathan Skomsy Hbertz,  w/ use of A.I. Models 
  * @date 22.05.2025
  */
@@ -15,7 +18,15 @@
 #include <catch2/catch_all.hpp>
 #include "netcode/common/prediction.hpp"
 #include "netcode/common/packet.hpp"
+#include "netcode/common/input_encoder.hpp"
+#include "netcode/common/room.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
 #include <limits>
+#include <vector>
 
 TEST_CASE("predictPosition: Zero delta time returns same position", "[Prediction]") {
     Packet pkt{ 12, 100.0f, 50.0f, 4.0f, -3.0f };
@@ -364,4 +375,89 @@ TEST_CASE("Legacy prediction function edge cases", "[Prediction][Legacy]") {
         REQUIRE(result.first == Catch::Approx(1000.001f));
         REQUIRE(result.second == Catch::Approx(999.999f));
     }
-}
\ No newline at end of file
+}
+/*
+ * The client predicts every frame (60 Hz) but sends input only when it changes, plus the
+ * encoder's repeats and heartbeats; the server holds it in between, so most snapshots echo
+ * an input packet many frames old. 50 ms each way, server ticks at 60 Hz out of phase with
+ * the client's frames. The client stands still, then holds Left for a second and lets go.
+ */
+TEST_CASE("PredictionSystem: held input against a Room does not snap back", "[PredictionSystem][Room]") {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration step = std::chrono::microseconds(16667);
+    const Clock::duration oneWay = std::chrono::milliseconds(50);
+    const Clock::time_point t0 = Clock::now();
+    const float frameDt = std::chrono::duration<float>(step).count();
+
+    struct InFlightInput { Clock::time_point arrival; uint32_t seq; float x, y; };
+    struct InFlightSnapshot { Clock::time_point arrival; Packet packet; SnapshotAck ack; };
+    std::deque<InFlightInput> toServer;
+    std::deque<InFlightSnapshot> toClient;
+
+    Room room(0, 1);
+    const sockaddr_in addr = makeAddr(0x7F000001, 4000);
+    const ClientId id = makeClientId(addr);
+    Clock::time_point nextTick = t0;
+
+    InputEncoder encoder;
+    PredictionSystem prediction(Room::SPAWN_X, Room::SPAWN_Y);
+    uint32_t seq = 1;
+    uint32_t frameId = 1;
+    float localX = Room::SPAWN_X;
+    float worstJump = 0.0f;       // Largest move of the prediction made by one reconciliation
+    float worstOffset = 0.0f;     // Largest distance from the locally integrated position after one
+    size_t reconciled = 0;
+    size_t heldSnapshots = 0;
+
+    for (int frame = 0; frame < 120; ++frame) {
+        const Clock::time_point now = t0 + std::chrono::milliseconds(5) + frame * step;
+
+        // Server: everything that arrived by each tick, then hold and tick
+        for (; nextTick <= now; nextTick += step) {
+            while (!toServer.empty() && toServer.front().arrival <= nextTick) {
+                const InFlightInput& in = toServer.front();
+                if (room.slotOf(id) == EntityStore::NPOS) {
+                    room.join(id, addr, in.arrival);
+                }
+                room.pushInput(id, in.seq, in.x, in.y, in.arrival);
+                toServer.pop_front();
+            }
+            std::vector<RoomOutput> out;
+            room.holdInputs(nextTick);
+            room.tick(out);
+            for (const RoomOutput& output : out) {
+                toClient.push_back({ nextTick + oneWay, output.packet, output.ack });
+            }
+        }
+
+        // Client: stand for 10 frames, hold Left for 60, then stand again
+        const float inputX = frame >= 10 && frame < 70 ? -1.0f : 0.0f;
+        if (encoder.sample(inputX, 0.0f, now) != InputSend::None) {
+            toServer.push_back({ now + oneWay, seq++, inputX, 0.0f });
+        }
+        localX += inputX * Room::MOVE_SPEED * frameDt;
+
+        InputCommand input(frameId++, inputX, 0.0f, frameDt);
+        input.packetSeq = seq - 1;
+        prediction.applyInput(input);
+
+        while (!toClient.empty() && toClient.front().arrival <= now) {
+            const InFlightSnapshot& snapshot = toClient.front();
+            const float before = prediction.getPredictedPosition().first;
+            prediction.reconcileWithServer(snapshot.packet, std::chrono::microseconds(snapshot.ack.heldMicros));
+            const float after = prediction.getPredictedPosition().first;
+            worstJump = std::max(worstJump, std::abs(after - before));
+            worstOffset = std::max(worstOffset, std::abs(after - localX));
+            heldSnapshots += snapshot.ack.heldMicros > 0 ? 1 : 0;
+            ++reconciled;
+            toClient.pop_front();
+        }
+    }
+
+    INFO(reconciled << " snapshots, " << heldSnapshots << " of held input, worst jump " << worstJump
+        << ", worst offset " << worstOffset);
+    REQUIRE(heldSnapshots > 30);
+    CHECK(worstJump < 3.0f);       // Reconciling against the packet alone snaps back about one RTT of movement (15 units here)
+    CHECK(worstOffset < 3.0f);
+    CHECK(prediction.getPredictedPosition().first == Catch::Approx(localX).margin(3.0f));
+}
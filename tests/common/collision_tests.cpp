@@ -0,0 +1,214 @@
+/**
+ * @file collision_tests.cpp
+ * @brief Unit tests and benchmark for the collision grid.
+ *
+ * Coverage:
+ * - An overlapping pair is separated to exactly one diameter along its centre line;
+ *   circles that only touch or are apart do not move
+ * - Circles on the same point are split along x by slot order; results stay in bounds
+ * - The grid finds exactly the pairs a brute-force scan finds, across cell edges,
+ *   world edges and for positions outside the bounds
+ * - Repeated passes settle a crowd: overlap shrinks every tick
+ * - Benchmark: 10k moving entities per tick, grid vs brute force (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/collision.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    const CollisionParams PARAMS{ 10.0f, 30.0f, 310.0f };
+
+    /** @brief Every overlapping pair (a < b), by testing all of them. */
+    std::vector<std::pair<uint32_t, uint32_t>> bruteForcePairs(const std::vector<float>& x, const std::vector<float>& y,
+        const CollisionParams& params) {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        const float diameterSq = 4.0f * params.radius * params.radius;
+        for (uint32_t a = 0; a < x.size(); ++a) {
+            for (uint32_t b = a + 1; b < x.size(); ++b) {
+                const float dx = x[b] - x[a];
+                const float dy = y[b] - y[a];
+                if (dx * dx + dy * dy < diameterSq) {
+                    pairs.emplace_back(a, b);
+                }
+            }
+        }
+        return pairs;
+    }
+
+    /** @brief Deepest overlap between any two circles. */
+    float maxOverlap(const std::vector<float>& x, const std::vector<float>& y, const CollisionParams& params) {
+        CollisionGrid grid;
+        std::vector<Contact> contacts;
+        grid.findContacts(x.data(), y.data(), x.size(), params, contacts);
+        float deepest = 0.0f;
+        for (const Contact& contact : contacts) {
+            deepest = std::max(deepest, contact.depth);
+        }
+        return deepest;
+    }
+}
+
+TEST_CASE("Collision: overlapping pairs are pushed apart", "[Collision]") {
+    CollisionGrid grid;
+
+    SECTION("Overlap is split evenly along the centre line") {
+        std::vector<float> x{ 100.0f, 112.0f, 250.0f };
+        std::vector<float> y{ 100.0f, 100.0f, 250.0f };
+        REQUIRE(grid.resolve(x.data(), y.data(), 3, PARAMS) == 1);
+        CHECK(x[0] == Catch::Approx(96.0f));
+        CHECK(x[1] == Catch::Approx(116.0f));
+        CHECK(y[0] == 100.0f);
+        CHECK(y[1] == 100.0f);
+        CHECK(x[2] == 250.0f);   // Far away: untouched
+        CHECK(y[2] == 250.0f);
+        CHECK(grid.passes() == 2);   // The second pass found nothing left
+    }
+
+    SECTION("Diagonal overlap") {
+        std::vector<float> x{ 100.0f, 106.0f };
+        std::vector<float> y{ 100.0f, 108.0f };   // 10 apart, 10 deep
+        grid.resolve(x.data(), y.data(), 2, PARAMS);
+        const float distance = std::hypot(x[1] - x[0], y[1] - y[0]);
+        CHECK(distance == Catch::Approx(20.0f));
+        CHECK((x[0] + x[1]) / 2 == Catch::Approx(103.0f));
+        CHECK((y[0] + y[1]) / 2 == Catch::Approx(104.0f));
+    }
+
+    SECTION("Touching circles do not move") {
+        std::vector<float> x{ 100.0f, 120.0f };
+        std::vector<float> y{ 100.0f, 100.0f };
+        CHECK(grid.resolve(x.data(), y.data(), 2, PARAMS) == 0);
+        CHECK(x[0] == 100.0f);
+        CHECK(x[1] == 120.0f);
+        CHECK(grid.passes() == 1);
+    }
+
+    SECTION("Circles on the same point split by slot order and stay in bounds") {
+        std::vector<float> x{ 200.0f, 200.0f, PARAMS.boundsMin, PARAMS.boundsMin };
+        std::vector<float> y{ 300.0f, 300.0f, PARAMS.boundsMin, PARAMS.boundsMin };
+        REQUIRE(grid.resolve(x.data(), y.data(), 4, PARAMS) == 2);
+        CHECK(x[0] == Catch::Approx(190.0f));
+        CHECK(x[1] == Catch::Approx(210.0f));
+        CHECK(x[2] == PARAMS.boundsMin);   // Pushed into the wall, clamped
+        CHECK(x[3] >= PARAMS.boundsMin + 10.0f);
+        for (size_t i = 0; i < x.size(); ++i) {
+            CHECK(x[i] >= PARAMS.boundsMin);
+            CHECK(x[i] <= PARAMS.boundsMax);
+        }
+    }
+}
+
+TEST_CASE("Collision: grid finds the same pairs as brute force", "[Collision]") {
+    std::mt19937 rng(7);
+    for (const CollisionParams& params : { PARAMS, CollisionParams{ 3.0f, -500.0f, 500.0f }, CollisionParams{ 1.0f, 0.0f, 10000.0f } }) {
+        // Positions a little outside the world too: they must land in the edge cells
+        const float margin = 2.0f * params.radius;
+        std::uniform_real_distribution<float> position(params.boundsMin - margin, params.boundsMax + margin);
+        const size_t count = params.boundsMax - params.boundsMin > 5000.0f ? 4000 : 600;
+        std::vector<float> x(count), y(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = position(rng);
+            y[i] = position(rng);
+        }
+        // Some pairs straddling cell borders at exactly one diameter and just inside it
+        x[0] = params.boundsMin + 2.0f * params.radius;
+        y[0] = params.boundsMin;
+        x[1] = x[0] + 1.999f * params.radius;
+        y[1] = y[0];
+
+        CollisionGrid grid;
+        std::vector<Contact> contacts;
+        grid.findContacts(x.data(), y.data(), count, params, contacts);
+        std::vector<std::pair<uint32_t, uint32_t>> found;
+        for (const Contact& contact : contacts) {
+            REQUIRE(contact.a < contact.b);
+            REQUIRE(contact.depth > 0.0f);
+            found.emplace_back(contact.a, contact.b);
+        }
+        std::sort(found.begin(), found.end());
+        const auto expected = bruteForcePairs(x, y, params);
+        INFO("radius " << params.radius << ", " << expected.size() << " overlapping pairs");
+        CHECK(found == expected);
+        CHECK(grid.pairsTested() < count * (count - 1) / 2);
+    }
+}
+
+TEST_CASE("Collision: a crowd settles over repeated passes", "[Collision]") {
+    std::mt19937 rng(11);
+    std::normal_distribution<float> spread(0.0f, 15.0f);
+    std::vector<float> x(40), y(40);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = std::clamp(170.0f + spread(rng), PARAMS.boundsMin, PARAMS.boundsMax);
+        y[i] = std::clamp(170.0f + spread(rng), PARAMS.boundsMin, PARAMS.boundsMax);
+    }
+
+    CollisionGrid grid;
+    float previous = maxOverlap(x, y, PARAMS);
+    REQUIRE(previous > 10.0f);
+    for (int tick = 0; tick < 30; ++tick) {
+        grid.resolve(x.data(), y.data(), x.size(), PARAMS);
+    }
+    const float settled = maxOverlap(x, y, PARAMS);
+    INFO("deepest overlap " << previous << " -> " << settled);
+    CHECK(settled < 1.0f);
+    for (size_t i = 0; i < x.size(); ++i) {
+        REQUIRE(x[i] >= PARAMS.boundsMin);
+        REQUIRE(x[i] <= PARAMS.boundsMax);
+    }
+}
+
+TEST_CASE("Collision: 10k moving entities", "[.][Benchmark][Collision]") {
+    // 10k players in a world with room to move (about 10% of the area covered), and the same
+    // 10k packed into the server's 280 x 280 room (heavily overlapping: worst case)
+    constexpr size_t COUNT = 10000;
+    constexpr int TICKS = 120;
+    using Clock = std::chrono::steady_clock;
+    for (const CollisionParams& params : { CollisionParams{ 10.0f, 0.0f, 5600.0f }, PARAMS }) {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> position(params.boundsMin, params.boundsMax);
+        std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+        std::vector<float> x(COUNT), y(COUNT);
+        for (size_t i = 0; i < COUNT; ++i) {
+            x[i] = position(rng);
+            y[i] = position(rng);
+        }
+
+        CollisionGrid grid;
+        Clock::duration total{ 0 };
+        Clock::duration worst{ 0 };
+        size_t contacts = 0;
+        uint64_t tested = 0;
+        for (int tick = 0; tick < TICKS; ++tick) {
+            for (size_t i = 0; i < COUNT; ++i) {
+                x[i] = std::clamp(x[i] + step(rng), params.boundsMin, params.boundsMax);
+                y[i] = std::clamp(y[i] + step(rng), params.boundsMin, params.boundsMax);
+            }
+            const auto start = Clock::now();
+            contacts += grid.resolve(x.data(), y.data(), COUNT, params);
+            const auto took = Clock::now() - start;
+            total += took;
+            worst = std::max(worst, took);
+            tested += grid.pairsTested();
+        }
+        std::printf("%.0f x %.0f world: grid %.3f ms per tick (worst %.3f ms), %zu contacts and %llu pairs tested per tick\n",
+            params.boundsMax - params.boundsMin, params.boundsMax - params.boundsMin,
+            std::chrono::duration<double, std::milli>(total).count() / TICKS,
+            std::chrono::duration<double, std::milli>(worst).count(), contacts / TICKS,
+            static_cast<unsigned long long>(tested / TICKS));
+
+        const auto start = Clock::now();
+        const size_t pairs = bruteForcePairs(x, y, params).size();
+        std::printf("    brute force: %.3f ms for one detection pass (%zu overlapping pairs)\n",
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count(), pairs);
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file crc32c_tests.cpp
+ * @brief Unit tests and benchmarks for CRC32C and the packet checksum trailer.
+ *
+ * Coverage:
+ * - Known CRC-32C check values
+ * - Hardware and table-driven paths agree for all lengths and alignments
+ * - Extending a checksum across split buffers
+ * - Packet trailer roundtrip, corruption, wrong size and foreign protocol id
+ * - Snapshot trailer covers the SnapshotAck too; an input-sized datagram is not a snapshot
+ * - Benchmark: per-packet checksum cost (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/crc32c.hpp"
+#include "netcode/common/cpu_features.hpp"
+#include "netcode/common/packet.hpp"
+#include <random>
+#include <vector>
+
+TEST_CASE("CRC32C: known check values", "[CRC32C]") {
+    const char digits[] = "123456789";
+    REQUIRE(crc32cSoftware(digits, 9) == 0xE3069283u);
+    REQUIRE(crc32c(digits, 9) == 0xE3069283u);
+
+    std::vector<unsigned char> zeros(32, 0x00), ones(32, 0xFF);
+    REQUIRE(crc32c(zeros.data(), zeros.size()) == 0x8A9136AAu);
+    REQUIRE(crc32c(ones.data(), ones.size()) == 0x62A8AB43u);
+
+    REQUIRE(crc32c(digits, 0) == 0u);
+}
+
+TEST_CASE("CRC32C: hardware and software paths agree", "[CRC32C]") {
+    if (!cpuHasSse42()) {
+        WARN("SSE4.2 not available; hardware path not exercised");
+        return;
+    }
+
+    std::mt19937 rng(54);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<unsigned char> data(256 + 8);
+    for (auto& b : data) b = static_cast<unsigned char>(byte(rng));
+
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t length = 0; length <= 256; ++length) {
+            REQUIRE(crc32cHardware(data.data() + offset, length) ==
+                crc32cSoftware(data.data() + offset, length));
+        }
+    }
+}
+
+TEST_CASE("CRC32C: checksum extends across split buffers", "[CRC32C]") {
+    std::vector<char> data(100);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>(i * 31 + 7);
+
+    const uint32_t whole = crc32c(data.data(), data.size());
+    for (size_t split : { size_t(0), size_t(1), size_t(4), size_t(37), size_t(100) }) {
+        uint32_t head = crc32c(data.data(), split);
+        REQUIRE(crc32c(data.data() + split, data.size() - split, head) == whole);
+        REQUIRE(crc32cSoftware(data.data() + split, data.size() - split, head) == whole);
+    }
+}
+
+TEST_CASE("Packet checksum trailer", "[CRC32C][Packet][Validation]") {
+    Packet original(42, 123.5f, -67.25f, 10.0f, -20.0f);
+    char buf[Packet::wireSize()];
+    original.serializeWithChecksum(buf);
+
+    SECTION("Roundtrip") {
+        REQUIRE(Packet::hasValidChecksum(buf, sizeof(buf)));
+        Packet decoded;
+        decoded.deserialize(buf);
+        REQUIRE(decoded.seq == 42);
+        REQUIRE(decoded.x == 123.5f);
+    }
+
+    SECTION("Any single bit flip is rejected") {
+        for (size_t bit = 0; bit < sizeof(buf) * 8; ++bit) {
+            buf[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+            REQUIRE_FALSE(Packet::hasValidChecksum(buf, sizeof(buf)));
+            buf[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        }
+    }
+
+    SECTION("Wrong length is rejected") {
+        REQUIRE_FALSE(Packet::hasValidChecksum(buf, Packet::size()));
+        REQUIRE_FALSE(Packet::hasValidChecksum(buf, sizeof(buf) - 1));
+        REQUIRE_FALSE(Packet::hasValidChecksum(nullptr, sizeof(buf)));
+    }
+
+    SECTION("Unsalted checksum (foreign protocol) is rejected") {
+        uint32_t ncrc = htonl(crc32c(buf, Packet::size()));
+        memcpy(buf + Packet::size(), &ncrc, sizeof(ncrc));
+        REQUIRE_FALSE(Packet::hasValidChecksum(buf, sizeof(buf)));
+    }
+}
+
+TEST_CASE("Snapshot checksum trailer", "[CRC32C][Packet][Validation]") {
+    Packet original(42, 123.5f, -67.25f, 10.0f, -20.0f);
+    SnapshotAck ack;
+    ack.snapshotSeq = 0x01020304;
+    ack.heldMicros = 250000;
+    char buf[Packet::snapshotWireSize()];
+    original.serializeSnapshot(buf, ack);
+
+    REQUIRE(Packet::hasValidSnapshotChecksum(buf, sizeof(buf)));
+    Packet decoded;
+    decoded.deserialize(buf);
+    SnapshotAck decodedAck;
+    decodedAck.deserialize(buf + Packet::size());
+    CHECK(decoded.seq == 42);
+    CHECK(decoded.vy == -20.0f);
+    CHECK(decodedAck.snapshotSeq == 0x01020304);
+    CHECK(decodedAck.heldMicros == 250000);
+    CHECK(static_cast<uint8_t>(buf[Packet::size()]) == 0x01);   // Network byte order
+
+    for (size_t bit = 0; bit < sizeof(buf) * 8; ++bit) {
+        buf[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        REQUIRE_FALSE(Packet::hasValidSnapshotChecksum(buf, sizeof(buf)));
+        buf[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+    }
+
+    char input[Packet::wireSize()];
+    original.serializeWithChecksum(input);
+    CHECK_FALSE(Packet::hasValidSnapshotChecksum(input, sizeof(input)));
+    CHECK_FALSE(Packet::hasValidChecksum(buf, sizeof(buf)));
+}
+
+TEST_CASE("CRC32C: per-packet checksum cost", "[.][Benchmark][CRC32C]") {
+    char buf[Packet::wireSize()];
+    Packet packet(1, 200.0f, 300.0f, 120.0f, 0.0f);
+    packet.serializeWithChecksum(buf);
+
+    BENCHMARK("crc32cSoftware (20-byte payload)") {
+        return crc32cSoftware(buf, Packet::size());
+    };
+
+    if (cpuHasSse42()) {
+        BENCHMARK("crc32cHardware (20-byte payload)") {
+            return crc32cHardware(buf, Packet::size());
+        };
+    }
+
+    BENCHMARK("Packet::serializeWithChecksum") {
+        packet.seq++;
+        packet.serializeWithChecksum(buf);
+        return buf[Packet::size()];
+    };
+
+    BENCHMARK("Packet::hasValidChecksum") {
+        return Packet::hasValidChecksum(buf, sizeof(buf));
+    };
+}
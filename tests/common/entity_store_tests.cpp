@@ -0,0 +1,178 @@
+/**
+ * @file entity_store_tests.cpp
+ * @brief Unit tests and benchmarks for the sparse-set entity store.
+ *
+ * Coverage:
+ * - Create/destroy keep the columns dense and ids stable
+ * - Stale ids are rejected after destroy and index reuse
+ * - Owners can mirror the swap-remove on their own per-slot columns
+ * - Benchmark: tick loop (integrate + clamp) and snapshot building over SoA
+ *   columns vs the former per-client structs in a hash map, at 1k, 10k and
+ *   100k entities (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/entity_store.hpp"
+#include "netcode/common/packet.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("EntityStore: create and destroy keep columns dense", "[EntityStore]") {
+    EntityStore store;
+    std::vector<EntityId> ids;
+    for (uint32_t i = 0; i < 5; ++i) {
+        ids.push_back(store.create());
+        const size_t slot = store.slot(ids.back());
+        REQUIRE(slot == i);
+        REQUIRE(store.x()[slot] == 0.0f);
+        REQUIRE(store.seq()[slot] == 0u);
+        store.x()[slot] = static_cast<float>(i);
+        store.seq()[slot] = 100 + i;
+    }
+    REQUIRE(store.size() == 5);
+
+    // Destroying slot 1 moves the last entity (id 4) into it
+    REQUIRE(store.destroy(ids[1]) == 1);
+    REQUIRE(store.size() == 4);
+    REQUIRE(store.slot(ids[4]) == 1);
+    REQUIRE(store.id(1) == ids[4]);
+    REQUIRE(store.x()[1] == 4.0f);
+    REQUIRE(store.seq()[1] == 104u);
+
+    // Destroying the last slot moves nothing
+    const size_t lastSlot = store.slot(ids[3]);
+    REQUIRE(lastSlot == 3);
+    REQUIRE(store.destroy(ids[3]) == 3);
+    REQUIRE(store.size() == 3);
+
+    for (EntityId id : { ids[0], ids[2], ids[4] }) {
+        REQUIRE(store.alive(id));
+        REQUIRE(store.x()[store.slot(id)] == static_cast<float>(id.index));
+    }
+}
+
+TEST_CASE("EntityStore: stale ids are rejected", "[EntityStore][EdgeCase]") {
+    EntityStore store;
+    EntityId first = store.create();
+    REQUIRE(store.destroy(first) == 0);
+    REQUIRE_FALSE(store.alive(first));
+    REQUIRE(store.destroy(first) == EntityStore::NPOS);
+
+    // The index is reused with a new generation; the old id stays dead
+    EntityId reused = store.create();
+    REQUIRE(reused.index == first.index);
+    REQUIRE(reused.generation != first.generation);
+    REQUIRE(store.alive(reused));
+    REQUIRE_FALSE(store.alive(first));
+    REQUIRE(store.slot(first) == EntityStore::NPOS);
+
+    REQUIRE_FALSE(store.alive(EntityId{}));
+    REQUIRE_FALSE(store.alive(EntityId{ 42, 0 }));
+
+    store.clear();
+    REQUIRE(store.empty());
+    REQUIRE_FALSE(store.alive(reused));
+}
+
+TEST_CASE("EntityStore: owners mirror moves on their own columns", "[EntityStore]") {
+    EntityStore store;
+    std::vector<int> owner;
+    std::vector<EntityId> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(store.create());
+        owner.push_back(i);
+    }
+
+    for (int i = 0; i < 100; i += 3) {
+        size_t slot = store.destroy(ids[i]);
+        REQUIRE(slot != EntityStore::NPOS);
+        owner[slot] = owner.back();
+        owner.pop_back();
+    }
+
+    REQUIRE(owner.size() == store.size());
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            REQUIRE_FALSE(store.alive(ids[i]));
+        }
+        else {
+            REQUIRE(owner[store.slot(ids[i])] == i);
+        }
+    }
+}
+
+namespace {
+    const float MOVE_SPEED = 120.0f;
+    const float BOUNDS_MIN = 30.0f;
+    const float BOUNDS_MAX = 310.0f;
+    const float DT = 1.0f / 60.0f;
+
+    /** @brief The per-client struct the server kept in an unordered_map before rooms used EntityStore. */
+    struct LegacyClientState {
+        float x, y;
+        float vx, vy;
+        uint32_t lastSeq;
+        std::chrono::steady_clock::time_point lastUpdate;
+    };
+
+    void benchmarkAt(size_t count) {
+        EntityStore store;
+        store.reserve(count);
+        std::unordered_map<uint32_t, LegacyClientState> legacy;
+        for (size_t i = 0; i < count; ++i) {
+            const EntityId id = store.create();
+            const size_t slot = store.slot(id);
+            const float dir = (i % 2) ? 1.0f : -1.0f;
+            store.x()[slot] = 200.0f;
+            store.y()[slot] = 300.0f;
+            store.vx()[slot] = dir * MOVE_SPEED;
+            store.vy()[slot] = -dir * MOVE_SPEED;
+            legacy[static_cast<uint32_t>(i * 2654435761u)] =
+                { 200.0f, 300.0f, dir * MOVE_SPEED, -dir * MOVE_SPEED, 0, std::chrono::steady_clock::now() };
+        }
+        std::vector<Packet> snapshots(count);
+        const std::string n = std::to_string(count);
+
+        BENCHMARK("SoA tick + snapshots (" + n + " entities)") {
+            float* x = store.x();
+            float* y = store.y();
+            const float* vx = store.vx();
+            const float* vy = store.vy();
+            uint32_t* seq = store.seq();
+            const size_t size = store.size();
+            for (size_t i = 0; i < size; ++i) {
+                x[i] = std::clamp(x[i] + vx[i] * DT, BOUNDS_MIN, BOUNDS_MAX);
+                y[i] = std::clamp(y[i] + vy[i] * DT, BOUNDS_MIN, BOUNDS_MAX);
+                seq[i] += 1;
+            }
+            for (size_t i = 0; i < size; ++i) {
+                snapshots[i] = Packet(seq[i], x[i], y[i], vx[i], vy[i]);
+            }
+            return snapshots[size / 2].x;
+        };
+
+        BENCHMARK("unordered_map<ClientState> tick + snapshots (" + n + " entities)") {
+            size_t i = 0;
+            for (auto& entry : legacy) {
+                LegacyClientState& client = entry.second;
+                client.x = std::clamp(client.x + client.vx * DT, BOUNDS_MIN, BOUNDS_MAX);
+                client.y = std::clamp(client.y + client.vy * DT, BOUNDS_MIN, BOUNDS_MAX);
+                client.lastSeq += 1;
+                snapshots[i++] = Packet(client.lastSeq, client.x, client.y, client.vx, client.vy);
+            }
+            return snapshots[count / 2].x;
+        };
+    }
+}
+
+TEST_CASE("EntityStore: tick loop at 1k, 10k and 100k entities", "[.][Benchmark][EntityStore]") {
+    for (size_t count : { size_t(1000), size_t(10000), size_t(100000) }) {
+        benchmarkAt(count);
+    }
+}
@@ -0,0 +1,254 @@
+/**
+ * @file job_system_tests.cpp
+ * @brief Unit tests and benchmarks for the work-stealing deque and job system.
+ *
+ * Coverage:
+ * - Deque LIFO/FIFO ends, capacity limit, and exactly-once delivery under concurrent stealing
+ * - parallelFor covers every index exactly once (also nested inside another parallel loop)
+ * - parallelForEach honours affinity and balances uneven work by stealing
+ * - A room ticked in parallel produces the same state as a serial tick
+ * - The start hook runs once on each worker thread before it takes jobs
+ * - Benchmark: serial vs parallel room tick at 10k clients (hidden, "[Benchmark]")
+ *
+ * Assertions are only made on the test thread; workers record into atomics.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/job_system.hpp"
+#include "netcode/common/room.hpp"
+#include "netcode/common/work_stealing_deque.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Fills a room with clients and one tick's worth of input each.
+     */
+    void populateRoom(Room& room, size_t clients, std::chrono::steady_clock::time_point t0) {
+        for (size_t i = 0; i < clients; ++i) {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(static_cast<uint32_t>(0x0A000000 + i / 60000));
+            addr.sin_port = htons(static_cast<uint16_t>(1 + i % 60000));
+            room.join(makeClientId(addr), addr, t0);
+        }
+    }
+
+    void queueInput(Room& room, uint32_t seq, std::chrono::steady_clock::time_point at) {
+        for (size_t i = 0; i < room.size(); ++i) {
+            const float dx = static_cast<float>(static_cast<int>(i % 3) - 1);
+            const float dy = static_cast<float>(static_cast<int>((i / 3) % 3) - 1);
+            room.pushInput(room.clientAt(i), seq, dx, dy, at + std::chrono::microseconds(i % 997));
+        }
+    }
+}
+
+TEST_CASE("WorkStealingDeque: owner and thief ends", "[JobSystem]") {
+    WorkStealingDeque<int> deque(4);
+    int items[5] = { 0, 1, 2, 3, 4 };
+
+    REQUIRE(deque.pop() == nullptr);
+    REQUIRE(deque.steal() == nullptr);
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(deque.push(&items[i]));
+    }
+    REQUIRE_FALSE(deque.push(&items[4]));  // Full
+    REQUIRE(deque.size() == 4);
+
+    REQUIRE(deque.pop() == &items[3]);     // Owner: newest
+    REQUIRE(deque.steal() == &items[0]);   // Thief: oldest
+    REQUIRE(deque.pop() == &items[2]);
+    REQUIRE(deque.steal() == &items[1]);
+    REQUIRE(deque.pop() == nullptr);
+    REQUIRE(deque.steal() == nullptr);
+}
+
+TEST_CASE("WorkStealingDeque: every item is taken exactly once under contention", "[JobSystem]") {
+    const int ITEMS = 100000;
+    std::vector<int> values(ITEMS);
+    std::vector<std::atomic<int>> taken(ITEMS);
+    WorkStealingDeque<int> deque(1024);
+    std::atomic<bool> producing{ true };
+
+    auto record = [&](int* item) { taken[item - values.data()].fetch_add(1); };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            while (producing.load() || deque.size() > 0) {
+                if (int* item = deque.steal()) record(item);
+            }
+        });
+    }
+
+    for (int i = 0; i < ITEMS; ++i) {
+        while (!deque.push(&values[i])) {
+            if (int* item = deque.pop()) record(item);
+        }
+        if (i % 3 == 0) {
+            if (int* item = deque.pop()) record(item);
+        }
+    }
+    while (int* item = deque.pop()) record(item);
+    producing = false;
+    for (auto& thief : thieves) thief.join();
+
+    int wrong = 0;
+    for (auto& count : taken) {
+        if (count.load() != 1) ++wrong;
+    }
+    REQUIRE(wrong == 0);
+}
+
+TEST_CASE("JobSystem: parallelFor covers every index exactly once", "[JobSystem]") {
+    JobSystem jobs(4);
+    const size_t N = 100003;
+    std::vector<std::atomic<int>> hits(N);
+
+    for (size_t grain : { size_t(1), size_t(64), size_t(5000), size_t(1000000) }) {
+        for (auto& h : hits) h = 0;
+        jobs.parallelFor(0, N, grain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+        });
+        size_t wrong = 0;
+        for (auto& h : hits) {
+            if (h.load() != 1) ++wrong;
+        }
+        REQUIRE(wrong == 0);
+    }
+
+    // Empty and reversed ranges do nothing
+    bool called = false;
+    jobs.parallelFor(10, 10, 1, [&](size_t, size_t) { called = true; });
+    jobs.parallelFor(10, 5, 1, [&](size_t, size_t) { called = true; });
+    REQUIRE_FALSE(called);
+}
+
+TEST_CASE("JobSystem: nested parallel loops complete", "[JobSystem]") {
+    JobSystem jobs(3);
+    std::atomic<size_t> total{ 0 };
+    std::atomic<bool> outsideWorker{ false };
+
+    jobs.parallelForEach(16, [](size_t i) { return i; }, [&](size_t) {
+        if (jobs.currentWorker() == JobSystem::NOT_A_WORKER) outsideWorker = true;
+        jobs.parallelFor(0, 1000, 10, [&](size_t begin, size_t end) {
+            total.fetch_add(end - begin);
+        });
+    });
+
+    REQUIRE(total.load() == 16 * 1000);
+    REQUIRE_FALSE(outsideWorker.load());
+    REQUIRE(jobs.currentWorker() == JobSystem::NOT_A_WORKER);
+}
+
+TEST_CASE("JobSystem: affinity and stealing", "[JobSystem]") {
+    JobSystem jobs(4);
+
+    SECTION("Balanced items run on their preferred worker") {
+        std::atomic<int> home{ 0 }, invalid{ 0 };
+        for (int attempt = 0; attempt < 20; ++attempt) {
+            jobs.parallelForEach(8, [](size_t i) { return i; }, [&](size_t i) {
+                const size_t worker = jobs.currentWorker();
+                if (worker >= jobs.workerCount()) invalid++;
+                if (worker == i % jobs.workerCount()) home++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            });
+        }
+        // Every item ran on a worker; with equal load items mostly stay home
+        REQUIRE(invalid.load() == 0);
+        REQUIRE(home.load() > 0);
+    }
+
+    SECTION("Uneven items are stolen") {
+        const uint64_t before = jobs.steals();
+        std::atomic<int> elsewhere{ 0 };
+        jobs.parallelForEach(16, [](size_t) { return 0; }, [&](size_t) {
+            if (jobs.currentWorker() != 0) elsewhere++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        });
+        REQUIRE(elsewhere.load() > 0);
+        REQUIRE(jobs.steals() - before == static_cast<uint64_t>(elsewhere.load()));
+    }
+}
+
+TEST_CASE("JobSystem: start hook runs once per worker", "[JobSystem]") {
+    std::atomic<int> started[4] = {};
+    std::atomic<int> wrongWorker{ 0 };
+    {
+        JobSystem* pool = nullptr;
+        std::atomic<bool> ready{ false };
+        JobSystem jobs(4, [&](size_t worker) {
+            started[worker].fetch_add(1);
+            while (!ready) std::this_thread::yield();
+            if (pool->currentWorker() != worker) {
+                wrongWorker.fetch_add(1);
+            }
+        });
+        pool = &jobs;
+        ready = true;
+        std::atomic<int> ran{ 0 };
+        jobs.parallelFor(0, 64, 1, [&](size_t b, size_t e) { ran.fetch_add(static_cast<int>(e - b)); });
+        CHECK(ran == 64);
+    }
+    for (const auto& count : started) {
+        CHECK(count == 1);
+    }
+    CHECK(wrongWorker == 0);
+}
+
+TEST_CASE("JobSystem: parallel room tick matches serial tick", "[JobSystem][Room]") {
+    JobSystem jobs(4);
+    const auto t0 = std::chrono::steady_clock::now();
+    Room serial(0, 5000), parallel(1, 5000);
+    populateRoom(serial, 5000, t0);
+    populateRoom(parallel, 5000, t0);
+
+    for (uint32_t seq = 1; seq <= 5; ++seq) {
+        const auto at = t0 + std::chrono::milliseconds(16 * seq);
+        queueInput(serial, seq, at);
+        queueInput(parallel, seq, at);
+        if (seq == 3) {
+            queueInput(serial, seq - 1, at);    // Stale duplicates are ignored the same way
+            queueInput(parallel, seq - 1, at);
+        }
+
+        std::vector<RoomOutput> a, b;
+        REQUIRE(serial.tick(a) == parallel.tick(b, &jobs));
+        REQUIRE(a.size() == b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            REQUIRE(std::memcmp(&a[i].packet, &b[i].packet, sizeof(Packet)) == 0);
+        }
+    }
+}
+
+TEST_CASE("JobSystem: room tick at 10k clients", "[.][Benchmark][JobSystem]") {
+    const size_t workers = std::max(2u, std::thread::hardware_concurrency());
+    JobSystem jobs(workers);
+    const auto t0 = std::chrono::steady_clock::now();
+    Room room(0, 10000);
+    populateRoom(room, 10000, t0);
+    std::vector<RoomOutput> out;
+    out.reserve(10000);
+    uint32_t seq = 0;
+
+    BENCHMARK("Room::tick serial (10k clients)") {
+        ++seq;
+        queueInput(room, seq, t0 + std::chrono::milliseconds(seq));
+        out.clear();
+        return room.tick(out);
+    };
+
+    BENCHMARK("Room::tick parallelFor (10k clients, " + std::to_string(workers) + " workers)") {
+        ++seq;
+        queueInput(room, seq, t0 + std::chrono::milliseconds(seq));
+        out.clear();
+        return room.tick(out, &jobs);
+    };
+}
@@ -0,0 +1,177 @@
+/**
+ * @file packet_batch_tests.cpp
+ * @brief Unit tests and benchmarks for PacketBatch deserialization and SIMD validation.
+ *
+ * Coverage:
+ * - Batch deserialization matches per-packet Packet::deserialize()
+ * - Validity bitmask matches Packet::isValid() on every SIMD tier
+ * - NaN/Inf/boundary/seq=0 lanes and non-multiple-of-8 tails
+ * - Benchmark: per-packet isValid() vs. batch validation (hidden, run with "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/packet_batch.hpp"
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Serializes packets back-to-back into one contiguous buffer.
+     */
+    std::vector<char> serializeAll(const std::vector<Packet>& packets) {
+        std::vector<char> buf(packets.size() * Packet::size());
+        for (size_t i = 0; i < packets.size(); ++i) {
+            packets[i].serialize(buf.data() + i * Packet::size());
+        }
+        return buf;
+    }
+
+    /**
+     * @brief Generates a mix of valid packets and packets with one bad field.
+     */
+    std::vector<Packet> makeMixedPackets(size_t count, unsigned seed) {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const float inf = std::numeric_limits<float>::infinity();
+        const float badValues[] = { nan, -nan, inf, -inf, 10000.1f, -50000.0f, 1000.1f, -5000.0f };
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-Packet::MAX_POSITION, Packet::MAX_POSITION);
+        std::uniform_real_distribution<float> vel(-Packet::MAX_VELOCITY, Packet::MAX_VELOCITY);
+        std::uniform_int_distribution<int> pick(0, 9);
+        std::uniform_int_distribution<int> bad(0, 7);
+
+        std::vector<Packet> packets;
+        for (size_t i = 0; i < count; ++i) {
+            Packet pkt(static_cast<uint32_t>(i + 1), pos(rng), pos(rng), vel(rng), vel(rng));
+            switch (pick(rng)) {
+            case 0: pkt.seq = 0; break;
+            case 1: pkt.x = badValues[bad(rng)]; break;
+            case 2: pkt.y = badValues[bad(rng)]; break;
+            case 3: pkt.vx = badValues[bad(rng)]; break;
+            case 4: pkt.vy = badValues[bad(rng)]; break;
+            default: break;
+            }
+            packets.push_back(pkt);
+        }
+        return packets;
+    }
+}
+
+TEST_CASE("PacketBatch: deserialize matches Packet::deserialize", "[PacketBatch]") {
+    std::vector<Packet> packets = makeMixedPackets(37, 1);
+    std::vector<char> buf = serializeAll(packets);
+
+    PacketBatch batch;
+    batch.deserialize(buf.data(), packets.size());
+    REQUIRE(batch.size() == packets.size());
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        Packet expected;
+        expected.deserialize(buf.data() + i * Packet::size());
+        Packet actual = batch.at(i);
+        REQUIRE(actual.seq == expected.seq);
+        REQUIRE(std::memcmp(&actual.x, &expected.x, sizeof(float)) == 0);
+        REQUIRE(std::memcmp(&actual.y, &expected.y, sizeof(float)) == 0);
+        REQUIRE(std::memcmp(&actual.vx, &expected.vx, sizeof(float)) == 0);
+        REQUIRE(std::memcmp(&actual.vy, &expected.vy, sizeof(float)) == 0);
+    }
+}
+
+TEST_CASE("PacketBatch: validity mask matches Packet::isValid on every SIMD tier", "[PacketBatch][Validation]") {
+    // 203 is deliberately not a multiple of 4 or 8, so every kernel also exercises its scalar tail
+    std::vector<Packet> packets = makeMixedPackets(203, 42);
+    std::vector<char> buf = serializeAll(packets);
+
+    PacketBatch batch;
+    batch.deserialize(buf.data(), packets.size());
+
+    size_t expectedValid = 0;
+    for (const auto& pkt : packets) {
+        if (pkt.isValid()) ++expectedValid;
+    }
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2 }) {
+        INFO("SIMD level: " << simdLevelName(level));
+        std::vector<uint64_t> mask;
+        size_t validCount = batch.validate(mask, level);
+
+        REQUIRE(mask.size() == (packets.size() + 63) / 64);
+        REQUIRE(validCount == expectedValid);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            INFO("packet " << i);
+            REQUIRE(PacketBatch::isSet(mask, i) == packets[i].isValid());
+        }
+    }
+}
+
+TEST_CASE("PacketBatch: boundary values", "[PacketBatch][Validation]") {
+    std::vector<Packet> packets = {
+        Packet(1, Packet::MAX_POSITION, -Packet::MAX_POSITION, Packet::MAX_VELOCITY, -Packet::MAX_VELOCITY),
+        Packet(UINT32_MAX, 0.0f, -0.0f, 0.0f, -0.0f),
+        Packet(0, 0.0f, 0.0f, 0.0f, 0.0f),
+        Packet(7, 10000.1f, 0.0f, 0.0f, 0.0f),
+        Packet(8, 0.0f, 0.0f, 1000.1f, 0.0f),
+        Packet(9, std::numeric_limits<float>::denorm_min(), 0.0f, 0.0f, 0.0f),
+        Packet(10, 1.0f, 2.0f, 3.0f, 4.0f),
+        Packet(11, 1.0f, 2.0f, 3.0f, -std::numeric_limits<float>::infinity()),
+    };
+    std::vector<char> buf = serializeAll(packets);
+
+    PacketBatch batch;
+    batch.deserialize(buf.data(), packets.size());
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2 }) {
+        std::vector<uint64_t> mask;
+        REQUIRE(batch.validate(mask, level) == 4);
+        REQUIRE(mask[0] == 0b01100011);
+    }
+}
+
+TEST_CASE("PacketBatch: empty batch", "[PacketBatch][EdgeCase]") {
+    PacketBatch batch;
+    batch.deserialize(nullptr, 0);
+
+    std::vector<uint64_t> mask{ 0xFFFF };
+    REQUIRE(batch.validate(mask) == 0);
+    REQUIRE(mask.empty());
+}
+
+TEST_CASE("PacketBatch: validation throughput", "[.][Benchmark][PacketBatch]") {
+    std::vector<Packet> packets = makeMixedPackets(1024, 7);
+    std::vector<char> buf = serializeAll(packets);
+    PacketBatch batch;
+    batch.deserialize(buf.data(), packets.size());
+    std::vector<uint64_t> mask;
+
+    BENCHMARK("1024 packets: deserialize + isValid() one at a time") {
+        size_t valid = 0;
+        for (size_t i = 0; i < packets.size(); ++i) {
+            Packet pkt;
+            pkt.deserialize(buf.data() + i * Packet::size());
+            valid += pkt.isValid() ? 1 : 0;
+        }
+        return valid;
+    };
+
+    BENCHMARK("1024 packets: batch deserialize") {
+        batch.deserialize(buf.data(), packets.size());
+        return batch.size();
+    };
+
+    BENCHMARK("1024 packets: batch validate (scalar)") {
+        return batch.validate(mask, SimdLevel::Scalar);
+    };
+
+    BENCHMARK("1024 packets: batch validate (SSE)") {
+        return batch.validate(mask, SimdLevel::SSE);
+    };
+
+    BENCHMARK("1024 packets: batch validate (AVX2)") {
+        return batch.validate(mask, SimdLevel::AVX2);
+    };
+}
@@ -0,0 +1,102 @@
+/**
+ * @file packet_view_tests.cpp
+ * @brief Unit tests for the zero-copy PacketView.
+ *
+ * Coverage:
+ * - Field reads match Packet::deserialize() on the same bytes
+ * - isValid() agrees with Packet::isValid() and also checks the datagram size
+ * - Truncated, oversized and null buffers are handled safely
+ * - The view reads the caller's buffer in place (no hidden copy)
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/packet_view.hpp"
+#include <limits>
+
+TEST_CASE("PacketView: reads the same fields as Packet::deserialize", "[PacketView]") {
+    Packet original(0x01020304, 123.45f, -54.321f, 3.5f, -2.0f);
+    char buf[Packet::size()];
+    original.serialize(buf);
+
+    PacketView view(buf, sizeof(buf));
+    REQUIRE(view.hasValidSize());
+    REQUIRE(view.seq() == 0x01020304);
+    REQUIRE(view.x() == original.x);
+    REQUIRE(view.y() == original.y);
+    REQUIRE(view.vx() == original.vx);
+    REQUIRE(view.vy() == original.vy);
+
+    Packet copy = view.toPacket();
+    REQUIRE(copy.seq == original.seq);
+    REQUIRE(copy.x == original.x);
+    REQUIRE(copy.vy == original.vy);
+}
+
+TEST_CASE("PacketView: validation matches Packet::isValid", "[PacketView][Validation]") {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    Packet cases[] = {
+        Packet(1, 0.0f, 0.0f, 0.0f, 0.0f),
+        Packet(0, 0.0f, 0.0f, 0.0f, 0.0f),
+        Packet(2, nan, 0.0f, 0.0f, 0.0f),
+        Packet(3, 0.0f, -inf, 0.0f, 0.0f),
+        Packet(4, 10000.0f, -10000.0f, 1000.0f, -1000.0f),
+        Packet(5, 10000.1f, 0.0f, 0.0f, 0.0f),
+        Packet(6, 0.0f, 0.0f, 0.0f, -1000.1f),
+    };
+
+    for (const auto& pkt : cases) {
+        char buf[Packet::size()];
+        pkt.serialize(buf);
+        INFO("seq " << pkt.seq);
+        REQUIRE(PacketView(buf, sizeof(buf)).isValid() == pkt.isValid());
+    }
+}
+
+TEST_CASE("PacketView: wrong-sized and empty buffers are safe", "[PacketView][EdgeCase]") {
+    Packet pkt(7, 1.0f, 2.0f, 3.0f, 4.0f);
+    char buf[Packet::size() + 4] = {};
+    pkt.serialize(buf);
+
+    SECTION("Truncated datagram") {
+        PacketView view(buf, 10);
+        REQUIRE_FALSE(view.hasValidSize());
+        REQUIRE_FALSE(view.isValid());
+        REQUIRE(view.seq() == 7);
+        REQUIRE(view.x() == 1.0f);
+        REQUIRE(view.y() == 0.0f);   // Only 2 of 4 bytes present -> not read
+        REQUIRE(view.vy() == 0.0f);
+    }
+
+    SECTION("Oversized datagram") {
+        PacketView view(buf, sizeof(buf));
+        REQUIRE_FALSE(view.hasValidSize());
+        REQUIRE_FALSE(view.isValid());
+    }
+
+    SECTION("Null buffer") {
+        PacketView view;
+        REQUIRE_FALSE(view.hasValidSize());
+        REQUIRE(view.seq() == 0);
+        REQUIRE(view.x() == 0.0f);
+        REQUIRE_FALSE(view.isValid());
+    }
+}
+
+TEST_CASE("PacketView: reads the buffer in place", "[PacketView]") {
+    Packet pkt(9, 1.0f, 2.0f, 3.0f, 4.0f);
+    char buf[Packet::size()];
+    pkt.serialize(buf);
+
+    PacketView view(buf, sizeof(buf));
+    REQUIRE(view.data() == buf);
+    REQUIRE(view.length() == Packet::size());
+
+    // Overwriting the receive buffer is visible through the view: nothing was copied
+    Packet(10, 5.0f, 6.0f, 7.0f, 8.0f).serialize(buf);
+    REQUIRE(view.seq() == 10);
+    REQUIRE(view.x() == 5.0f);
+}
@@ -0,0 +1,276 @@
+/**
+ * @file reactor_tests.cpp
+ * @brief Unit tests and benchmark for Task<T> coroutines and the Reactor event loop.
+ *
+ * Coverage:
+ * - Tasks start lazily, return values through nested co_await and destroy unfinished frames
+ * - sleepUntil() resumes coroutines in deadline order, on one thread
+ * - readable() times out without data and wakes when a datagram arrives
+ * - asyncRecvFrom()/asyncSendTo(): a request/reply exchange with a timed-out retry, written linearly
+ * - post(), stop() and ReactorEvent::set() from another thread wake the loop
+ * - Benchmark: datagram round trips between two coroutines on one thread vs two blocking threads
+ *   (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/reactor.hpp"
+#include "netcode/common/task.hpp"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std::chrono_literals;
+
+namespace {
+    Task<int> square(int value) {
+        co_return value * value;
+    }
+
+    Task<int> sumOfSquares(int a, int b, int& steps) {
+        ++steps;
+        const int first = co_await square(a);
+        ++steps;
+        const int second = co_await square(b);
+        ++steps;
+        co_return first + second;
+    }
+
+    Task<void> store(int& out, int& steps) {
+        out = co_await sumOfSquares(3, 4, steps);
+    }
+
+    struct Guard {
+        int& destroyed;
+        ~Guard() { ++destroyed; }
+    };
+
+    Task<void> sleeper(Reactor& reactor, std::vector<int>& order, int id, std::chrono::milliseconds delay) {
+        co_await reactor.sleepFor(delay);
+        order.push_back(id);
+    }
+
+    Task<void> forever(Reactor& reactor, int& destroyed) {
+        Guard guard{ destroyed };
+        co_await reactor.sleepFor(std::chrono::hours(1));
+    }
+}
+
+TEST_CASE("Task: lazy start, nested awaits and results", "[Reactor]") {
+    Reactor reactor;
+    int result = 0;
+    int steps = 0;
+    Task<void> task = store(result, steps);
+    CHECK(steps == 0);   // Nothing runs until the task is started
+    CHECK_FALSE(task.done());
+    reactor.spawn(std::move(task));
+    reactor.run();
+    CHECK(result == 25);
+    CHECK(steps == 3);
+    CHECK(reactor.tasks() == 0);
+}
+
+TEST_CASE("Reactor: timers resume in deadline order", "[Reactor]") {
+    Reactor reactor;
+    std::vector<int> order;
+    const auto start = Reactor::Clock::now();
+    reactor.spawn(sleeper(reactor, order, 3, 30ms));
+    reactor.spawn(sleeper(reactor, order, 1, 10ms));
+    reactor.spawn(sleeper(reactor, order, 2, 20ms));
+    reactor.run();
+    CHECK(order == std::vector<int>{ 1, 2, 3 });
+    CHECK(Reactor::Clock::now() - start >= 30ms);
+}
+
+TEST_CASE("Reactor: unfinished tasks are destroyed with the reactor", "[Reactor]") {
+    int destroyed = 0;
+    {
+        Reactor reactor;
+        reactor.spawn(forever(reactor, destroyed));
+        reactor.spawn(forever(reactor, destroyed));
+        reactor.runUntil(Reactor::after(5ms));
+        CHECK(reactor.tasks() == 2);
+        CHECK(destroyed == 0);
+    }
+    CHECK(destroyed == 2);
+}
+
+TEST_CASE("Reactor: post, stop and ReactorEvent from another thread", "[Reactor]") {
+    Reactor reactor;
+    ReactorEvent event(reactor);
+    int wakeups = 0;
+    bool timedOut = false;
+    bool posted = false;
+
+    reactor.spawn([](ReactorEvent& event, int& wakeups, bool& timedOut) -> Task<void> {
+        timedOut = !co_await event.wait(Reactor::after(5ms));
+        while (co_await event.wait()) {
+            ++wakeups;
+        }
+    }(event, wakeups, timedOut));
+
+    std::thread other([&] {
+        std::this_thread::sleep_for(20ms);
+        event.set();
+        std::this_thread::sleep_for(20ms);
+        event.set();
+        event.set();   // Coalesces with the previous set() unless that one was already consumed
+        std::this_thread::sleep_for(20ms);
+        reactor.post([&] { posted = true; });
+        std::this_thread::sleep_for(20ms);
+        reactor.stop();
+    });
+    reactor.run();
+    other.join();
+
+    CHECK(timedOut);
+    CHECK(wakeups >= 2);
+    CHECK(wakeups <= 3);
+    CHECK(posted);
+    CHECK(reactor.tasks() == 1);   // Still waiting; stop() does not cancel tasks
+}
+
+#ifndef _WIN32
+namespace {
+    struct NonBlockingSocket {
+        int fd = -1;
+        sockaddr_in addr{};
+
+        NonBlockingSocket() {
+            fd = socket(AF_INET, SOCK_DGRAM, 0);
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            socklen_t len = sizeof(addr);
+            getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        }
+        ~NonBlockingSocket() { close(fd); }
+    };
+
+    // Answers every request once, except the first, which it ignores (a lost datagram)
+    Task<void> echoServer(Reactor& reactor, NonBlockingSocket& sock, int requests) {
+        char buffer[64];
+        sockaddr_in from{};
+        for (int i = 0; i < requests; ++i) {
+            const int bytes = co_await asyncRecvFrom(reactor, sock.fd, buffer, sizeof(buffer), from);
+            if (i > 0 && bytes > 0) {
+                co_await asyncSendTo(reactor, sock.fd, buffer, static_cast<size_t>(bytes), from);
+            }
+        }
+    }
+
+    // Sends a request and waits for the reply, resending after a timeout
+    Task<std::string> request(Reactor& reactor, NonBlockingSocket& sock, const sockaddr_in& server,
+        const std::string& text, int& attempts) {
+        char buffer[64];
+        sockaddr_in from{};
+        while (true) {
+            ++attempts;
+            co_await asyncSendTo(reactor, sock.fd, text.data(), text.size(), server);
+            const int bytes = co_await asyncRecvFrom(reactor, sock.fd, buffer, sizeof(buffer), from, Reactor::after(20ms));
+            if (bytes >= 0) {
+                co_return std::string(buffer, static_cast<size_t>(bytes));
+            }
+        }
+    }
+}
+
+TEST_CASE("Reactor: readable times out, then wakes on data", "[Reactor]") {
+    Reactor reactor;
+    NonBlockingSocket receiver;
+    NonBlockingSocket sender;
+    bool first = true;
+    bool second = false;
+
+    reactor.spawn([](Reactor& reactor, int fd, bool& first, bool& second) -> Task<void> {
+        first = co_await reactor.readable(fd, Reactor::after(10ms));
+        second = co_await reactor.readable(fd, Reactor::after(2s));
+    }(reactor, receiver.fd, first, second));
+    reactor.spawn([](Reactor& reactor, NonBlockingSocket& sender, const sockaddr_in& to) -> Task<void> {
+        co_await reactor.sleepFor(30ms);
+        co_await asyncSendTo(reactor, sender.fd, "x", 1, to);
+    }(reactor, sender, receiver.addr));
+
+    const auto start = Reactor::Clock::now();
+    reactor.run();
+    CHECK_FALSE(first);
+    CHECK(second);
+    CHECK(Reactor::Clock::now() - start < 1s);
+}
+
+TEST_CASE("Reactor: request/reply with retry, one thread", "[Reactor]") {
+    Reactor reactor;
+    NonBlockingSocket server;
+    NonBlockingSocket client;
+    std::vector<std::string> replies;
+    int attempts = 0;
+
+    reactor.spawn(echoServer(reactor, server, 4));
+    reactor.spawn([](Reactor& reactor, NonBlockingSocket& client, const sockaddr_in& server,
+        std::vector<std::string>& replies, int& attempts) -> Task<void> {
+        for (const char* text : { "hello", "world", "again" }) {
+            replies.push_back(co_await request(reactor, client, server, text, attempts));
+        }
+    }(reactor, client, server.addr, replies, attempts));
+    reactor.run();
+
+    CHECK(replies == std::vector<std::string>{ "hello", "world", "again" });
+    CHECK(attempts == 4);   // The first request was ignored and resent once
+    CHECK(reactor.tasks() == 0);
+}
+
+TEST_CASE("Reactor: round trips, coroutines vs threads", "[.][Benchmark][Reactor]") {
+    constexpr int ROUND_TRIPS = 2000;
+
+    BENCHMARK("2000 round trips, two coroutines on one thread") {
+        Reactor reactor;
+        NonBlockingSocket a;
+        NonBlockingSocket b;
+        auto bounce = [](Reactor& reactor, NonBlockingSocket& self, const sockaddr_in& peer, bool serve) -> Task<void> {
+            char buffer[64] = {};
+            sockaddr_in from{};
+            for (int i = 0; i < ROUND_TRIPS; ++i) {
+                if (!serve) co_await asyncSendTo(reactor, self.fd, buffer, 32, peer);
+                co_await asyncRecvFrom(reactor, self.fd, buffer, sizeof(buffer), from);
+                if (serve) co_await asyncSendTo(reactor, self.fd, buffer, 32, peer);
+            }
+        };
+        reactor.spawn(bounce(reactor, a, b.addr, true));
+        reactor.spawn(bounce(reactor, b, a.addr, false));
+        reactor.run();
+        return reactor.tasks();
+    };
+
+    BENCHMARK("2000 round trips, two blocking threads") {
+        NonBlockingSocket a;
+        NonBlockingSocket b;
+        fcntl(a.fd, F_SETFL, fcntl(a.fd, F_GETFL, 0) & ~O_NONBLOCK);
+        fcntl(b.fd, F_SETFL, fcntl(b.fd, F_GETFL, 0) & ~O_NONBLOCK);
+        std::thread server([&] {
+            char buffer[64];
+            for (int i = 0; i < ROUND_TRIPS; ++i) {
+                recv(a.fd, buffer, sizeof(buffer), 0);
+                sendto(a.fd, buffer, 32, 0, reinterpret_cast<const sockaddr*>(&b.addr), sizeof(b.addr));
+            }
+        });
+        char buffer[64] = {};
+        for (int i = 0; i < ROUND_TRIPS; ++i) {
+            sendto(b.fd, buffer, 32, 0, reinterpret_cast<const sockaddr*>(&a.addr), sizeof(a.addr));
+            recv(b.fd, buffer, sizeof(buffer), 0);
+        }
+        server.join();
+        return buffer[0];
+    };
+}
+#endif
@@ -0,0 +1,250 @@
+/**
+ * @file snapshot_codec_tests.cpp
+ * @brief Unit tests, benchmarks and model training for the range-coded snapshot codec.
+ *
+ * Coverage:
+ * - Residual mapping is bit-exact for arbitrary float payloads
+ * - Encode/decode roundtrip for captured and random (incompressible) snapshots
+ * - Raw fallback, capacity limits and malformed input
+ * - Compression ratio on a held-out capture
+ * - Benchmark: encode/decode ns per packet and compression ratio (hidden, "[Benchmark]")
+ * - Model training: regenerates snapshot_model.inl (hidden, "[Train]")
+ *
+ * Captures are recorded from a simulated play session that runs the server's
+ * movement rules on ~30 Hz inputs with timing jitter, idle periods and
+ * occasional packet loss.
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/snapshot_codec.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Records the server snapshots of a simulated play session.
+     * @param count Number of snapshots
+     * @param seed  RNG seed (use different seeds for training and evaluation)
+     */
+    std::vector<Packet> recordCapture(size_t count, unsigned seed) {
+        const float MOVE_SPEED = 120.0f;
+        const float BOUNDS_MIN = 30.0f;
+        const float BOUNDS_MAX = 310.0f;
+        const float directions[][2] = {
+            { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 },
+            { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }
+        };
+
+        std::mt19937 rng(seed);
+        std::exponential_distribution<float> holdTime(1.0f / 0.6f);
+        std::normal_distribution<float> sendJitter(0.0333f, 0.003f);
+        std::uniform_int_distribution<int> pickDirection(0, 11);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+        std::vector<Packet> capture;
+        Packet state(1, 200.0f, 300.0f, 0.0f, 0.0f);
+        float inputX = 0.0f, inputY = 0.0f, holdLeft = 0.0f;
+
+        while (capture.size() < count) {
+            if (holdLeft <= 0.0f) {
+                const auto& dir = directions[pickDirection(rng)];
+                inputX = dir[0];
+                inputY = dir[1];
+                holdLeft = holdTime(rng);
+            }
+            const float dt = std::clamp(sendJitter(rng), 0.0f, 0.1f);
+            holdLeft -= dt;
+
+            state.seq += (chance(rng) < 0.02f) ? 2 : 1;  // ~2% loss shows up as a gap
+            state.vx = inputX * MOVE_SPEED;
+            state.vy = inputY * MOVE_SPEED;
+            state.x = std::clamp(state.x + state.vx * dt, BOUNDS_MIN, BOUNDS_MAX);
+            state.y = std::clamp(state.y + state.vy * dt, BOUNDS_MIN, BOUNDS_MAX);
+            capture.push_back(state);
+        }
+        return capture;
+    }
+
+    struct CaptureStats {
+        size_t rawBytes = 0;
+        size_t encodedBytes = 0;
+        double ratio() const { return rawBytes ? static_cast<double>(encodedBytes) / rawBytes : 0.0; }
+    };
+
+    /**
+     * @brief Encodes a capture (each snapshot against the previous one) and checks the roundtrip.
+     */
+    CaptureStats encodeCapture(const std::vector<Packet>& capture) {
+        CaptureStats stats;
+        Packet baseline;
+        for (const auto& snapshot : capture) {
+            char buf[Packet::size()];
+            size_t length = encodeSnapshot(snapshot, baseline, buf, sizeof(buf));
+            REQUIRE(length > 0);
+
+            Packet decoded;
+            REQUIRE(decodeSnapshot(buf, length, baseline, decoded));
+            REQUIRE(std::memcmp(&decoded, &snapshot, sizeof(Packet)) == 0);
+
+            stats.rawBytes += Packet::size();
+            stats.encodedBytes += length;
+            baseline = snapshot;
+        }
+        return stats;
+    }
+}
+
+TEST_CASE("Snapshot codec: residual mapping is bit-exact", "[SnapshotCodec]") {
+    const float specials[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 310.0f, std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()
+    };
+    for (float a : specials) {
+        for (float b : specials) {
+            Packet snapshot(UINT32_MAX, a, b, b, a);
+            Packet baseline(7, b, a, a, b);
+            uint8_t symbols[SNAPSHOT_SYMBOLS];
+            snapshotToSymbols(snapshot, baseline, symbols);
+            Packet restored = snapshotFromSymbols(symbols, baseline);
+            REQUIRE(std::memcmp(&restored, &snapshot, sizeof(Packet)) == 0);
+        }
+    }
+}
+
+TEST_CASE("Snapshot codec: unchanged snapshot compresses to almost nothing", "[SnapshotCodec]") {
+    Packet baseline(41, 200.0f, 300.0f, 0.0f, 0.0f);
+    Packet snapshot(42, 200.0f, 300.0f, 0.0f, 0.0f);
+
+    char buf[Packet::size()];
+    size_t length = encodeSnapshot(snapshot, baseline, buf, sizeof(buf));
+    REQUIRE(length > 0);
+    REQUIRE(length <= 2);
+
+    Packet decoded;
+    REQUIRE(decodeSnapshot(buf, length, baseline, decoded));
+    REQUIRE(decoded.seq == 42);
+    REQUIRE(decoded.x == 200.0f);
+    REQUIRE(decoded.vy == 0.0f);
+}
+
+TEST_CASE("Snapshot codec: random snapshots roundtrip and never exceed raw size", "[SnapshotCodec]") {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> bits;
+
+    for (int i = 0; i < 2000; ++i) {
+        uint32_t words[10];
+        for (auto& w : words) w = bits(rng);
+        Packet snapshot, baseline;
+        std::memcpy(&snapshot.seq, &words[0], 4);
+        std::memcpy(&snapshot.x, &words[1], 16);
+        std::memcpy(&baseline.seq, &words[5], 4);
+        std::memcpy(&baseline.x, &words[6], 16);
+
+        char buf[Packet::size()];
+        size_t length = encodeSnapshot(snapshot, baseline, buf, sizeof(buf));
+        REQUIRE(length > 0);
+        REQUIRE(length <= Packet::size());
+
+        Packet decoded;
+        REQUIRE(decodeSnapshot(buf, length, baseline, decoded));
+        REQUIRE(std::memcmp(&decoded, &snapshot, sizeof(Packet)) == 0);
+    }
+}
+
+TEST_CASE("Snapshot codec: capacity and malformed input", "[SnapshotCodec][EdgeCase]") {
+    Packet baseline(1, 100.0f, 100.0f, 0.0f, 0.0f);
+    Packet snapshot(2, 104.0f, 100.0f, 120.0f, 0.0f);
+
+    SECTION("Output buffer too small") {
+        char buf[1];
+        REQUIRE(encodeSnapshot(Packet(9, 1e9f, -1e9f, 3.0f, 7.0f), baseline, buf, sizeof(buf)) == 0);
+    }
+
+    SECTION("Empty and oversized input are rejected") {
+        char buf[Packet::size() + 1] = {};
+        Packet decoded;
+        REQUIRE_FALSE(decodeSnapshot(buf, 0, baseline, decoded));
+        REQUIRE_FALSE(decodeSnapshot(buf, sizeof(buf), baseline, decoded));
+    }
+
+    SECTION("Raw fallback is a plain serialized packet") {
+        char buf[Packet::size()];
+        Packet noisy(0x9E3779B9, -1234.5f, 9876.25f, -777.0f, 555.5f);
+        REQUIRE(encodeSnapshot(noisy, Packet(), buf, sizeof(buf)) == Packet::size());
+
+        Packet plain;
+        plain.deserialize(buf);
+        REQUIRE(plain.seq == noisy.seq);
+        REQUIRE(plain.x == noisy.x);
+    }
+}
+
+TEST_CASE("Snapshot codec: compression ratio on a held-out capture", "[SnapshotCodec]") {
+    // Seed differs from the training capture, so this measures generalization
+    CaptureStats stats = encodeCapture(recordCapture(5000, 2024));
+    INFO("compression ratio " << stats.ratio());
+    REQUIRE(stats.ratio() < 0.5);
+}
+
+TEST_CASE("Snapshot codec: encode/decode cost and compression ratio", "[.][Benchmark][SnapshotCodec]") {
+    std::vector<Packet> capture = recordCapture(4096, 2024);
+    CaptureStats stats = encodeCapture(capture);
+    std::cout << "Snapshot codec: " << stats.encodedBytes << " / " << stats.rawBytes
+        << " bytes, compression ratio " << stats.ratio()
+        << " (" << (static_cast<double>(stats.encodedBytes) / capture.size()) << " bytes/packet)" << std::endl;
+
+    std::vector<std::vector<char>> encoded;
+    for (size_t i = 1; i < capture.size(); ++i) {
+        std::vector<char> buf(Packet::size());
+        buf.resize(encodeSnapshot(capture[i], capture[i - 1], buf.data(), buf.size()));
+        encoded.push_back(buf);
+    }
+
+    size_t next = 1;
+    BENCHMARK("encodeSnapshot (ns per packet)") {
+        char buf[Packet::size()];
+        next = next + 1 < capture.size() ? next + 1 : 1;
+        return encodeSnapshot(capture[next], capture[next - 1], buf, sizeof(buf));
+    };
+
+    BENCHMARK("decodeSnapshot (ns per packet)") {
+        Packet decoded;
+        next = next + 1 < capture.size() ? next + 1 : 1;
+        const auto& buf = encoded[next - 1];
+        decodeSnapshot(buf.data(), buf.size(), capture[next - 1], decoded);
+        return decoded.seq;
+    };
+
+    BENCHMARK("Packet::serialize (raw baseline, ns per packet)") {
+        char buf[Packet::size()];
+        next = next + 1 < capture.size() ? next + 1 : 1;
+        capture[next].serialize(buf);
+        return buf[0];
+    };
+}
+
+TEST_CASE("Snapshot codec: train static model", "[.][Train]") {
+    // Writes snapshot_model.inl to the working directory; copy it to src/common/ and rebuild
+    SnapshotModelTrainer trainer;
+    for (unsigned session = 0; session < 8; ++session) {
+        std::vector<Packet> capture = recordCapture(20000, 100 + session);
+        Packet baseline;
+        for (const auto& snapshot : capture) {
+            trainer.observe(snapshot, baseline);
+            baseline = snapshot;
+        }
+    }
+
+    std::ofstream("snapshot_model.inl") << trainer.toSource();
+    std::cout << "Trained on " << trainer.samples() << " snapshots -> snapshot_model.inl" << std::endl;
+    REQUIRE(trainer.samples() == 160000);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file async_log_tests.cpp
+ * @brief Unit tests for the asynchronous log and its rate limit.
+ *
+ * Coverage:
+ * - Lines reach their stream in order, timestamped, with Info and Warning kept apart
+ * - A full pool drops lines (counted) instead of blocking; long lines are cut at the record size
+ * - LogRateLimit lets perWindow lines through per window and reports how many it held back
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/async_log.hpp"
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    std::vector<std::string> lines(const std::ostringstream& stream) {
+        std::vector<std::string> result;
+        std::istringstream in(stream.str());
+        for (std::string line; std::getline(in, line);) {
+            result.push_back(line);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("AsyncLog: lines are written in order by the drain thread", "[AsyncLog][server]") {
+    std::ostringstream out, err;
+    {
+        AsyncLog log(out, err, { 64, 1ms });
+        for (int i = 0; i < 20; ++i) {
+            log.info() << "tick " << i;
+        }
+        log.warn() << "WARNING: " << 2.5 << " bad";
+    }  // The destructor writes what is still queued
+
+    const std::vector<std::string> info = lines(out);
+    REQUIRE(info.size() == 20);
+    for (int i = 0; i < 20; ++i) {
+        // "[HH:MM:SS.mmm] tick i"
+        REQUIRE(info[i].size() > 15);
+        CHECK(info[i][0] == '[');
+        CHECK(info[i][13] == ']');
+        CHECK(info[i].substr(15) == "tick " + std::to_string(i));
+    }
+    const std::vector<std::string> warnings = lines(err);
+    REQUIRE(warnings.size() == 1);
+    CHECK(warnings[0].substr(15) == "WARNING: 2.5 bad");
+}
+
+TEST_CASE("AsyncLog: a full pool drops lines instead of blocking", "[AsyncLog][server][EdgeCase]") {
+    std::ostringstream out, err;
+    {
+        AsyncLog log(out, err, { 4, std::chrono::hours(1) });   // The drain thread never gets to run
+        for (int i = 0; i < 10; ++i) {
+            log.info() << "line " << i;
+        }
+        CHECK(log.dropped() == 6);
+        log.warn() << std::string(AsyncLog::Record::TEXT_SIZE + 100, 'x');
+        CHECK(log.dropped() == 7);
+    }
+    const std::vector<std::string> info = lines(out);
+    REQUIRE(info.size() == 4);
+    CHECK(info.back().substr(15) == "line 3");
+    CHECK(err.str().empty());
+
+    std::ostringstream longOut, longErr;
+    {
+        AsyncLog log(longOut, longErr, { 4, std::chrono::hours(1) });
+        log.warn() << std::string(AsyncLog::Record::TEXT_SIZE + 100, 'x');
+    }
+    const std::vector<std::string> warnings = lines(longErr);
+    REQUIRE(warnings.size() == 1);
+    CHECK(warnings[0].substr(15) == std::string(AsyncLog::Record::TEXT_SIZE, 'x'));
+}
+
+TEST_CASE("AsyncLog: rate limit", "[AsyncLog][server]") {
+    const auto t0 = std::chrono::steady_clock::time_point(std::chrono::hours(1));
+    LogRateLimit limit(3, 1s);
+    int allowed = 0;
+    for (int i = 0; i < 10; ++i) {
+        allowed += limit.allow(t0 + std::chrono::milliseconds(i)) ? 1 : 0;
+    }
+    CHECK(allowed == 3);
+
+    // The next window lets lines through again, and the first one reports the rest
+    REQUIRE(limit.allow(t0 + 1s));
+    std::ostringstream line;
+    line << "dropped" << Suppressed{ limit.takeSuppressed() };
+    CHECK(line.str() == "dropped (7 more suppressed)");
+    line.str("");
+    line << "dropped" << Suppressed{ limit.takeSuppressed() };
+    CHECK(line.str() == "dropped");
+}
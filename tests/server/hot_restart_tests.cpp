@@ -0,0 +1,357 @@
+/**
+ * @file hot_restart_tests.cpp
+ * @brief Unit tests and benchmarks for room state serialization and the hot restart handoff.
+ *
+ * Coverage:
+ * - RoomRouter save/load round trip keeps rooms, clients, state and queued input,
+ *   and the restored router ticks exactly like the original
+ * - Truncated or mismatched state is rejected and leaves the router empty
+ * - Corrupt room capacities and counts are rejected before anything is allocated
+ * - The default control socket path is in a directory private to the user
+ * - TakeoverWatcher accepts a request on its own thread and hands it out once
+ * - Handoff over a control socket passes a bound UDP socket (with a datagram
+ *   still queued in it) and the state to the taking-over side
+ * - Benchmark: save + handoff + load for 512 rooms x 8 clients (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/hot_restart.hpp"
+#include "netcode/common/room.hpp"
+#include "test_support.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Fills a router with clients that have moved and have input queued.
+     */
+    void populate(RoomRouter& router, size_t clients, Clock::time_point t0) {
+        for (size_t i = 0; i < clients; ++i) {
+            const sockaddr_in addr = makeAddr(0x0A000001, static_cast<uint16_t>(1000 + i));
+            Room* room = router.route(makeClientId(addr), addr, t0);
+            const float dir = (i % 2) ? 1.0f : -1.0f;
+            room->pushInput(makeClientId(addr), 1, dir, -dir, t0 + std::chrono::milliseconds(20 + i % 7));
+        }
+        std::vector<RoomOutput> out;
+        for (const auto& room : router.rooms()) {
+            room->tick(out);
+        }
+        for (size_t i = 0; i < clients; i += 2) {
+            const sockaddr_in addr = makeAddr(0x0A000001, static_cast<uint16_t>(1000 + i));
+            router.find(makeClientId(addr))->pushInput(makeClientId(addr), 2, 0.5f, 0.5f, t0 + std::chrono::milliseconds(40));
+        }
+    }
+
+    /** @brief Ticks every room; with holdUntil set, holds the clients' input up to then first. */
+    std::vector<RoomOutput> tickAll(const RoomRouter& router, std::optional<Clock::time_point> holdUntil = std::nullopt) {
+        std::vector<RoomOutput> out;
+        for (const auto& room : router.rooms()) {
+            if (holdUntil) {
+                room->holdInputs(*holdUntil);
+            }
+            room->tick(out);
+        }
+        return out;
+    }
+
+    std::string controlPath(const char* name) {
+        return "/tmp/netcode-test-" + std::string(name) + "-" + std::to_string(
+#ifndef _WIN32
+            getpid()
+#else
+            0
+#endif
+        ) + ".sock";
+    }
+}
+
+TEST_CASE("HotRestart: router state round trip", "[HotRestart][server]") {
+    const auto t0 = Clock::now();
+    RoomRouter original(8, 16);
+    populate(original, 45, t0);
+
+    std::vector<char> state;
+    original.save(state);
+
+    RoomRouter restored(8, 16);
+    REQUIRE(restored.load(state.data(), state.size()));
+    REQUIRE(restored.clientCount() == original.clientCount());
+    REQUIRE(restored.rooms().size() == original.rooms().size());
+
+    for (size_t r = 0; r < original.rooms().size(); ++r) {
+        const Room& a = *original.rooms()[r];
+        const Room& b = *restored.rooms()[r];
+        REQUIRE(b.id() == a.id());
+        REQUIRE(b.size() == a.size());
+        for (size_t slot = 0; slot < a.size(); ++slot) {
+            REQUIRE(b.clientAt(slot) == a.clientAt(slot));
+            REQUIRE(restored.find(a.clientAt(slot)) == &b);
+            REQUIRE(b.entities().x()[slot] == a.entities().x()[slot]);
+            REQUIRE(b.entities().vy()[slot] == a.entities().vy()[slot]);
+            REQUIRE(b.entities().seq()[slot] == a.entities().seq()[slot]);
+        }
+    }
+
+    // Queued input and timing survive: the next tick is identical
+    const std::vector<RoomOutput> expected = tickAll(original);
+    const std::vector<RoomOutput> actual = tickAll(restored);
+    REQUIRE(actual.size() == expected.size());
+    REQUIRE(actual.size() == 23);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(actual[i].addr.sin_port == expected[i].addr.sin_port);
+        REQUIRE(actual[i].addr.sin_addr.s_addr == expected[i].addr.sin_addr.s_addr);
+        REQUIRE(std::memcmp(&actual[i].packet, &expected[i].packet, sizeof(Packet)) == 0);
+        REQUIRE(actual[i].ack.snapshotSeq == expected[i].ack.snapshotSeq);
+        REQUIRE(actual[i].ack.heldMicros == expected[i].ack.heldMicros);
+    }
+
+    // So does how long each client's input has been held
+    const std::vector<RoomOutput> heldExpected = tickAll(original, t0 + std::chrono::milliseconds(100));
+    const std::vector<RoomOutput> heldActual = tickAll(restored, t0 + std::chrono::milliseconds(100));
+    REQUIRE(heldActual.size() == heldExpected.size());
+    REQUIRE(heldActual.size() == 45);
+    for (size_t i = 0; i < heldExpected.size(); ++i) {
+        REQUIRE(std::memcmp(&heldActual[i].packet, &heldExpected[i].packet, sizeof(Packet)) == 0);
+        REQUIRE(heldActual[i].ack.heldMicros == heldExpected[i].ack.heldMicros);
+        REQUIRE(heldActual[i].ack.heldMicros >= 60000);
+    }
+}
+
+TEST_CASE("HotRestart: invalid state is rejected", "[HotRestart][server][EdgeCase]") {
+    RoomRouter original(4, 8);
+    populate(original, 10, Clock::now());
+    std::vector<char> state;
+    original.save(state);
+
+    RoomRouter restored(4, 8);
+    REQUIRE_FALSE(restored.load(state.data(), state.size() - 1));
+    REQUIRE(restored.clientCount() == 0);
+    REQUIRE(restored.rooms().empty());
+
+    std::vector<char> longer = state;
+    longer.push_back(0);
+    REQUIRE_FALSE(restored.load(longer.data(), longer.size()));
+
+    RoomRouter otherCapacity(8, 8);
+    REQUIRE_FALSE(otherCapacity.load(state.data(), state.size()));
+
+    RoomRouter fewerRooms(4, 1);
+    REQUIRE_FALSE(fewerRooms.load(state.data(), state.size()));
+
+    REQUIRE(restored.load(state.data(), state.size()));
+    REQUIRE(restored.clientCount() == 10);
+}
+
+TEST_CASE("HotRestart: corrupt counts are rejected before allocating", "[HotRestart][server][EdgeCase]") {
+    RoomRouter original(4, 8);
+    populate(original, 10, Clock::now());
+    std::vector<char> state;
+    original.save(state);
+
+    // Router header: version, room capacity, room count; then the first room: id, capacity, client count
+    const size_t roomCapacityAt = sizeof(uint32_t) + 2 * sizeof(uint64_t) + sizeof(uint32_t);
+    const size_t clientCountAt = roomCapacityAt + sizeof(uint64_t);
+    auto corrupted = [&](size_t offset, uint64_t value) {
+        std::vector<char> bytes = state;
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        return bytes;
+    };
+
+    RoomRouter restored(4, 8);
+    const std::vector<char> hugeCapacity = corrupted(roomCapacityAt, uint64_t(1) << 40);
+    REQUIRE_FALSE(restored.load(hugeCapacity.data(), hugeCapacity.size()));
+    const std::vector<char> otherCapacity = corrupted(roomCapacityAt, 8);
+    REQUIRE_FALSE(restored.load(otherCapacity.data(), otherCapacity.size()));
+    const std::vector<char> hugeCount = corrupted(clientCountAt, Room::MAX_LOADED_CAPACITY);
+    REQUIRE_FALSE(restored.load(hugeCount.data(), hugeCount.size()));
+    REQUIRE(restored.rooms().empty());
+}
+
+#ifndef _WIN32
+TEST_CASE("HotRestart: handoff passes the bound socket and the state", "[HotRestart][server]") {
+    const std::string path = controlPath("handoff");
+    const int listener = createControlListener(path);
+    REQUIRE(listener >= 0);
+    REQUIRE(pollControlListener(listener) == -1);  // Nobody waiting
+
+    // The "old server": a bound UDP socket with a datagram still queued in it
+    int udp = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in bound = makeAddr(0x7F000001, 0);
+    REQUIRE(bind(udp, reinterpret_cast<sockaddr*>(&bound), sizeof(bound)) == 0);
+    socklen_t len = sizeof(bound);
+    REQUIRE(getsockname(udp, reinterpret_cast<sockaddr*>(&bound), &len) == 0);
+
+    int sender = socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(sendto(sender, "ping", 4, 0, reinterpret_cast<sockaddr*>(&bound), sizeof(bound)) == 4);
+
+    const std::vector<char> state = { 'w', 'o', 'r', 'l', 'd' };
+    std::atomic<bool> sent{ false };
+    std::atomic<bool> acked{ false };
+    std::thread oldServer([&] {
+        int peer = -1;
+        for (int i = 0; i < 500 && peer < 0; ++i) {
+            peer = pollControlListener(listener);
+            if (peer < 0) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        if (peer < 0) return;
+        HandoffHeader header;
+        header.ticks = 1234;
+        header.nextTick = 987654321;
+        sent = handOff(peer, { udp }, state, header);
+        acked = awaitAck(peer, std::chrono::milliseconds(2000));
+        close(peer);
+    });
+
+    std::vector<int> fds;
+    std::vector<char> received;
+    HandoffHeader header;
+    const int peer = takeOver(path, fds, received, header);
+    const bool tookOver = peer >= 0;
+    if (tookOver) {
+        sendAck(peer);
+    }
+    oldServer.join();
+
+    REQUIRE(tookOver);
+    REQUIRE(sent);
+    REQUIRE(acked);
+    REQUIRE(header.ticks == 1234);
+    REQUIRE(header.nextTick == 987654321);
+    REQUIRE(received == state);
+    REQUIRE(fds.size() == 1);
+
+    // Same socket: same port, and the queued datagram is readable through the new descriptor
+    sockaddr_in passed{};
+    len = sizeof(passed);
+    REQUIRE(getsockname(fds[0], reinterpret_cast<sockaddr*>(&passed), &len) == 0);
+    REQUIRE(passed.sin_port == bound.sin_port);
+    close(udp);
+    char buf[8] = {};
+    REQUIRE(recv(fds[0], buf, sizeof(buf), MSG_DONTWAIT) == 4);
+    REQUIRE(std::string(buf, 4) == "ping");
+
+    close(fds[0]);
+    close(sender);
+    close(listener);
+    unlink(path.c_str());
+}
+
+TEST_CASE("HotRestart: default control socket path is private", "[HotRestart][server]") {
+    const char* previous = std::getenv("XDG_RUNTIME_DIR");
+    const std::string saved = previous ? previous : "";
+
+    char dir[] = "/tmp/netcode-runtime-XXXXXX";
+    REQUIRE(mkdtemp(dir) != nullptr);   // Mode 0700
+    setenv("XDG_RUNTIME_DIR", dir, 1);
+    CHECK(controlSocketPath() == std::string(dir) + "/netcode-server.sock");
+    chmod(dir, 0755);                   // Open to others: refused
+    CHECK(controlSocketPath().empty());
+    rmdir(dir);
+
+    unsetenv("XDG_RUNTIME_DIR");
+    const std::string fallback = controlSocketPath();
+    CHECK(fallback == "/tmp/netcode-server-" + std::to_string(geteuid()) + "/netcode-server.sock");
+    struct stat info;
+    REQUIRE(stat(fallback.substr(0, fallback.rfind('/')).c_str(), &info) == 0);
+    CHECK(info.st_uid == geteuid());
+    CHECK((info.st_mode & 077) == 0);
+
+    if (previous) {
+        setenv("XDG_RUNTIME_DIR", saved.c_str(), 1);
+    }
+}
+
+TEST_CASE("HotRestart: watcher thread accepts takeover requests", "[HotRestart][server]") {
+    const std::string path = controlPath("watcher");
+    const int listener = createControlListener(path);
+    REQUIRE(listener >= 0);
+    TakeoverWatcher watcher(listener);
+    CHECK(watcher.poll() == -1);
+
+    const int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    REQUIRE(connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+
+    int peer = -1;
+    for (int i = 0; i < 200 && peer < 0; ++i) {
+        peer = watcher.poll();
+        if (peer < 0) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(peer >= 0);
+    CHECK(watcher.poll() == -1);   // Handed out once
+
+    // The peer is the connection the client made
+    REQUIRE(send(peer, "K", 1, MSG_NOSIGNAL) == 1);
+    char ack = 0;
+    REQUIRE(recv(client, &ack, 1, 0) == 1);
+    CHECK(ack == 'K');
+
+    watcher.stop();
+    close(peer);
+    close(client);
+    close(listener);
+    unlink(path.c_str());
+}
+
+TEST_CASE("HotRestart: takeover fails without a running server", "[HotRestart][server][EdgeCase]") {
+    std::vector<int> fds;
+    std::vector<char> state;
+    HandoffHeader header;
+    REQUIRE(takeOver(controlPath("missing"), fds, state, header) == -1);
+    REQUIRE(fds.empty());
+}
+
+TEST_CASE("HotRestart: handoff of 512 rooms x 8 clients", "[.][Benchmark][HotRestart]") {
+    const auto t0 = Clock::now();
+    RoomRouter router(8, 512);
+    populate(router, 4096, t0);
+    const std::string path = controlPath("bench");
+    const int listener = createControlListener(path);
+    int udp = socket(AF_INET, SOCK_DGRAM, 0);
+
+    BENCHMARK("save + handoff + load (4096 clients)") {
+        std::thread oldServer([&] {
+            int peer = -1;
+            while ((peer = pollControlListener(listener)) < 0) std::this_thread::yield();
+            std::vector<char> state;
+            router.save(state);
+            handOff(peer, { udp }, state, HandoffHeader{});
+            awaitAck(peer, std::chrono::milliseconds(2000));
+            close(peer);
+        });
+        std::vector<int> fds;
+        std::vector<char> state;
+        HandoffHeader header;
+        const int peer = takeOver(path, fds, state, header);
+        RoomRouter restored(8, 512);
+        const bool ok = restored.load(state.data(), state.size());
+        sendAck(peer);
+        oldServer.join();
+        for (int fd : fds) close(fd);
+        return ok;
+    };
+
+    close(udp);
+    close(listener);
+    unlink(path.c_str());
+}
+#endif
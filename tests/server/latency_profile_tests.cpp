@@ -0,0 +1,255 @@
+/**
+ * @file latency_profile_tests.cpp
+ * @brief Unit tests and benchmark for the low-latency server profile.
+ *
+ * Coverage:
+ * - Core lists parse like Linux cpulists; malformed lists are rejected
+ * - Core plans put the server first and spread workers over the other cores
+ * - The calling thread can be pinned to the core it runs on (Linux)
+ * - applySocketProfile() enlarges the socket buffers and sets the DSCP mark
+ * - JitterStats percentiles, maximum and reset; a windowed one keeps only the newest samples
+ * - LatencyHistogram buckets and bucket-resolved percentiles
+ * - Benchmark: tick jitter of a 1 kHz receive loop with and without the profile (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/latency_profile.hpp"
+#include "netcode/common/transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+using namespace std::chrono_literals;
+
+TEST_CASE("LatencyProfile: core lists", "[LatencyProfile]") {
+    CHECK(parseCoreList("3") == std::vector<int>{ 3 });
+    CHECK(parseCoreList("0-3,8,10-11") == std::vector<int>{ 0, 1, 2, 3, 8, 10, 11 });
+    CHECK(parseCoreList("0-1\n") == std::vector<int>{ 0, 1 });
+    CHECK(parseCoreList("").empty());
+    CHECK(parseCoreList("a").empty());
+    CHECK(parseCoreList("3-1").empty());
+    CHECK(parseCoreList("1-").empty());
+    CHECK(parseCoreList("1,2x").empty());
+    CHECK(parseCoreList("-2").empty());
+}
+
+TEST_CASE("LatencyProfile: core plans", "[LatencyProfile]") {
+    LatencyProfile profile;
+
+    SECTION("Explicit cores: server first, workers round robin over the rest") {
+        profile.cores = { 4, 5, 6 };
+        const CorePlan plan = planCores(profile, 3);
+        CHECK(plan.server == 4);
+        CHECK(plan.workers == std::vector<int>{ 5, 6, 5 });
+        CHECK(planCores(profile, 0).workers == std::vector<int>{ 5, 6 });
+    }
+
+    SECTION("A single core is shared") {
+        profile.cores = { 2 };
+        const CorePlan plan = planCores(profile, 0);
+        CHECK(plan.server == 2);
+        CHECK(plan.workers == std::vector<int>{ 2 });
+    }
+
+    SECTION("Without cores the plan starts on the calling thread's core") {
+        const CorePlan plan = planCores(profile, 2);
+        CHECK(plan.workers.size() == 2);
+#ifdef __linux__
+        CHECK(plan.server == currentCore());
+        CHECK(numaNodeOfCore(plan.server) >= 0);
+        CHECK_FALSE(coresOfNode(numaNodeOfCore(plan.server)).empty());
+#endif
+    }
+}
+
+#ifdef __linux__
+TEST_CASE("LatencyProfile: pinning the calling thread", "[LatencyProfile]") {
+    std::thread([] {
+        const int core = currentCore();
+        REQUIRE(core >= 0);
+        CHECK(pinCurrentThread(core));
+        CHECK(currentCore() == core);
+        CHECK_FALSE(pinCurrentThread(-1));
+    }).join();
+}
+#endif
+
+#ifndef _WIN32
+TEST_CASE("LatencyProfile: socket profile", "[LatencyProfile]") {
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(sock >= 0);
+    int before = 0;
+    socklen_t size = sizeof(before);
+    getsockopt(sock, SOL_SOCKET, SO_RCVBUF, &before, &size);
+
+    LatencyProfile profile;
+    profile.receiveBufferBytes = 1 << 20;
+    profile.sendBufferBytes = 1 << 20;
+    const SocketProfileResult result = applySocketProfile(sock, profile);
+
+    // Capped by the system maximum without CAP_NET_ADMIN, but never smaller than before
+    CHECK(result.receiveBufferBytes >= before);
+    CHECK(result.sendBufferBytes > 0);
+    REQUIRE(result.dscp);
+    int tos = 0;
+    size = sizeof(tos);
+    getsockopt(sock, IPPROTO_IP, IP_TOS, &tos, &size);
+    CHECK(tos == 46 << 2);
+
+    // Unmarked and untouched when switched off
+    const int other = socket(AF_INET, SOCK_DGRAM, 0);
+    LatencyProfile off;
+    off.busyPollMicros = 0;
+    off.receiveBufferBytes = 0;
+    off.sendBufferBytes = 0;
+    off.dscp = -1;
+    const SocketProfileResult untouched = applySocketProfile(other, off);
+    CHECK_FALSE(untouched.busyPoll);
+    CHECK_FALSE(untouched.dscp);
+    CHECK(untouched.receiveBufferBytes == before);
+    close(other);
+    close(sock);
+}
+#endif
+
+TEST_CASE("LatencyProfile: jitter statistics", "[LatencyProfile]") {
+    JitterStats jitter;
+    CHECK(jitter.count() == 0);
+    CHECK(jitter.percentile(0.99) == 0ns);
+
+    for (int i = 100; i >= 1; --i) {
+        jitter.record(std::chrono::microseconds(i));
+    }
+    CHECK(jitter.count() == 100);
+    CHECK(jitter.percentile(0.0) == 1us);
+    CHECK(jitter.percentile(0.5) == std::chrono::microseconds(51));
+    CHECK(jitter.percentile(0.99) == 99us);
+    CHECK(jitter.percentile(1.0) == 100us);
+    CHECK(jitter.max() == 100us);
+    CHECK(jitter.summary() == "p50 51.0 us, p99 99.0 us, max 100.0 us over 100 ticks");
+
+    jitter.record(2ms);
+    CHECK(jitter.percentile(1.0) == 2ms);
+
+    jitter.reset();
+    CHECK(jitter.count() == 0);
+    CHECK(jitter.max() == 0ns);
+}
+
+TEST_CASE("LatencyProfile: windowed jitter statistics", "[LatencyProfile]") {
+    JitterStats recent(10);
+    recent.record(5ms);
+    for (int i = 1; i <= 25; ++i) {
+        recent.record(std::chrono::microseconds(i));
+    }
+    CHECK(recent.count() == 10);
+    CHECK(recent.percentile(0.0) == 16us);                          // Only the last ten samples
+    CHECK(recent.percentile(1.0) == 25us);
+    CHECK(recent.max() == 5ms);                                     // But the maximum of them all
+    CHECK(recent.histogram({ 20us }) == std::vector<size_t>{ 4, 6 });
+
+    recent.reset();
+    for (int i = 1; i <= 3; ++i) {
+        recent.record(std::chrono::microseconds(i));
+    }
+    CHECK(recent.count() == 3);
+    CHECK(recent.percentile(1.0) == 3us);
+}
+
+TEST_CASE("LatencyProfile: fixed-bucket latency histogram", "[LatencyProfile]") {
+    std::vector<std::chrono::nanoseconds> bounds;
+    for (int us = 10; us <= 90; us += 10) {
+        bounds.push_back(std::chrono::microseconds(us));
+    }
+    LatencyHistogram histogram(bounds);
+    CHECK(histogram.percentile(0.5) == 0ns);
+
+    for (int i = 100; i >= 1; --i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    REQUIRE(histogram.counts().size() == 10);
+    CHECK(histogram.counts().front() == 9);     // 1..9 us
+    CHECK(histogram.counts()[5] == 10);         // 50..59 us
+    CHECK(histogram.counts().back() == 11);     // 90..100 us
+    CHECK(histogram.count() == 100);
+
+    // Same ranks as JitterStats, resolved to the bucket's upper bound (or the maximum)
+    CHECK(histogram.percentile(0.0) == 10us);
+    CHECK(histogram.percentile(0.5) == 60us);
+    CHECK(histogram.percentile(0.99) == 100us);
+    CHECK(histogram.max() == 100us);
+
+    histogram.reset();
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.counts().front() == 0);
+    histogram.record(3us);
+    CHECK(histogram.percentile(0.5) == 3us);   // Never above the largest sample
+}
+
+#ifndef _WIN32
+TEST_CASE("LatencyProfile: tick jitter of a 1 kHz receive loop", "[.][Benchmark][LatencyProfile]") {
+    constexpr auto TICK = 1ms;
+    constexpr int TICKS = 3000;
+
+    for (const bool profiled : { false, true }) {
+        const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &len);
+
+        JitterStats jitter;
+        std::thread loop([&] {
+            if (profiled) {
+                LatencyProfile profile;
+                pinCurrentThread(planCores(profile, 0).server);
+                applySocketProfile(sock, profile);
+            }
+            SocketTransport transport(sock);
+            std::vector<ReceivedDatagram> batch;
+            auto next = std::chrono::steady_clock::now() + TICK;
+            while (jitter.count() < TICKS) {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= next) {
+                    jitter.record(now - next);
+                    next += TICK;
+                    continue;
+                }
+                transport.receive(batch, std::chrono::duration_cast<std::chrono::microseconds>(next - now));
+            }
+        });
+
+        // Client input arriving between ticks, as in the server
+        std::atomic<bool> done{ false };
+        std::thread client([&] {
+            const int out = socket(AF_INET, SOCK_DGRAM, 0);
+            char payload[24] = {};
+            while (!done) {
+                sendto(out, payload, sizeof(payload), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                std::this_thread::sleep_for(300us);
+            }
+            close(out);
+        });
+        loop.join();
+        done = true;
+        client.join();
+        close(sock);
+
+        std::printf("%s: tick jitter %s\n", profiled ? "low-latency profile" : "default", jitter.summary().c_str());
+    }
+}
+#endif
@@ -0,0 +1,246 @@
+/**
+ * @file load_governor_tests.cpp
+ * @brief Unit tests and benchmark for overload shedding.
+ *
+ * Coverage:
+ * - Governor escalates one level per run of over-budget windows and recovers one level
+ *   per longer run of calm windows; windows in between hold the level
+ * - Per-datagram time counts against its own budget; every transition reaches the listener
+ * - Levels map to cumulative LoadShedding settings
+ * - Room answers idle clients every Nth tick while moving clients get every snapshot
+ * - Room coalesces a client's queued inputs into one step with the newest input
+ * - Router refuses new clients (but keeps known ones) while admitNewClients is off
+ * - Benchmark: tick time and snapshots of a busy room at each level (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/load_governor.hpp"
+#include "test_support.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    LoadBudget testBudget() {
+        LoadBudget budget;
+        budget.perTick = 1ms;
+        budget.perPacket = 10us;
+        budget.escalateAfter = 2;
+        budget.recoverAfter = 5;
+        return budget;
+    }
+}
+
+TEST_CASE("LoadGovernor: escalates under load and recovers with hysteresis", "[LoadGovernor][server]") {
+    std::vector<LoadTransition> seen;
+    LoadGovernor governor(testBudget(), [&seen](const LoadTransition& t) { seen.push_back(t); });
+    CHECK(governor.level() == LoadLevel::Normal);
+
+    governor.endWindow(2ms);   // One over-budget window is not enough
+    CHECK(governor.level() == LoadLevel::Normal);
+    governor.endWindow(800us); // Between the thresholds: resets the run
+    governor.endWindow(2ms);
+    CHECK(governor.level() == LoadLevel::Normal);
+    CHECK(governor.endWindow(2ms) == LoadLevel::ReduceIdle);
+    REQUIRE(seen.size() == 1);
+    CHECK(seen[0].from == LoadLevel::Normal);
+    CHECK(seen[0].to == LoadLevel::ReduceIdle);
+    CHECK(seen[0].load == Catch::Approx(2.0));
+    CHECK(seen[0].tickTime == 2ms);
+    CHECK(seen[0].shedding.idleResponseInterval == 4);
+
+    for (int i = 0; i < 10; ++i) {
+        governor.endWindow(3ms);
+    }
+    CHECK(governor.level() == LoadLevel::ShedConnections);   // Top level, no further transitions
+    CHECK(governor.transitions() == 3);
+    CHECK_FALSE(governor.shedding().admitNewClients);
+
+    for (int i = 0; i < 4; ++i) {
+        governor.endWindow(100us);
+    }
+    CHECK(governor.level() == LoadLevel::ShedConnections);
+    governor.endWindow(100us);   // Fifth calm window in a row
+    CHECK(governor.level() == LoadLevel::CoalesceInputs);
+    for (int i = 0; i < 15; ++i) {
+        governor.endWindow(100us);
+    }
+    CHECK(governor.level() == LoadLevel::Normal);
+    CHECK(governor.transitions() == 6);
+    CHECK(seen.back().to == LoadLevel::Normal);
+    CHECK(governor.shedding() == LoadShedding());
+
+    CHECK(governor.windowsAt(LoadLevel::Normal) == 4 + 5);
+    CHECK(governor.windowsAt(LoadLevel::ShedConnections) == 6 + 5);
+    const std::string report = governor.report();
+    INFO(report);
+    CHECK(report.find("(normal), 6 transitions") != std::string::npos);
+}
+
+TEST_CASE("LoadGovernor: time per datagram has its own budget", "[LoadGovernor][server]") {
+    LoadGovernor governor(testBudget());
+    for (int window = 0; window < 2; ++window) {
+        governor.recordPacket(5us);
+        governor.recordPacket(35us);   // Mean 20 us: twice the budget, tick well within its own
+        governor.endWindow(100us);
+    }
+    CHECK(governor.load() == Catch::Approx(2.0));
+    CHECK(governor.level() == LoadLevel::ReduceIdle);
+
+    governor.endWindow(100us);   // No datagrams: only the tick counts, and the mean starts over
+    CHECK(governor.load() == Catch::Approx(0.1));
+}
+
+TEST_CASE("LoadGovernor: levels shed cumulatively", "[LoadGovernor][server]") {
+    const LoadBudget budget = testBudget();
+    CHECK(LoadGovernor::sheddingFor(LoadLevel::Normal, budget) == LoadShedding());
+
+    const LoadShedding idle = LoadGovernor::sheddingFor(LoadLevel::ReduceIdle, budget);
+    CHECK(idle.idleResponseInterval == budget.idleResponseInterval);
+    CHECK_FALSE(idle.coalesceInputs);
+    CHECK(idle.admitNewClients);
+
+    const LoadShedding coalesce = LoadGovernor::sheddingFor(LoadLevel::CoalesceInputs, budget);
+    CHECK(coalesce.idleResponseInterval == budget.idleResponseInterval);
+    CHECK(coalesce.coalesceInputs);
+    CHECK(coalesce.admitNewClients);
+
+    const LoadShedding shed = LoadGovernor::sheddingFor(LoadLevel::ShedConnections, budget);
+    CHECK(shed.coalesceInputs);
+    CHECK_FALSE(shed.admitNewClients);
+    CHECK(std::string(loadLevelName(LoadLevel::ShedConnections)) == "shed-connections");
+}
+
+TEST_CASE("Room: load shedding answers idle clients less often", "[LoadGovernor][Room][server]") {
+    Room room(0, 4);
+    const auto t0 = Clock::now();
+    const sockaddr_in idleAddr = makeAddr(0x7F000001, 4000);
+    const sockaddr_in movingAddr = makeAddr(0x7F000001, 4001);
+    const ClientId idle = makeClientId(idleAddr);
+    const ClientId moving = makeClientId(movingAddr);
+    REQUIRE(room.join(idle, idleAddr, t0));
+    REQUIRE(room.join(moving, movingAddr, t0));
+
+    LoadShedding shedding;
+    shedding.idleResponseInterval = 3;
+    room.setShedding(shedding);
+
+    size_t idleSnapshots = 0;
+    size_t movingSnapshots = 0;
+    for (uint32_t seq = 1; seq <= 9; ++seq) {
+        const auto at = t0 + seq * 10ms;
+        room.pushInput(idle, seq, 0.0f, 0.0f, at);
+        room.pushInput(moving, seq, 1.0f, 0.0f, at);
+        std::vector<RoomOutput> out;
+        room.tick(out);
+        for (const auto& output : out) {
+            (output.addr.sin_port == idleAddr.sin_port ? idleSnapshots : movingSnapshots)++;
+        }
+    }
+    CHECK(movingSnapshots == 9);
+    CHECK(idleSnapshots == 3);   // Ticks 1, 4 and 7
+    CHECK(room.suppressedSnapshots() == 6);
+
+    // A client that stops is told at once, then answered like any idle client
+    std::vector<RoomOutput> out;
+    room.pushInput(moving, 10, 0.0f, 0.0f, t0 + 100ms);
+    room.tick(out);
+    REQUIRE(out.size() == 1);
+    CHECK(out[0].packet.seq == 10);
+    CHECK(out[0].packet.vx == 0.0f);
+    out.clear();
+    room.pushInput(moving, 11, 0.0f, 0.0f, t0 + 110ms);
+    room.tick(out);
+    CHECK(out.empty());
+}
+
+TEST_CASE("Room: load shedding coalesces queued inputs", "[LoadGovernor][Room][server]") {
+    Room room(0, 4);
+    const auto t0 = Clock::now();
+    const sockaddr_in addr = makeAddr(0x7F000001, 4000);
+    const ClientId id = makeClientId(addr);
+    REQUIRE(room.join(id, addr, t0));
+
+    LoadShedding shedding;
+    shedding.coalesceInputs = true;
+    room.setShedding(shedding);
+
+    room.pushInput(id, 1, -1.0f, 0.0f, t0 + 10ms);
+    room.pushInput(id, 2, -1.0f, 0.0f, t0 + 20ms);
+    room.pushInput(id, 3, 1.0f, 0.0f, t0 + 40ms);
+    std::vector<RoomOutput> out;
+    CHECK(room.tick(out) == 1);
+    REQUIRE(out.size() == 1);
+    CHECK(out[0].packet.seq == 3);
+    CHECK(out[0].packet.x == Catch::Approx(200.0f + Room::MOVE_SPEED * 0.04f));   // Newest input over all 40 ms
+    CHECK(room.coalescedInputs() == 2);
+}
+
+TEST_CASE("RoomRouter: load shedding refuses new clients only", "[LoadGovernor][Room][server]") {
+    RoomRouter router(4, 4);
+    const auto t0 = Clock::now();
+    const sockaddr_in known = makeAddr(0x0A000001, 1);
+    Room* room = router.route(makeClientId(known), known, t0);
+    REQUIRE(room != nullptr);
+
+    LoadShedding shedding;
+    shedding.admitNewClients = false;
+    shedding.idleResponseInterval = 2;
+    router.setShedding(shedding);
+    CHECK(room->shedding() == shedding);
+
+    const sockaddr_in late = makeAddr(0x0A000002, 1);
+    CHECK(router.route(makeClientId(known), known, t0) == room);
+    CHECK(router.route(makeClientId(late), late, t0) == nullptr);
+    CHECK(router.route(makeClientId(late), late, t0) == nullptr);
+    CHECK(router.refusedClients() == 2);
+    CHECK(router.clientCount() == 1);
+
+    router.setShedding(LoadShedding());
+    CHECK(router.route(makeClientId(late), late, t0) == room);
+    CHECK(room->shedding() == LoadShedding());
+}
+
+TEST_CASE("LoadGovernor: tick cost of a busy room at each level", "[.][Benchmark][LoadGovernor]") {
+    // 256 clients, half of them idle, each sending 4 inputs per tick (a client catching up)
+    constexpr uint16_t CLIENTS = 256;
+    constexpr int TICKS = 500;
+    const LoadBudget budget;
+    for (size_t level = 0; level < LOAD_LEVELS - 1; ++level) {
+        Room room(0, CLIENTS);
+        const auto t0 = Clock::now();
+        for (uint16_t port = 0; port < CLIENTS; ++port) {
+            const sockaddr_in addr = makeAddr(0x0A000001, port);
+            room.join(makeClientId(addr), addr, t0);
+        }
+        room.setShedding(LoadGovernor::sheddingFor(static_cast<LoadLevel>(level), budget));
+
+        std::vector<RoomOutput> out;
+        size_t snapshots = 0;
+        Clock::duration total{ 0 };
+        uint32_t seq = 0;
+        for (int tick = 0; tick < TICKS; ++tick) {
+            for (int burst = 0; burst < 4; ++burst) {
+                ++seq;
+                for (uint16_t port = 0; port < CLIENTS; ++port) {
+                    const float input = port % 2 ? 1.0f : 0.0f;
+                    room.pushInput(makeClientId(makeAddr(0x0A000001, port)), seq, input, 0.0f, t0 + seq * 4ms);
+                }
+            }
+            out.clear();
+            const auto start = Clock::now();
+            room.tick(out);
+            total += Clock::now() - start;
+            snapshots += out.size();
+        }
+        std::printf("%-16s %7.1f us per tick, %5.1f snapshots per tick\n", loadLevelName(static_cast<LoadLevel>(level)),
+            std::chrono::duration<double, std::micro>(total).count() / TICKS, double(snapshots) / TICKS);
+    }
+}
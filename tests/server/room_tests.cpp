@@ -0,0 +1,471 @@
+/**
+ * @file room_tests.cpp
+ * @brief Unit tests for rooms, client routing and the room worker pool.
+ *
+ * Coverage:
+ * - Room simulation matches the server movement rules (dt per input, clamping, bounds)
+ * - Stale input is not applied but still answered; one snapshot per client per tick
+ * - Clients with different numbers of inputs in one tick each advance correctly
+ * - Collisions (off by default) push overlapping players apart before snapshots are built;
+ *   the router applies the setting to every room
+ * - Dead reckoning: snapshots only when the client's extrapolation drifts past the threshold
+ *   or the heartbeat is due; the client's view never drifts further than the threshold;
+ *   skipped snapshots leave no gap in the snapshot sequence
+ * - Held input: between packets a moving client keeps its last input and gets snapshots;
+ *   a client that sent input or is standing still is not held; snapshots say how long
+ *   the input has been held, from zero again at each new packet
+ * - Join/leave/eviction keep the dense client list and queued input consistent
+ * - Router fills rooms to capacity, opens new ones and respects the room limit
+ * - Scheduler runs every room exactly once per tick, prefers home workers and
+ *   steals when one worker's rooms are slow
+ * - Benchmark: snapshots sent with dead reckoning at several thresholds (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/prediction.hpp"
+#include "netcode/common/room.hpp"
+#include "netcode/common/room_scheduler.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Result of driving one client through a room in dead-reckoning mode. */
+    struct DeadReckoningRun {
+        size_t snapshots = 0;
+        float worstError = 0.0f;   // Largest distance between the client's extrapolation and the server
+        size_t sequenceGaps = 0;   // Snapshots whose SnapshotAck::snapshotSeq did not follow the previous one
+    };
+
+    /**
+     * @brief One client sends input at 60 Hz for ticks ticks, walking a 100-unit square (a
+     *        turn every 50 ticks) and standing still for the last second; the client
+     *        extrapolates every snapshot it gets with predictPosition(), as the demo client does.
+     */
+    DeadReckoningRun runDeadReckoning(const DeadReckoning& mode, int ticks) {
+        Room room(0, 1);
+        const auto t0 = Clock::now();
+        const sockaddr_in addr = makeAddr(0x7F000001, 4000);
+        const ClientId id = makeClientId(addr);
+        room.join(id, addr, t0);
+        room.setDeadReckoning(mode);
+
+        DeadReckoningRun run;
+        Packet received;
+        auto receivedAt = t0;
+        std::vector<RoomOutput> out;
+        for (int tick = 1; tick <= ticks; ++tick) {
+            const auto at = t0 + tick * std::chrono::microseconds(16667);
+            static const float DIRECTIONS[4][2] = { { -1.0f, 0.0f }, { 0.0f, -1.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f } };
+            const float* direction = DIRECTIONS[(tick - 1) / 50 % 4];
+            const bool paused = tick > ticks - 60;
+            room.pushInput(id, tick, paused ? 0.0f : direction[0], paused ? 0.0f : direction[1], at);
+            out.clear();
+            room.tick(out);
+            if (!out.empty()) {
+                received = out[0].packet;
+                receivedAt = at;
+                ++run.snapshots;
+                run.sequenceGaps += out[0].ack.snapshotSeq != run.snapshots ? 1 : 0;
+            }
+            const auto [px, py] = predictPosition(received, std::chrono::duration<float>(at - receivedAt).count());
+            const size_t slot = room.slotOf(id);
+            run.worstError = std::max(run.worstError,
+                std::hypot(px - room.entities().x()[slot], py - room.entities().y()[slot]));
+        }
+        return run;
+    }
+}
+
+TEST_CASE("Room: client ids distinguish address and port", "[Room][server]") {
+    ClientId a = makeClientId(makeAddr(0x7F000001, 5000));
+    ClientId b = makeClientId(makeAddr(0x7F000001, 5001));
+    ClientId c = makeClientId(makeAddr(0x7F000002, 5000));
+    REQUIRE(a != b);
+    REQUIRE(a != c);
+    REQUIRE(a == ((ClientId(0x7F000001) << 16) | 5000));
+}
+
+TEST_CASE("Room: tick applies input with the server movement rules", "[Room][server]") {
+    Room room(0, 4);
+    const auto t0 = Clock::now();
+    const sockaddr_in addr = makeAddr(0x7F000001, 4000);
+    const ClientId id = makeClientId(addr);
+    REQUIRE(room.join(id, addr, t0));
+
+    SECTION("Movement uses the time since the previous input") {
+        room.pushInput(id, 1, 1.0f, 0.0f, t0 + std::chrono::milliseconds(50));
+        std::vector<RoomOutput> out;
+        REQUIRE(room.tick(out) == 1);
+        REQUIRE(out.size() == 1);
+        REQUIRE(out[0].packet.seq == 1);
+        REQUIRE(out[0].packet.x == Catch::Approx(200.0f + 120.0f * 0.05f));
+        REQUIRE(out[0].packet.vx == Catch::Approx(120.0f));
+        REQUIRE(out[0].addr.sin_port == addr.sin_port);
+    }
+
+    SECTION("Input and dt are clamped, position stays in bounds") {
+        room.pushInput(id, 1, 5.0f, -5.0f, t0 + std::chrono::seconds(5));
+        std::vector<RoomOutput> out;
+        room.tick(out);
+        REQUIRE(out[0].packet.vx == Catch::Approx(Room::MOVE_SPEED));
+        REQUIRE(out[0].packet.x == Catch::Approx(200.0f + Room::MOVE_SPEED * Room::MAX_STEP));
+
+        for (uint32_t seq = 2; seq < 200; ++seq) {
+            room.pushInput(id, seq, 1.0f, 1.0f, t0 + std::chrono::seconds(5) + std::chrono::milliseconds(100 * seq));
+        }
+        out.clear();
+        room.tick(out);
+        REQUIRE(out[0].packet.x == Room::BOUNDS_MAX);
+        REQUIRE(out[0].packet.y == Room::BOUNDS_MAX);
+    }
+
+    SECTION("Several inputs in one tick produce one snapshot with the newest seq") {
+        room.pushInput(id, 1, 1.0f, 0.0f, t0 + std::chrono::milliseconds(10));
+        room.pushInput(id, 3, 1.0f, 0.0f, t0 + std::chrono::milliseconds(20));
+        room.pushInput(id, 2, -1.0f, 0.0f, t0 + std::chrono::milliseconds(30));  // Reordered, ignored
+        std::vector<RoomOutput> out;
+        REQUIRE(room.tick(out) == 2);
+        REQUIRE(out.size() == 1);
+        REQUIRE(out[0].packet.seq == 3);
+        REQUIRE(out[0].packet.x == Catch::Approx(200.0f + 120.0f * 0.02f));
+    }
+
+    SECTION("Stale input is answered without moving the client") {
+        room.pushInput(id, 5, 1.0f, 0.0f, t0 + std::chrono::milliseconds(10));
+        std::vector<RoomOutput> out;
+        room.tick(out);
+        const float x = out[0].packet.x;
+
+        out.clear();
+        room.pushInput(id, 4, 1.0f, 0.0f, t0 + std::chrono::milliseconds(90));
+        REQUIRE(room.tick(out) == 0);
+        REQUIRE(out.size() == 1);
+        REQUIRE(out[0].packet.seq == 5);
+        REQUIRE(out[0].packet.x == x);
+    }
+
+    SECTION("Clients without input get no snapshot") {
+        std::vector<RoomOutput> out;
+        REQUIRE(room.tick(out) == 0);
+        REQUIRE(out.empty());
+    }
+}
+
+TEST_CASE("Room: uneven input bursts match stepping one input at a time", "[Room][server]") {
+    // Client i sends i inputs this tick, so the kernel passes cover shrinking subsets of the room
+    Room room(0, 16);
+    const auto t0 = Clock::now();
+    std::vector<ClientId> ids;
+    for (uint16_t i = 0; i < 16; ++i) {
+        const sockaddr_in addr = makeAddr(0x0A000001, static_cast<uint16_t>(3000 + i));
+        ids.push_back(makeClientId(addr));
+        REQUIRE(room.join(ids.back(), addr, t0));
+    }
+
+    std::vector<float> expectedX(16, Room::SPAWN_X);
+    std::vector<float> expectedY(16, Room::SPAWN_Y);
+    size_t expectedApplied = 0;
+    for (size_t i = 0; i < 16; ++i) {
+        for (size_t k = 1; k <= i; ++k) {
+            const float inputX = (k % 3 == 0) ? -1.0f : 0.7f;
+            const float inputY = (i % 2) ? 1.0f : -0.3f;
+            room.pushInput(ids[i], static_cast<uint32_t>(k), inputX, inputY, t0 + std::chrono::milliseconds(40 * k));
+
+            const float dt = std::min(std::chrono::duration<float>(std::chrono::milliseconds(40)).count(), Room::MAX_STEP);
+            expectedX[i] = std::clamp(expectedX[i] + inputX * Room::MOVE_SPEED * dt, Room::BOUNDS_MIN, Room::BOUNDS_MAX);
+            expectedY[i] = std::clamp(expectedY[i] + inputY * Room::MOVE_SPEED * dt, Room::BOUNDS_MIN, Room::BOUNDS_MAX);
+            ++expectedApplied;
+        }
+    }
+
+    std::vector<RoomOutput> out;
+    REQUIRE(room.tick(out) == expectedApplied);
+    REQUIRE(out.size() == 15);
+    for (size_t i = 0; i < 16; ++i) {
+        const size_t slot = room.slotOf(ids[i]);
+        INFO("client " << i);
+        REQUIRE(room.entities().seq()[slot] == i);
+        REQUIRE(room.entities().x()[slot] == Catch::Approx(expectedX[i]));
+        REQUIRE(room.entities().y()[slot] == Catch::Approx(expectedY[i]));
+    }
+}
+
+TEST_CASE("Room: membership keeps clients and queued input consistent", "[Room][server]") {
+    Room room(3, 2);
+    const auto t0 = Clock::now();
+    const sockaddr_in a = makeAddr(1, 1), b = makeAddr(2, 2), c = makeAddr(3, 3);
+
+    REQUIRE(room.join(makeClientId(a), a, t0));
+    REQUIRE(room.join(makeClientId(b), b, t0));
+    REQUIRE(room.join(makeClientId(a), a, t0));  // Rejoin is a no-op
+    REQUIRE(room.full());
+    REQUIRE_FALSE(room.join(makeClientId(c), c, t0));
+
+    // b's input must survive a moving into b's slot
+    room.pushInput(makeClientId(a), 1, 1.0f, 0.0f, t0 + std::chrono::milliseconds(10));
+    room.pushInput(makeClientId(b), 1, 0.0f, 1.0f, t0 + std::chrono::milliseconds(10));
+    REQUIRE(room.leave(makeClientId(a)));
+    REQUIRE_FALSE(room.leave(makeClientId(a)));
+    REQUIRE(room.size() == 1);
+
+    std::vector<RoomOutput> out;
+    REQUIRE(room.tick(out) == 1);
+    REQUIRE(out.size() == 1);
+    REQUIRE(out[0].addr.sin_port == b.sin_port);
+    REQUIRE(out[0].packet.vy == Catch::Approx(120.0f));
+
+    SECTION("Input from non-members is ignored") {
+        room.pushInput(makeClientId(c), 9, 1.0f, 1.0f, t0);
+        out.clear();
+        REQUIRE(room.tick(out) == 0);
+        REQUIRE(out.empty());
+    }
+
+    SECTION("Idle clients are evicted") {
+        auto evicted = room.evictIdle(t0 + std::chrono::milliseconds(5));
+        REQUIRE(evicted.empty());
+        evicted = room.evictIdle(t0 + std::chrono::seconds(1));
+        REQUIRE(evicted.size() == 1);
+        REQUIRE(room.empty());
+    }
+}
+
+TEST_CASE("Room: collisions push players apart", "[Room][server]") {
+    Room room(0, 4);
+    const auto t0 = Clock::now();
+    const sockaddr_in a = makeAddr(1, 1), b = makeAddr(2, 2);
+    REQUIRE(room.join(makeClientId(a), a, t0));   // Both spawn on the same point
+    REQUIRE(room.join(makeClientId(b), b, t0));
+
+    SECTION("Off by default: players pass through each other") {
+        room.pushInput(makeClientId(a), 1, 0.0f, 0.0f, t0 + std::chrono::milliseconds(50));
+        room.pushInput(makeClientId(b), 1, 0.0f, 0.0f, t0 + std::chrono::milliseconds(50));
+        std::vector<RoomOutput> out;
+        room.tick(out);
+        REQUIRE(out.size() == 2);
+        CHECK(out[0].packet.x == out[1].packet.x);
+        CHECK(room.contacts() == 0);
+    }
+
+    SECTION("On: snapshots carry the separated positions") {
+        room.setCollisions(true);
+        room.pushInput(makeClientId(a), 1, 1.0f, 0.0f, t0 + std::chrono::milliseconds(50));   // a moves 6 right
+        room.pushInput(makeClientId(b), 1, 0.0f, 0.0f, t0 + std::chrono::milliseconds(50));
+        std::vector<RoomOutput> out;
+        room.tick(out);
+        REQUIRE(out.size() == 2);
+        const Packet& pa = out[0].addr.sin_port == a.sin_port ? out[0].packet : out[1].packet;
+        const Packet& pb = out[0].addr.sin_port == a.sin_port ? out[1].packet : out[0].packet;
+        CHECK(pa.x == Catch::Approx(Room::SPAWN_X + 3.0f + Room::PLAYER_RADIUS));
+        CHECK(pb.x == Catch::Approx(Room::SPAWN_X + 3.0f - Room::PLAYER_RADIUS));
+        CHECK(pa.vx == Catch::Approx(Room::MOVE_SPEED));   // Velocity is still the input's
+        CHECK(room.contacts() == 1);
+
+        // A player without input this tick is still pushed; it learns its position with its next snapshot
+        room.pushInput(makeClientId(a), 2, -1.0f, 0.0f, t0 + std::chrono::milliseconds(100));
+        out.clear();
+        room.tick(out);
+        REQUIRE(out.size() == 1);
+        CHECK(out[0].packet.x == room.entities().x()[0]);   // a joined first: slot 0
+        CHECK(std::abs(room.entities().x()[0] - room.entities().x()[1]) >= 2.0f * Room::PLAYER_RADIUS - 1e-3f);
+    }
+
+    SECTION("The router applies the setting to existing and new rooms") {
+        RoomRouter router(1, 4);
+        Room* first = router.route(makeClientId(a), a, t0);
+        router.setCollisions(true);
+        Room* second = router.route(makeClientId(b), b, t0);
+        REQUIRE(second != first);
+        CHECK(first->collisions());
+        CHECK(second->collisions());
+    }
+}
+
+TEST_CASE("Room: dead reckoning sends snapshots only when extrapolation drifts", "[Room][server]") {
+    DeadReckoning mode;
+    mode.enabled = true;
+    mode.threshold = 2.0f;
+    constexpr int TICKS = 600;
+
+    const DeadReckoningRun every = runDeadReckoning(DeadReckoning(), TICKS);
+    const DeadReckoningRun reckoned = runDeadReckoning(mode, TICKS);
+    INFO(reckoned.snapshots << " of " << every.snapshots << " snapshots, worst error " << reckoned.worstError);
+    CHECK(every.snapshots == TICKS);
+    CHECK(every.worstError == 0.0f);
+    CHECK(reckoned.worstError <= mode.threshold + 1e-3f);
+    CHECK(reckoned.snapshots * 8 < every.snapshots);
+    CHECK(reckoned.snapshots >= TICKS / 12 - 1);   // The 200 ms heartbeat
+    CHECK(every.sequenceGaps == 0);
+    CHECK(reckoned.sequenceGaps == 0);              // Nothing was lost: the client must not see loss
+
+    SECTION("A client that does not move only gets heartbeats") {
+        Room room(0, 1);
+        const auto t0 = Clock::now();
+        const sockaddr_in addr = makeAddr(0x7F000001, 4000);
+        room.join(makeClientId(addr), addr, t0);
+        room.setDeadReckoning(mode);
+        size_t snapshots = 0;
+        std::vector<RoomOutput> out;
+        for (uint32_t seq = 1; seq <= 60; ++seq) {
+            room.pushInput(makeClientId(addr), seq, 0.0f, 0.0f, t0 + seq * std::chrono::milliseconds(50));
+            out.clear();
+            room.tick(out);
+            snapshots += out.size();
+        }
+        CHECK(snapshots == 15);   // The first, then every 4th input (200 ms)
+        CHECK(room.deadReckonedSnapshots() == 45);
+    }
+}
+
+TEST_CASE("Room: held input keeps moving a client between packets", "[Room][server]") {
+    Room room(0, 2);
+    const auto t0 = Clock::now();
+    const sockaddr_in addr = makeAddr(0x7F000001, 4000);
+    const ClientId id = makeClientId(addr);
+    REQUIRE(room.join(id, addr, t0));
+    std::vector<RoomOutput> out;
+
+    room.pushInput(id, 1, 1.0f, 0.0f, t0 + std::chrono::milliseconds(10));
+    CHECK(room.holdInputs(t0 + std::chrono::milliseconds(10)) == 0);   // It sent input this tick
+    REQUIRE(room.tick(out) == 1);
+    CHECK(out[0].ack.heldMicros == 0);
+
+    // No more packets: every tick moves it 20 ms further and answers with the same sequence number
+    for (int k = 1; k <= 30; ++k) {
+        REQUIRE(room.holdInputs(t0 + std::chrono::milliseconds(10 + 20 * k)) == 1);
+        out.clear();
+        REQUIRE(room.tick(out) == 1);
+        REQUIRE(out.size() == 1);
+        REQUIRE(out[0].packet.seq == 1);
+        REQUIRE(out[0].packet.x == Catch::Approx(200.0f + 120.0f * (0.01f + 0.02f * k)));
+        REQUIRE(out[0].ack.heldMicros == static_cast<uint32_t>(20000 * k));
+    }
+    CHECK(room.heldInputs() == 30);
+
+    // Stopping 5 ms after the last held tick: the stop applies from there
+    room.pushInput(id, 2, 0.0f, 0.0f, t0 + std::chrono::milliseconds(615));
+    out.clear();
+    room.tick(out);
+    REQUIRE(out.size() == 1);
+    const float stopped = out[0].packet.x;
+    CHECK(out[0].ack.heldMicros == 0);
+    CHECK(stopped == Catch::Approx(200.0f + 120.0f * 0.61f));
+    for (int k = 1; k <= 10; ++k) {
+        CHECK(room.holdInputs(t0 + std::chrono::milliseconds(615 + 20 * k)) == 0);
+        out.clear();
+        CHECK(room.tick(out) == 0);
+        CHECK(out.empty());
+    }
+
+    // Moving again: the new input covers the 5 ms since the last held tick, not the whole pause
+    room.pushInput(id, 3, -1.0f, 0.0f, t0 + std::chrono::milliseconds(820));
+    out.clear();
+    room.tick(out);
+    REQUIRE(out.size() == 1);
+    CHECK(out[0].packet.x == Catch::Approx(stopped - 120.0f * 0.005f));
+    CHECK(out[0].ack.heldMicros == 0);
+}
+
+TEST_CASE("RoomRouter: clients fill rooms up to capacity", "[Room][server]") {
+    RoomRouter router(3, 2);
+    const auto t0 = Clock::now();
+
+    std::vector<Room*> placed;
+    for (uint16_t port = 1; port <= 6; ++port) {
+        sockaddr_in addr = makeAddr(0x0A000001, port);
+        placed.push_back(router.route(makeClientId(addr), addr, t0));
+        REQUIRE(placed.back() != nullptr);
+    }
+    REQUIRE(router.rooms().size() == 2);
+    REQUIRE(placed[0] == placed[2]);
+    REQUIRE(placed[3] == placed[5]);
+    REQUIRE(placed[0] != placed[3]);
+    REQUIRE(router.clientCount() == 6);
+
+    // Known clients keep their room
+    sockaddr_in first = makeAddr(0x0A000001, 1);
+    REQUIRE(router.route(makeClientId(first), first, t0) == placed[0]);
+
+    // All rooms full
+    sockaddr_in late = makeAddr(0x0A000002, 1);
+    REQUIRE(router.route(makeClientId(late), late, t0) == nullptr);
+    REQUIRE(router.find(makeClientId(late)) == nullptr);
+
+    // Evicted slots are reused
+    placed[1]->pushInput(makeClientId(makeAddr(0x0A000001, 1)), 1, 0, 0, t0 + std::chrono::seconds(2));
+    REQUIRE(router.evictIdle(t0 + std::chrono::seconds(1)) == 5);
+    REQUIRE(router.route(makeClientId(late), late, t0) == placed[0]);
+}
+
+TEST_CASE("RoomScheduler: every room runs exactly once per tick", "[Room][server]") {
+    RoomScheduler scheduler(4);
+    std::vector<std::unique_ptr<Room>> storage;
+    std::vector<Room*> rooms;
+    for (uint32_t id = 0; id < 64; ++id) {
+        storage.push_back(std::make_unique<Room>(id, 1));
+        rooms.push_back(storage.back().get());
+    }
+
+    // Assertions stay on the test thread; workers only record
+    std::vector<std::atomic<int>> runs(rooms.size());
+    std::atomic<bool> badWorker{ false };
+    for (int tick = 0; tick < 50; ++tick) {
+        scheduler.run(rooms, [&](Room& room, size_t worker) {
+            if (worker >= scheduler.workerCount()) badWorker = true;
+            runs[room.id()].fetch_add(1);
+        });
+    }
+    REQUIRE_FALSE(badWorker.load());
+    for (auto& count : runs) {
+        REQUIRE(count.load() == 50);
+    }
+
+    // Empty tick returns immediately
+    scheduler.run({}, [](Room&, size_t) {});
+}
+
+TEST_CASE("RoomScheduler: idle workers steal from a slow worker", "[Room][server]") {
+    RoomScheduler scheduler(4);
+    std::vector<std::unique_ptr<Room>> storage;
+    std::vector<Room*> rooms;
+    // Every room's home is worker 0
+    for (uint32_t i = 0; i < 16; ++i) {
+        storage.push_back(std::make_unique<Room>(i * 4, 1));
+        rooms.push_back(storage.back().get());
+    }
+
+    std::atomic<int> ranElsewhere{ 0 };
+    scheduler.run(rooms, [&](Room& room, size_t worker) {
+        if (worker != scheduler.homeWorker(room)) {
+            ranElsewhere++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+
+    REQUIRE(ranElsewhere.load() > 0);
+    REQUIRE(scheduler.steals() == static_cast<uint64_t>(ranElsewhere.load()));
+}
+
+TEST_CASE("Room: dead reckoning snapshot volume", "[.][Benchmark][Room]") {
+    constexpr int TICKS = 3600;
+    const DeadReckoningRun every = runDeadReckoning(DeadReckoning(), TICKS);
+    std::printf("every input:       %zu snapshots\n", every.snapshots);
+    for (const float threshold : { 0.5f, 1.0f, 2.0f, 5.0f }) {
+        DeadReckoning mode;
+        mode.enabled = true;
+        mode.threshold = threshold;
+        const DeadReckoningRun run = runDeadReckoning(mode, TICKS);
+        std::printf("threshold %.1f:     %zu snapshots (%.1fx fewer), worst client error %.2f\n", threshold,
+            run.snapshots, double(every.snapshots) / run.snapshots, run.worstError);
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file tick_scheduler_tests.cpp
+ * @brief Unit tests and benchmark for the fixed-rate tick scheduler.
+ *
+ * Coverage:
+ * - On-time ticks follow the absolute grid without drift
+ * - Skip runs the latest missed deadline at once and drops the rest, keeping the grid's phase
+ * - Compress runs missed ticks back to back, at most maxCompressed in a row
+ * - RunLate starts the next tick at once and moves the grid
+ * - Start jitter excludes late starts caused by overruns; overruns measure time past the interval
+ * - JitterStats histogram buckets
+ * - waitForTick() never returns early and stays close to the deadline
+ * - Benchmark: start jitter of a 1 kHz loop, sleep_until vs sleep-then-spin (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/tick_scheduler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = TickScheduler::Clock;
+    const Clock::time_point T0 = Clock::time_point(std::chrono::hours(1));
+
+    /** @brief Runs one tick that starts at the deadline plus lateness and lasts duration. */
+    Clock::time_point runTick(TickScheduler& clock, Clock::duration lateness, Clock::duration duration) {
+        const Clock::time_point start = clock.nextTick() + lateness;
+        clock.beginTick(start);
+        clock.endTick(start + duration);
+        return start;
+    }
+}
+
+TEST_CASE("TickScheduler: on-time ticks keep the grid", "[TickScheduler]") {
+    TickScheduler clock({ 10ms }, T0);
+    CHECK(clock.nextTick() == T0);
+    CHECK(clock.spinStart() == T0 - 200us);
+    CHECK_FALSE(clock.due(T0 - 1ns));
+    CHECK(clock.due(T0));
+
+    for (int i = 0; i < 100; ++i) {
+        runTick(clock, 30us, 2ms);   // Late starts do not shift later deadlines
+    }
+    CHECK(clock.nextTick() == T0 + 100 * 10ms);
+    CHECK(clock.ticks() == 100);
+    CHECK(clock.startJitter().count() == 100);
+    CHECK(clock.startJitter().max() == 30us);
+    CHECK(clock.overruns().count() == 0);
+    CHECK(clock.skipped() == 0);
+}
+
+TEST_CASE("TickScheduler: catch-up policies", "[TickScheduler]") {
+    SECTION("Skip: the latest missed deadline runs at once, earlier ones are dropped") {
+        TickScheduler clock({ 10ms, TickScheduler::CatchUp::Skip }, T0);
+        runTick(clock, 0ms, 35ms);   // Ends at T0 + 35: deadlines 10, 20 and 30 have passed
+        CHECK(clock.nextTick() == T0 + 30ms);
+        CHECK(clock.skipped() == 2);
+        CHECK(clock.overruns().count() == 1);
+        CHECK(clock.overruns().max() == 25ms);
+
+        runTick(clock, 5ms, 1ms);    // Starts at once (late by design, not jitter)
+        CHECK(clock.startJitter().count() == 1);
+        CHECK(clock.nextTick() == T0 + 40ms);
+    }
+
+    SECTION("Compress: missed ticks run back to back") {
+        TickScheduler clock({ 10ms, TickScheduler::CatchUp::Compress }, T0);
+        runTick(clock, 0ms, 25ms);   // Ends at T0 + 25: deadlines 10 and 20 have passed
+        CHECK(clock.nextTick() == T0 + 10ms);
+        clock.beginTick(T0 + 25ms);
+        clock.endTick(T0 + 26ms);
+        CHECK(clock.nextTick() == T0 + 20ms);
+        clock.beginTick(T0 + 26ms);
+        clock.endTick(T0 + 27ms);
+        CHECK(clock.nextTick() == T0 + 30ms);   // Caught up
+        CHECK(clock.compressed() == 2);
+        CHECK(clock.skipped() == 0);
+        CHECK(clock.ticks() == 3);
+        CHECK(clock.startJitter().count() == 1);
+        CHECK(clock.overruns().count() == 1);   // Catch-up ticks were short
+    }
+
+    SECTION("Compress: at most maxCompressed in a row, then skip") {
+        TickScheduler clock({ 10ms, TickScheduler::CatchUp::Compress, 200us, 2 }, T0);
+        Clock::time_point now = T0;
+        clock.beginTick(now);
+        now += 100ms;   // A long stall
+        clock.endTick(now);
+        for (int i = 0; i < 2; ++i) {
+            CHECK(clock.due(now));
+            clock.beginTick(now);
+            clock.endTick(now);
+        }
+        CHECK(clock.compressed() == 2);
+        CHECK(clock.nextTick() == T0 + 100ms);   // Third overrun in a row: the rest is dropped
+        CHECK(clock.skipped() == 7);
+    }
+
+    SECTION("RunLate: the grid moves to the late tick") {
+        TickScheduler clock({ 10ms, TickScheduler::CatchUp::RunLate }, T0);
+        runTick(clock, 0ms, 25ms);
+        CHECK(clock.nextTick() == T0 + 25ms);
+        clock.beginTick(T0 + 25ms);
+        clock.endTick(T0 + 26ms);
+        CHECK(clock.nextTick() == T0 + 35ms);
+        CHECK(clock.skipped() == 0);
+        CHECK(clock.compressed() == 0);
+    }
+}
+
+TEST_CASE("TickScheduler: histograms and report", "[TickScheduler]") {
+    JitterStats stats;
+    for (std::chrono::nanoseconds sample : { 5us, 9us, 10us, 60us, 2000us, 9000us }) {
+        stats.record(sample);
+    }
+    const std::vector<size_t> counts = stats.histogram({ 10us, 50us, 100us, 1ms });
+    CHECK(counts == std::vector<size_t>{ 2, 1, 1, 0, 2 });
+
+    TickScheduler clock({ 10ms }, T0);
+    runTick(clock, 20us, 1ms);
+    runTick(clock, 0us, 12ms);
+    const std::string report = clock.report();
+    INFO(report);
+    CHECK(report.find("<50us:1") != std::string::npos);
+    CHECK(report.find("overruns") != std::string::npos);
+    CHECK(report.find("<5ms:1") != std::string::npos);   // The 2 ms overrun
+
+    clock.resetStats();
+    CHECK(clock.ticks() == 0);
+    CHECK(clock.startJitter().count() == 0);
+    CHECK(clock.overruns().count() == 0);
+}
+
+TEST_CASE("TickScheduler: waitForTick is never early", "[TickScheduler]") {
+    TickScheduler clock({ 2ms });
+    for (int i = 0; i < 50; ++i) {
+        clock.waitForTick();
+        const auto now = Clock::now();
+        REQUIRE(clock.due(now));
+        clock.beginTick(now);
+        clock.endTick(Clock::now());
+    }
+    INFO(clock.report());
+    CHECK(clock.startJitter().percentile(0.5) < 1ms);
+}
+
+TEST_CASE("TickScheduler: 1 kHz start jitter, sleep only vs sleep then spin", "[.][Benchmark][TickScheduler]") {
+    constexpr int TICKS = 3000;
+    for (const auto spin : { Clock::duration(0), Clock::duration(200us) }) {
+        TickScheduler clock({ 1ms, TickScheduler::CatchUp::Skip, spin });
+        for (int i = 0; i < TICKS; ++i) {
+            if (spin == Clock::duration(0)) {
+                std::this_thread::sleep_until(clock.nextTick());
+            }
+            else {
+                clock.waitForTick();
+            }
+            clock.beginTick(Clock::now());
+            clock.endTick(Clock::now());
+        }
+        std::printf("%s: %s\n", spin == Clock::duration(0) ? "sleep_until" : "sleep + 200 us spin",
+            clock.report().c_str());
+    }
+}
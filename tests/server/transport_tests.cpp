@@ -0,0 +1,503 @@
+/**
+ * @file transport_tests.cpp
+ * @brief Unit tests and benchmarks for the batched datagram transports.
+ *
+ * Coverage (each available backend):
+ * - Datagrams and their source addresses arrive intact; replies reach the sender
+ * - Datagrams larger than MAX_DATAGRAM are flagged as truncated
+ * - receive() returns after the timeout when nothing arrives
+ * - More sends than one batch (or one set of send slots) all arrive
+ * - More datagrams than the io_uring buffer ring holds are all received
+ * - makeTransport() falls back to SocketTransport
+ * - A send-only transport sends but takes nothing off the socket and leaves GRO alone
+ * - Same-destination datagrams leave as one GSO send and arrive as separate datagrams
+ * - GRO-coalesced buffers are split back into the original datagrams
+ * - Datagrams carry their kernel receive time; receive-buffer overflows are counted as kernel drops
+ * - Benchmark: 256-datagram echo bursts on loopback, recvfrom/sendto loop vs each backend (hidden, "[Benchmark]")
+ * - Benchmark: kernel CPU per datagram for 64-datagram bursts with and without GSO/GRO (hidden, "[Benchmark]")
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#include <catch2/catch_all.hpp>
+#include "netcode/common/io_uring_transport.hpp"
+#include "netcode/common/transport.hpp"
+#include "test_support.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <netinet/udp.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Creates the backend, or null if it is not available here. */
+    std::unique_ptr<DatagramTransport> makeBackend(int sock, TransportKind kind) {
+        if (kind == TransportKind::IoUring) {
+#ifdef __linux__
+            return IoUringTransport::create(sock);
+#else
+            return nullptr;
+#endif
+        }
+        return std::make_unique<SocketTransport>(sock);
+    }
+
+    /** @brief Receives until count datagrams have arrived or a second has passed. */
+    std::vector<std::string> receiveAll(DatagramTransport& transport, size_t count, std::vector<sockaddr_in>* from = nullptr) {
+        std::vector<std::string> payloads;
+        std::vector<ReceivedDatagram> batch;
+        const auto deadline = Clock::now() + std::chrono::seconds(1);
+        while (payloads.size() < count && Clock::now() < deadline) {
+            transport.receive(batch, std::chrono::milliseconds(50));
+            for (const ReceivedDatagram& d : batch) {
+                payloads.emplace_back(d.data, d.size);
+                if (from) from->push_back(d.addr);
+            }
+        }
+        return payloads;
+    }
+}
+
+TEST_CASE("Transport: datagrams and addresses round trip", "[Transport][server]") {
+    const TransportKind kind = GENERATE(TransportKind::Socket, TransportKind::IoUring);
+    LoopbackSocket server;
+    LoopbackSocket client;
+    auto transport = makeBackend(server.fd, kind);
+    if (!transport) {
+        WARN("io_uring transport unavailable; skipped");
+        return;
+    }
+    INFO(transport->name());
+
+    for (int i = 0; i < 10; ++i) {
+        const std::string payload = "input-" + std::to_string(i);
+        client.sendTo(server.addr, payload.data(), payload.size());
+    }
+    std::vector<sockaddr_in> from;
+    const std::vector<std::string> received = receiveAll(*transport, 10, &from);
+    REQUIRE(received.size() == 10);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(received[i] == "input-" + std::to_string(i));
+        REQUIRE(from[i].sin_port == client.addr.sin_port);
+        REQUIRE(from[i].sin_addr.s_addr == client.addr.sin_addr.s_addr);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        const std::string reply = "snapshot-" + std::to_string(i);
+        REQUIRE(transport->send(from[i], reply.data(), reply.size()));
+    }
+    REQUIRE(transport->flush() == 10);
+    for (int i = 0; i < 10; ++i) {
+        char buffer[64];
+        const int size = client.receive(buffer, sizeof(buffer));
+        REQUIRE(std::string(buffer, size > 0 ? size : 0) == "snapshot-" + std::to_string(i));
+    }
+
+    // Send completions may be reaped later; give them a receive() to land
+    std::vector<ReceivedDatagram> batch;
+    transport->receive(batch, std::chrono::milliseconds(1));
+    REQUIRE(transport->stats().received == 10);
+    REQUIRE(transport->stats().sent == 10);
+    REQUIRE(transport->stats().sendErrors == 0);
+}
+
+TEST_CASE("Transport: oversized datagrams are flagged", "[Transport][server][EdgeCase]") {
+    const TransportKind kind = GENERATE(TransportKind::Socket, TransportKind::IoUring);
+    LoopbackSocket server;
+    LoopbackSocket client;
+    auto transport = makeBackend(server.fd, kind);
+    if (!transport) {
+        WARN("io_uring transport unavailable; skipped");
+        return;
+    }
+    INFO(transport->name());
+
+    const std::string big(DatagramTransport::MAX_DATAGRAM + 100, 'x');
+    client.sendTo(server.addr, big.data(), big.size());
+    client.sendTo(server.addr, "ok", 2);
+
+    std::vector<ReceivedDatagram> batch;
+    std::vector<std::pair<size_t, bool>> seen;
+    const auto deadline = Clock::now() + std::chrono::seconds(1);
+    while (seen.size() < 2 && Clock::now() < deadline) {
+        transport->receive(batch, std::chrono::milliseconds(50));
+        for (const ReceivedDatagram& d : batch) {
+            seen.emplace_back(d.size, d.truncated);
+        }
+    }
+    REQUIRE(seen.size() == 2);
+    REQUIRE(seen[0].second);
+    REQUIRE(seen[0].first <= DatagramTransport::MAX_DATAGRAM);
+    REQUIRE_FALSE(seen[1].second);
+    REQUIRE(seen[1].first == 2);
+
+    REQUIRE_FALSE(transport->send(client.addr, big.data(), big.size()));
+}
+
+TEST_CASE("Transport: receive returns after the timeout", "[Transport][server][EdgeCase]") {
+    const TransportKind kind = GENERATE(TransportKind::Socket, TransportKind::IoUring);
+    LoopbackSocket server;
+    auto transport = makeBackend(server.fd, kind);
+    if (!transport) {
+        WARN("io_uring transport unavailable; skipped");
+        return;
+    }
+    INFO(transport->name());
+
+    std::vector<ReceivedDatagram> batch;
+    const auto start = Clock::now();
+    REQUIRE(transport->receive(batch, std::chrono::milliseconds(20)) == 0);
+    const auto elapsed = Clock::now() - start;
+    REQUIRE(elapsed >= std::chrono::milliseconds(15));
+    REQUIRE(elapsed < std::chrono::milliseconds(500));
+    REQUIRE(batch.empty());
+
+    REQUIRE(transport->receive(batch, std::chrono::microseconds(0)) == 0);
+}
+
+TEST_CASE("Transport: large bursts are sent and received whole", "[Transport][server]") {
+    const TransportKind kind = GENERATE(TransportKind::Socket, TransportKind::IoUring);
+    LoopbackSocket server;
+    LoopbackSocket client;
+    auto transport = makeBackend(server.fd, kind);
+    if (!transport) {
+        WARN("io_uring transport unavailable; skipped");
+        return;
+    }
+    INFO(transport->name());
+
+    // More than a sendmmsg batch and more than the io_uring send slots
+    const size_t sends = 1500;
+    for (size_t i = 0; i < sends; ++i) {
+        const uint32_t value = static_cast<uint32_t>(i);
+        REQUIRE(transport->send(client.addr, reinterpret_cast<const char*>(&value), sizeof(value)));
+    }
+    transport->flush();
+    size_t arrived = 0;
+    bool inOrder = true;
+    for (size_t i = 0; i < sends; ++i) {
+        uint32_t value = 0;
+        if (client.receive(reinterpret_cast<char*>(&value), sizeof(value)) != sizeof(value)) break;
+        inOrder = inOrder && value == i;
+        ++arrived;
+    }
+    REQUIRE(arrived == sends);
+    REQUIRE(inOrder);
+
+    // Hold the first batch while more arrive than the io_uring buffer ring has left
+    for (uint32_t i = 0; i < 400; ++i) {
+        client.sendTo(server.addr, &i, sizeof(i));
+    }
+    const std::vector<std::string> first = receiveAll(*transport, 400);
+    REQUIRE(first.size() == 400);
+    for (uint32_t i = 400; i < 600; ++i) {
+        client.sendTo(server.addr, &i, sizeof(i));
+    }
+    const std::vector<std::string> second = receiveAll(*transport, 200);
+    REQUIRE(second.size() == 200);
+    for (uint32_t i = 0; i < 200; ++i) {
+        uint32_t value = 0;
+        std::memcpy(&value, second[i].data(), sizeof(value));
+        REQUIRE(value == 400 + i);
+    }
+}
+
+TEST_CASE("Transport: falls back to the socket backend", "[Transport][server][EdgeCase]") {
+    LoopbackSocket server;
+    auto socketTransport = makeTransport(server.fd, TransportKind::Socket);
+    REQUIRE(socketTransport);
+    REQUIRE(std::string(socketTransport->name()) == SocketTransport(server.fd).name());
+
+    // An unusable socket makes io_uring setup fail
+#ifdef __linux__
+    REQUIRE(IoUringTransport::create(-1) == nullptr);
+#endif
+    auto fallback = makeTransport(-1, TransportKind::IoUring);
+    REQUIRE(fallback);
+    REQUIRE(std::string(fallback->name()) == SocketTransport(-1).name());
+
+    auto preferred = makeTransport(server.fd, TransportKind::IoUring);
+    REQUIRE(preferred);
+}
+
+TEST_CASE("Transport: a send-only transport leaves datagrams to the receiver", "[Transport][server]") {
+    const TransportKind kind = GENERATE(TransportKind::Socket, TransportKind::IoUring);
+    LoopbackSocket server;
+    LoopbackSocket client;
+    auto sender = makeTransport(server.fd, kind, false);
+    REQUIRE(sender);
+    INFO(sender->name());
+#ifdef __linux__
+    int gro = -1;
+    socklen_t length = sizeof(gro);
+    REQUIRE(getsockopt(server.fd, SOL_UDP, UDP_GRO, &gro, &length) == 0);
+    CHECK(gro == 0);
+#endif
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        client.sendTo(server.addr, &i, sizeof(i));
+    }
+    std::vector<ReceivedDatagram> batch;
+    CHECK(sender->receive(batch, std::chrono::milliseconds(20)) == 0);
+    REQUIRE(sender->send(client.addr, "reply", 5));
+    CHECK(sender->flush() == 1);
+    char reply[16];
+    CHECK(client.receive(reply, sizeof(reply)) == 5);
+
+    auto receiver = makeTransport(server.fd, kind);
+    CHECK(receiveAll(*receiver, 10).size() == 10);
+    CHECK(sender->stats().received == 0);
+}
+
+TEST_CASE("Transport: same-destination datagrams leave as one GSO send", "[Transport][server]") {
+    LoopbackSocket server;
+    LoopbackSocket client;
+    LoopbackSocket other;
+    SocketTransport transport(server.fd);
+
+    // Ten full segments and a shorter tail to client, then two to another destination
+    std::vector<std::string> expected;
+    for (int i = 0; i < 10; ++i) {
+        expected.push_back("snapshot-" + std::to_string(i) + std::string(10, 'x'));
+    }
+    expected.push_back("tail");
+    for (const std::string& payload : expected) {
+        REQUIRE(transport.send(client.addr, payload.data(), payload.size()));
+    }
+    REQUIRE(transport.send(other.addr, "first", 5));
+    REQUIRE(transport.send(other.addr, "second", 6));
+    REQUIRE(transport.flush() == 13);
+    if (!transport.gsoEnabled()) {
+        WARN("UDP GSO unavailable; datagrams were sent separately");
+    }
+    else {
+        REQUIRE(transport.stats().syscalls == 1);
+        REQUIRE(transport.stats().gsoSegments == 11);
+    }
+    REQUIRE(transport.stats().sent == 13);
+
+    // A receiver without GRO gets the original datagrams
+    for (const std::string& payload : expected) {
+        char buffer[64];
+        const int size = client.receive(buffer, sizeof(buffer));
+        REQUIRE(std::string(buffer, size > 0 ? size : 0) == payload);
+    }
+    char buffer[64];
+    int size = other.receive(buffer, sizeof(buffer));
+    REQUIRE(std::string(buffer, size > 0 ? size : 0) == "first");
+    size = other.receive(buffer, sizeof(buffer));
+    REQUIRE(std::string(buffer, size > 0 ? size : 0) == "second");
+}
+
+TEST_CASE("Transport: GRO buffers are split into datagrams", "[Transport][server]") {
+    LoopbackSocket senderSocket;
+    LoopbackSocket receiverSocket;
+    SocketTransport sender(senderSocket.fd);
+    SocketTransport receiver(receiverSocket.fd);
+    if (!receiver.groEnabled()) {
+        WARN("UDP GRO unavailable; skipped");
+        return;
+    }
+
+    for (uint32_t i = 0; i < 40; ++i) {
+        const uint32_t words[6] = { i, i * 3, i * 7, 0, 0, 0xC0FFEE };
+        REQUIRE(sender.send(receiverSocket.addr, reinterpret_cast<const char*>(words), sizeof(words)));
+    }
+    REQUIRE(sender.send(receiverSocket.addr, "end", 3));
+    sender.flush();
+
+    std::vector<sockaddr_in> from;
+    const std::vector<std::string> received = receiveAll(receiver, 41, &from);
+    REQUIRE(received.size() == 41);
+    for (uint32_t i = 0; i < 40; ++i) {
+        uint32_t words[6];
+        REQUIRE(received[i].size() == sizeof(words));
+        std::memcpy(words, received[i].data(), sizeof(words));
+        REQUIRE(words[0] == i);
+        REQUIRE(words[2] == i * 7);
+        REQUIRE(words[5] == 0xC0FFEE);
+        REQUIRE(from[i].sin_port == senderSocket.addr.sin_port);
+    }
+    REQUIRE(received[40] == "end");
+    if (sender.gsoEnabled()) {
+        REQUIRE(receiver.stats().groSegments == 41);  // Sent as one GSO buffer, delivered as one
+    }
+
+    // Offload off: GRO is switched off on the socket again
+    SocketTransport plain(receiverSocket.fd, false);
+    REQUIRE_FALSE(plain.groEnabled());
+    REQUIRE_FALSE(plain.gsoEnabled());
+}
+
+#ifdef __linux__
+TEST_CASE("Transport: kernel receive timestamps and drop counts", "[Transport][server]") {
+    const TransportKind kind = GENERATE(TransportKind::Socket, TransportKind::IoUring);
+    LoopbackSocket server;
+    LoopbackSocket client;
+    auto transport = makeBackend(server.fd, kind);
+    if (!transport) {
+        WARN("io_uring transport unavailable; skipped");
+        return;
+    }
+    INFO(transport->name());
+    auto wallNow = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    };
+
+    // Timestamps lie between the send and the receive
+    const int64_t sentAt = wallNow();
+    client.sendTo(server.addr, "input", 5);
+    std::vector<ReceivedDatagram> batch;
+    REQUIRE(transport->receive(batch, std::chrono::seconds(1)) == 1);
+    const int64_t receivedAt = wallNow();
+    CHECK(batch[0].kernelTime >= sentAt);
+    CHECK(batch[0].kernelTime <= receivedAt);
+    CHECK(transport->stats().kernelDrops == 0);
+
+    // Overflow a small receive buffer (and the io_uring buffers) while nothing reaps them
+    constexpr size_t BURST = 2000;
+    const int small = 4096;
+    setsockopt(server.fd, SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+    char payload[200] = {};
+    for (size_t i = 0; i < BURST; ++i) {
+        client.sendTo(server.addr, payload, sizeof(payload));
+    }
+    const size_t queued = receiveAll(*transport, BURST).size();
+    REQUIRE(queued < BURST);
+
+    // The next datagram to get through reports the drops
+    client.sendTo(server.addr, "input", 5);
+    REQUIRE(receiveAll(*transport, 1).size() == 1);
+    CHECK(transport->stats().kernelDrops == BURST - queued);
+}
+#endif
+
+TEST_CASE("Transport: 256-datagram echo bursts on loopback", "[.][Benchmark][Transport]") {
+    constexpr size_t BURST = 256;
+    LoopbackSocket server;
+    LoopbackSocket client;
+    char payload[24] = {};  // Input-packet sized
+    char buffer[DatagramTransport::MAX_DATAGRAM];
+
+    auto clientBurst = [&] {
+        for (size_t i = 0; i < BURST; ++i) {
+            client.sendTo(server.addr, payload, sizeof(payload));
+        }
+    };
+    auto clientDrain = [&] {
+        size_t echoed = 0;
+        while (echoed < BURST && client.receive(buffer, sizeof(buffer)) > 0) ++echoed;
+        return echoed;
+    };
+
+    size_t baselineSyscalls = 0;
+    size_t baselinePackets = 0;
+    BENCHMARK("recvfrom/sendto loop (baseline)") {
+        clientBurst();
+        size_t handled = 0;
+        while (handled < BURST) {
+            fd_set readSet;
+            FD_ZERO(&readSet);
+            FD_SET(server.fd, &readSet);
+            timeval tv{ 1, 0 };
+            ++baselineSyscalls;
+            if (select(server.fd + 1, &readSet, nullptr, nullptr, &tv) <= 0) break;
+            sockaddr_in from{};
+            socklen_t len = sizeof(from);
+            ++baselineSyscalls;
+            const ssize_t size = recvfrom(server.fd, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr*>(&from), &len);
+            ++baselineSyscalls;
+            sendto(server.fd, buffer, static_cast<size_t>(size), 0, reinterpret_cast<sockaddr*>(&from), sizeof(from));
+            ++handled;
+        }
+        baselinePackets += handled;
+        return clientDrain();
+    };
+    std::printf("recvfrom/sendto loop: %.2f syscalls per datagram\n",
+        baselinePackets ? double(baselineSyscalls) / baselinePackets : 0.0);
+
+    for (const TransportKind kind : { TransportKind::Socket, TransportKind::IoUring }) {
+        auto transport = makeBackend(server.fd, kind);
+        if (!transport) {
+            WARN("io_uring transport unavailable; skipped");
+            continue;
+        }
+        std::vector<ReceivedDatagram> batch;
+        BENCHMARK(kind == TransportKind::Socket ? "SocketTransport" : "IoUringTransport") {
+            clientBurst();
+            size_t handled = 0;
+            while (handled < BURST) {
+                if (transport->receive(batch, std::chrono::seconds(1)) == 0 && handled == 0) break;
+                for (const ReceivedDatagram& d : batch) {
+                    transport->send(d.addr, d.data, d.size);
+                }
+                transport->flush();
+                handled += batch.size();
+            }
+            return clientDrain();
+        };
+        const TransportStats& stats = transport->stats();
+        std::printf("%s transport: %.2f syscalls per datagram\n", transport->name(),
+            stats.received ? double(stats.syscalls) / stats.received : 0.0);
+    }
+}
+TEST_CASE("Transport: kernel CPU per datagram with GSO/GRO", "[.][Benchmark][Transport]") {
+    constexpr size_t BURST = 64;      // One tick's snapshots to one destination
+    constexpr size_t ROUNDS = 5000;
+    char payload[28] = {};            // Snapshot sized
+
+    for (const bool offload : { false, true }) {
+        LoopbackSocket senderSocket;
+        LoopbackSocket receiverSocket;
+        SocketTransport sender(senderSocket.fd, offload);
+        SocketTransport receiver(receiverSocket.fd, offload);
+        std::vector<ReceivedDatagram> batch;
+
+        auto round = [&] {
+            for (size_t i = 0; i < BURST; ++i) {
+                sender.send(receiverSocket.addr, payload, sizeof(payload));
+            }
+            sender.flush();
+            size_t received = 0;
+            while (received < BURST && receiver.receive(batch, std::chrono::seconds(1)) > 0) {
+                received += batch.size();
+            }
+            return received;
+        };
+
+        rusage before{};
+        rusage after{};
+        getrusage(RUSAGE_THREAD, &before);
+        const auto start = Clock::now();
+        size_t delivered = 0;
+        for (size_t r = 0; r < ROUNDS; ++r) {
+            delivered += round();
+        }
+        const auto wall = Clock::now() - start;
+        getrusage(RUSAGE_THREAD, &after);
+        const double systemUs = (after.ru_stime.tv_sec - before.ru_stime.tv_sec) * 1e6
+            + (after.ru_stime.tv_usec - before.ru_stime.tv_usec);
+        std::printf("%s: %zu datagrams, %.3f us kernel CPU and %.3f us wall per datagram, "
+            "%.3f syscalls per datagram (send + receive)\n",
+            offload ? "GSO/GRO" : "no offload", delivered, systemUs / delivered,
+            std::chrono::duration<double, std::micro>(wall).count() / delivered,
+            double(sender.stats().syscalls + receiver.stats().syscalls) / delivered);
+
+        BENCHMARK(offload ? "64-datagram burst, GSO/GRO" : "64-datagram burst, no offload") {
+            return round();
+        };
+    }
+}
+#endif
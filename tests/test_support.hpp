@@ -0,0 +1,71 @@
+/**
+ * @file test_support.hpp
+ * @brief Fixtures shared by several test files.
+ *
+ * Usage:
+ *   - makeAddr(ip, port): an IPv4 sockaddr_in from host-order values, for client ids and rooms
+ *   - LoopbackSocket: a bound 127.0.0.1 UDP socket for tests that exchange real datagrams (not on Windows)
+ *
+ * @author Aryan Malekian & Jonathan Skomsøy Hübertz,  w/ use of A.I. Models
+ * @date 17.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#endif
+
+/** @brief IPv4 address from host byte order ip and port. */
+inline sockaddr_in makeAddr(uint32_t ip, uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(ip);
+    addr.sin_port = htons(port);
+    return addr;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Bound loopback UDP socket with a large receive buffer; closed on destruction.
+ */
+struct LoopbackSocket {
+    int fd = -1;
+    sockaddr_in addr{};
+
+    LoopbackSocket() {
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        const int bufferSize = 1 << 20;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    }
+    ~LoopbackSocket() { close(fd); }
+
+    LoopbackSocket(const LoopbackSocket&) = delete;
+    LoopbackSocket& operator=(const LoopbackSocket&) = delete;
+
+    void sendTo(const sockaddr_in& to, const void* data, size_t size) const {
+        sendto(fd, data, size, 0, reinterpret_cast<const sockaddr*>(&to), sizeof(to));
+    }
+
+    /** @brief Receives one datagram, waiting up to 1 s; returns its size or -1. */
+    int receive(char* buffer, size_t size) const {
+        timeval tv{ 1, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        return static_cast<int>(recv(fd, buffer, size, 0));
+    }
+};
+#endif